@@ -12,6 +12,7 @@
 #include "status_reg.h"
 #include "telemetry.h"
 #include "timer.h"
+#include "vf_curve.h"
 
 #include <stdint.h>
 
@@ -40,6 +41,11 @@ int main(void)
 	printk("Tenstorrent Blackhole CMFW %s\n", APP_VERSION_STRING);
 
 	if (!IS_ENABLED(CONFIG_TT_SMC_RECOVERY)) {
+		/* The VF curve handlers answer the host even with DVFS disabled, so build the
+		 * curve tables before the message queues start.
+		 */
+		InitVFCurve();
+
 		if (tt_bh_fwtable_get_fw_table(fwtable_dev)->feature_enable.aiclk_ppm_en) {
 			STATUS_ERROR_STATUS0_reg_u error_status0 = {
 				.val = ReadReg(STATUS_ERROR_STATUS0_REG_ADDR)
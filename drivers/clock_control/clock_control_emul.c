@@ -10,6 +10,7 @@
  */
 
 #define DT_DRV_COMPAT tenstorrent_clock_control_emul
+#include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/clock_control.h>
 #include <zephyr/sys/util.h>
@@ -17,13 +18,27 @@
 
 LOG_MODULE_REGISTER(clock_control_emul, CONFIG_CLOCK_CONTROL_LOG_LEVEL);
 
+#define CLOCK_CONTROL_EMUL_NUM_CLOCKS 16 /* Support up to 16 different clocks */
+
 struct clock_control_emul_data {
-	uint32_t clock_rates[16]; /* Support up to 16 different clocks */
-	bool clock_enabled[16];   /* Track enabled state for each clock */
+	uint32_t clock_rates[CLOCK_CONTROL_EMUL_NUM_CLOCKS];
+	bool clock_enabled[CLOCK_CONTROL_EMUL_NUM_CLOCKS]; /* Track enabled state for each clock */
+
+	/* Rates being slewed to, and the callbacks waiting for them */
+	uint32_t target_rates[CLOCK_CONTROL_EMUL_NUM_CLOCKS];
+	clock_control_cb_t slew_cb[CLOCK_CONTROL_EMUL_NUM_CLOCKS];
+	void *slew_cb_user_data[CLOCK_CONTROL_EMUL_NUM_CLOCKS];
+	const struct device *dev;
+	struct k_timer slew_timer;
+	struct k_spinlock lock;
 };
 
 struct clock_control_emul_config {
 	uint32_t default_rate;
+	/* Slews like the Blackhole AICLK PLL when slew_step is non-zero */
+	uint32_t slew_step;
+	uint32_t slew_step_ns;
+	uint32_t slew_steps_per_tick;
 };
 
 static int clock_control_emul_on(const struct device *dev, clock_control_subsys_t sys)
@@ -78,10 +93,61 @@ static int clock_control_emul_get_rate(const struct device *dev, clock_control_s
 	return 0;
 }
 
+static void clock_control_emul_slew_step(struct k_timer *timer)
+{
+	struct clock_control_emul_data *data =
+		CONTAINER_OF(timer, struct clock_control_emul_data, slew_timer);
+	const struct clock_control_emul_config *config = data->dev->config;
+	clock_control_cb_t cb[CLOCK_CONTROL_EMUL_NUM_CLOCKS] = {0};
+	void *user_data[CLOCK_CONTROL_EMUL_NUM_CLOCKS];
+	uint32_t steps = 0;
+	bool slewing = false;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	for (int i = 0; i < ARRAY_SIZE(data->clock_rates); i++) {
+		while (data->clock_rates[i] != data->target_rates[i] &&
+		       steps < config->slew_steps_per_tick) {
+			uint32_t rate = data->clock_rates[i];
+			uint32_t target = data->target_rates[i];
+
+			if (target > rate) {
+				data->clock_rates[i] = MIN(rate + config->slew_step, target);
+			} else {
+				rate -= MIN(config->slew_step, rate);
+				data->clock_rates[i] = MAX(rate, target);
+			}
+
+			k_busy_wait_ns(config->slew_step_ns);
+			steps++;
+		}
+
+		if (data->clock_rates[i] != data->target_rates[i]) {
+			slewing = true;
+		} else if (data->slew_cb[i] != NULL) {
+			cb[i] = data->slew_cb[i];
+			user_data[i] = data->slew_cb_user_data[i];
+			data->slew_cb[i] = NULL;
+		}
+	}
+
+	if (!slewing) {
+		k_timer_stop(timer);
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	for (uintptr_t i = 0; i < ARRAY_SIZE(cb); i++) {
+		if (cb[i] != NULL) {
+			cb[i](data->dev, (clock_control_subsys_t)i, user_data[i]);
+		}
+	}
+}
+
 static int clock_control_emul_set_rate(const struct device *dev, clock_control_subsys_t sys,
 				       clock_control_subsys_rate_t rate)
 {
 	struct clock_control_emul_data *data = dev->data;
+	const struct clock_control_emul_config *config = dev->config;
 	uintptr_t subsys_id = (uintptr_t)sys;
 	uint32_t new_rate = (uint32_t)(uintptr_t)rate;
 
@@ -90,11 +156,60 @@ static int clock_control_emul_set_rate(const struct device *dev, clock_control_s
 		return -EINVAL;
 	}
 
-	data->clock_rates[subsys_id] = new_rate;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	data->target_rates[subsys_id] = new_rate;
+	if (config->slew_step == 0) {
+		data->clock_rates[subsys_id] = new_rate;
+	} else if (data->clock_rates[subsys_id] != new_rate &&
+		   k_timer_remaining_ticks(&data->slew_timer) == 0) {
+		k_timer_start(&data->slew_timer, K_NO_WAIT, K_TICKS(1));
+	}
+
+	k_spin_unlock(&data->lock, key);
+
 	LOG_DBG("Set rate for subsys %lu: %u Hz", subsys_id, new_rate);
 	return 0;
 }
 
+static int clock_control_emul_async_on(const struct device *dev, clock_control_subsys_t sys,
+				       clock_control_cb_t cb, void *user_data)
+{
+	struct clock_control_emul_data *data = dev->data;
+	uintptr_t subsys_id = (uintptr_t)sys;
+
+	if (subsys_id >= ARRAY_SIZE(data->clock_rates)) {
+		LOG_ERR("Invalid subsys ID %lu", subsys_id);
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	data->clock_enabled[subsys_id] = true;
+
+	if (data->clock_rates[subsys_id] != data->target_rates[subsys_id]) {
+		int ret = 0;
+
+		if (data->slew_cb[subsys_id] != NULL) {
+			ret = -EBUSY;
+		} else {
+			data->slew_cb[subsys_id] = cb;
+			data->slew_cb_user_data[subsys_id] = user_data;
+		}
+
+		k_spin_unlock(&data->lock, key);
+		return ret;
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	if (cb != NULL) {
+		cb(dev, sys, user_data);
+	}
+
+	return 0;
+}
+
 static enum clock_control_status clock_control_emul_get_status(const struct device *dev,
 							       clock_control_subsys_t sys)
 {
@@ -106,12 +221,19 @@ static enum clock_control_status clock_control_emul_get_status(const struct devi
 		return CLOCK_CONTROL_STATUS_UNKNOWN;
 	}
 
-	return data->clock_enabled[subsys_id] ? CLOCK_CONTROL_STATUS_ON : CLOCK_CONTROL_STATUS_OFF;
+	if (!data->clock_enabled[subsys_id]) {
+		return CLOCK_CONTROL_STATUS_OFF;
+	}
+
+	return data->clock_rates[subsys_id] != data->target_rates[subsys_id]
+		       ? CLOCK_CONTROL_STATUS_STARTING
+		       : CLOCK_CONTROL_STATUS_ON;
 }
 
 static const struct clock_control_driver_api clock_control_emul_api = {
 	.on = clock_control_emul_on,
 	.off = clock_control_emul_off,
+	.async_on = clock_control_emul_async_on,
 	.get_rate = clock_control_emul_get_rate,
 	.set_rate = clock_control_emul_set_rate,
 	.get_status = clock_control_emul_get_status,
@@ -125,9 +247,13 @@ static int clock_control_emul_init(const struct device *dev)
 	/* Initialize all clock rates to default and enabled */
 	for (int i = 0; i < ARRAY_SIZE(data->clock_rates); i++) {
 		data->clock_rates[i] = config->default_rate;
+		data->target_rates[i] = config->default_rate;
 		data->clock_enabled[i] = true;
 	}
 
+	data->dev = dev;
+	k_timer_init(&data->slew_timer, clock_control_emul_slew_step, NULL);
+
 	LOG_DBG("Clock control emulator initialized with default rate %u Hz", config->default_rate);
 	return 0;
 }
@@ -137,6 +263,9 @@ static int clock_control_emul_init(const struct device *dev)
                                                                                                    \
 	static const struct clock_control_emul_config clock_control_emul_config_##inst = {         \
 		.default_rate = DT_INST_PROP_OR(inst, default_rate, 1000000000),                   \
+		.slew_step = DT_INST_PROP(inst, slew_step),                                        \
+		.slew_step_ns = DT_INST_PROP(inst, slew_step_ns),                                  \
+		.slew_steps_per_tick = DT_INST_PROP(inst, slew_steps_per_tick),                    \
 	};                                                                                         \
                                                                                                    \
 	DEVICE_DT_INST_DEFINE(inst, clock_control_emul_init, NULL,                                 \
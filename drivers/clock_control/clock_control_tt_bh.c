@@ -159,6 +159,14 @@ struct clock_control_tt_bh_data {
 	struct tt_bh_pll_settings settings;
 
 	struct k_spinlock lock;
+
+	/* AICLK slew, walked from slew_timer */
+	const struct device *dev;
+	struct k_timer slew_timer;
+	uint32_t slew_target_fbdiv;
+	bool slewing;
+	clock_control_cb_t slew_cb;
+	void *slew_cb_user_data;
 };
 
 static uint32_t clock_control_tt_bh_read_reg(const struct clock_control_tt_bh_config *config,
@@ -313,6 +321,73 @@ static uint32_t clock_control_tt_bh_get_freq(const struct clock_control_tt_bh_co
 	return (config->refclk_rate * pll_cntl_1.f.fbdiv) / (pll_cntl_1.f.refdiv * eff_postdiv);
 }
 
+/* Called with the lock held after PLL_CNTL_1 has been reprogrammed some other way, so that an
+ * AICLK slew in progress completes at the next timer expiry instead of fighting the new settings.
+ */
+static void clock_control_tt_bh_slew_abort(const struct clock_control_tt_bh_config *config,
+					   struct clock_control_tt_bh_data *data)
+{
+	union tt_bh_pll_cntl_1_reg pll_cntl_1;
+
+	if (data->slewing) {
+		pll_cntl_1.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_1_OFFSET);
+		data->slew_target_fbdiv = pll_cntl_1.f.fbdiv;
+	}
+}
+
+static void clock_control_tt_bh_slew_step(struct k_timer *timer)
+{
+	struct clock_control_tt_bh_data *data =
+		CONTAINER_OF(timer, struct clock_control_tt_bh_data, slew_timer);
+	const struct device *dev = data->dev;
+	const struct clock_control_tt_bh_config *config =
+		(const struct clock_control_tt_bh_config *)dev->config;
+	union tt_bh_pll_cntl_1_reg pll_cntl_1;
+	clock_control_cb_t cb = NULL;
+	void *user_data = NULL;
+
+	/* Each step is followed by the step time, so consecutive expiries never step faster. The
+	 * lock is only held for the step itself, not for the step time.
+	 */
+	for (int i = 0; i < CONFIG_CLOCK_CONTROL_TT_BH_AICLK_SLEW_STEPS_PER_TICK; i++) {
+		if (i > 0) {
+			k_busy_wait_ns(CONFIG_CLOCK_CONTROL_TT_BH_AICLK_SLEW_STEP_NS);
+		}
+
+		k_spinlock_key_t key = k_spin_lock(&data->lock);
+		bool done;
+
+		pll_cntl_1.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_1_OFFSET);
+
+		if (data->slew_target_fbdiv > pll_cntl_1.f.fbdiv) {
+			pll_cntl_1.f.fbdiv += 1;
+			clock_control_tt_bh_write_reg(config, PLL_CNTL_1_OFFSET, pll_cntl_1.val);
+		} else if (data->slew_target_fbdiv < pll_cntl_1.f.fbdiv) {
+			pll_cntl_1.f.fbdiv -= 1;
+			clock_control_tt_bh_write_reg(config, PLL_CNTL_1_OFFSET, pll_cntl_1.val);
+		}
+
+		done = pll_cntl_1.f.fbdiv == data->slew_target_fbdiv;
+		if (done) {
+			k_timer_stop(timer);
+			data->slewing = false;
+			cb = data->slew_cb;
+			user_data = data->slew_cb_user_data;
+			data->slew_cb = NULL;
+		}
+
+		k_spin_unlock(&data->lock, key);
+
+		if (done) {
+			break;
+		}
+	}
+
+	if (cb != NULL) {
+		cb(dev, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK, user_data);
+	}
+}
+
 static void clock_control_tt_bh_update(const struct clock_control_tt_bh_config *config,
 				       struct clock_control_tt_bh_data *data,
 				       const struct tt_bh_pll_settings *settings)
@@ -332,6 +407,7 @@ static void clock_control_tt_bh_update(const struct clock_control_tt_bh_config *
 	clock_control_tt_bh_write_reg(config, PLL_CNTL_0_OFFSET, pll_cntl_0.val);
 
 	clock_control_tt_bh_config_vco(config, settings);
+	clock_control_tt_bh_slew_abort(config, data);
 
 	/* Power sequence requires PLLEN get asserted 1us after all inputs are stable. */
 	/* Wait 5x this time to be conservative */
@@ -398,10 +474,43 @@ static int clock_control_tt_bh_off(const struct device *dev, clock_control_subsy
 	return clock_control_tt_bh_enable(dev, sys, 0U);
 }
 
+/* For AICLK, cb is called once AICLK runs at the rate last passed to clock_control_set_rate(),
+ * straight away if it already does. Only one callback can be pending.
+ */
 static int clock_control_tt_bh_async_on(const struct device *dev, clock_control_subsys_t sys,
 					clock_control_cb_t cb, void *user_data)
 {
-	return -ENOSYS;
+	struct clock_control_tt_bh_data *data = (struct clock_control_tt_bh_data *)dev->data;
+	enum clock_control_tt_bh_clock clock = (enum clock_control_tt_bh_clock)(uintptr_t)sys;
+	k_spinlock_key_t key;
+
+	if (clock != CLOCK_CONTROL_TT_BH_CLOCK_AICLK) {
+		return -ENOSYS;
+	}
+
+	if (k_spin_trylock(&data->lock, &key) < 0) {
+		return -EBUSY;
+	}
+
+	if (data->slewing) {
+		if (data->slew_cb != NULL) {
+			k_spin_unlock(&data->lock, key);
+			return -EBUSY;
+		}
+
+		data->slew_cb = cb;
+		data->slew_cb_user_data = user_data;
+		k_spin_unlock(&data->lock, key);
+		return 0;
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	if (cb != NULL) {
+		cb(dev, sys, user_data);
+	}
+
+	return 0;
 }
 
 static int clock_control_tt_bh_get_rate(const struct device *dev, clock_control_subsys_t sys,
@@ -458,6 +567,13 @@ static int clock_control_tt_bh_get_rate(const struct device *dev, clock_control_
 static enum clock_control_status clock_control_tt_bh_get_status(const struct device *dev,
 								clock_control_subsys_t sys)
 {
+	struct clock_control_tt_bh_data *data = (struct clock_control_tt_bh_data *)dev->data;
+	enum clock_control_tt_bh_clock clock = (enum clock_control_tt_bh_clock)(uintptr_t)sys;
+
+	if (clock == CLOCK_CONTROL_TT_BH_CLOCK_AICLK) {
+		return data->slewing ? CLOCK_CONTROL_STATUS_STARTING : CLOCK_CONTROL_STATUS_ON;
+	}
+
 	return CLOCK_CONTROL_STATUS_UNKNOWN;
 }
 
@@ -507,15 +623,11 @@ static int clock_control_tt_bh_set_rate(const struct device *dev, clock_control_
 			clock_control_tt_bh_calculate_fbdiv(config->refclk_rate, (uint32_t)rate,
 							    pll_cntl_1, pll_cntl_5, use_postdiv, 0);
 
-		while (pll_cntl_1.f.fbdiv != target_fbdiv) {
-			if (target_fbdiv > pll_cntl_1.f.fbdiv) {
-				pll_cntl_1.f.fbdiv += 1;
-			} else {
-				pll_cntl_1.f.fbdiv -= 1;
-			}
-
-			clock_control_tt_bh_write_reg(config, PLL_CNTL_1_OFFSET, pll_cntl_1.val);
-			k_busy_wait_ns(100);
+		/* Walk fbdiv to the target in the background. A slew in progress is redirected */
+		data->slew_target_fbdiv = target_fbdiv;
+		if (!data->slewing && pll_cntl_1.f.fbdiv != target_fbdiv) {
+			data->slewing = true;
+			k_timer_start(&data->slew_timer, K_NO_WAIT, K_TICKS(1));
 		}
 	} else if (clock == CLOCK_CONTROL_TT_BH_INIT_STATE) {
 		struct tt_bh_pll_settings settings = config->init_settings;
@@ -558,6 +670,7 @@ static int clock_control_tt_bh_configure(const struct device *dev, clock_control
 
 		/* Disable all external postdivs on all PLLs */
 		clock_control_tt_bh_write_reg(config, PLL_USE_POSTDIV_OFFSET, 0);
+		clock_control_tt_bh_slew_abort(config, data);
 
 		k_spin_unlock(&data->lock, key);
 		return 0;
@@ -580,6 +693,8 @@ static int clock_control_tt_bh_init(const struct device *dev)
 	}
 
 	data->settings = config->init_settings;
+	data->dev = dev;
+	k_timer_init(&data->slew_timer, clock_control_tt_bh_slew_step, NULL);
 	union tt_bh_pll_cntl_0_reg pll_cntl_0;
 
 	/* Before turning off PLL, bypass PLL so glitch free mux has no chance to switch */
@@ -56,12 +56,20 @@
 /* ARC DMA Attribute Flags */
 #define ARC_DMA_NP_ATTR             (1 << 3) /* Enable non posted writes */
 #define ARC_DMA_SET_DONE_ATTR       (1 << 0) /* Set done without triggering interrupt */
+#define ARC_DMA_INT_ATTR            (1 << 1) /* Raise the channel done interrupt */
 #define ARC_DMA_MAX_CHANNELS        16
 #define ARC_DMA_MAX_DESCRIPTORS     256
 /* Use the actual configured channels for this instance */
 #define ARC_DMA_CONFIGURED_CHANNELS DT_INST_PROP(0, dma_channels)
 #define ARC_DMA_ATOMIC_WORDS        ATOMIC_BITMAP_SIZE(ARC_DMA_MAX_CHANNELS)
 
+/*
+ * Without a done interrupt, active channels are polled. The interval starts short, so small
+ * transfers complete quickly, and doubles while nothing completes, so long ones cost little.
+ */
+#define ARC_DMA_POLL_MIN_US 10
+#define ARC_DMA_POLL_MAX_US 1000
+
 LOG_MODULE_REGISTER(dma_arc, CONFIG_DMA_LOG_LEVEL);
 
 /* Channel states */
@@ -80,8 +88,14 @@ struct arc_dma_channel {
 	struct dma_config config;
 	struct dma_block_config block_config; /* Copy of first block config */
 	uint32_t handle;
+	/* Last descriptor of a transfer stopped before completing, whose done status is still to
+	 * be cleared
+	 */
+	bool stopped_pending;
+	uint32_t stopped_handle;
 	uint32_t block_count;      /* Total number of blocks */
 	struct k_spinlock hw_lock; /* Per-channel hardware access lock */
+	struct k_sem done;         /* Given on completion of a dma_arc_hs_transfer() */
 };
 
 struct arc_dma_config {
@@ -93,6 +107,8 @@ struct arc_dma_config {
 	uint32_t buffer_size;
 	uint32_t max_block_size;
 	bool coherency_support;
+	/* Connects the done interrupts, NULL if the devicetree node has none */
+	void (*irq_config)(void);
 };
 
 /* We'll define per-instance data structures with the actual channel count */
@@ -101,10 +117,11 @@ struct arc_dma_data {
 	struct arc_dma_channel *channels; /* Will point to instance-specific array */
 	atomic_t channels_atomic[ARC_DMA_ATOMIC_WORDS];
 	struct k_spinlock lock;
-	struct k_work_delayable completion_work;
+	/* Polls active channels when there is no done interrupt */
+	struct k_timer poll_timer;
+	uint32_t poll_us;
 	const struct device *dev;
-	bool work_initialized;
-	/* Static block array for splitting large transfers - sized by max descriptors */
+	/* Static block arrays for splitting large transfers - max descriptors per channel */
 	struct dma_block_config *transfer_blocks;
 };
 
@@ -170,6 +187,35 @@ static uint32_t dma_arc_hs_get_done_hw(uint32_t handle)
 	return state & 0x1;
 }
 
+/* Descriptor attributes. Only the last block of a transfer raises the done interrupt. */
+static uint32_t dma_arc_hs_attr(const struct device *dev, bool last)
+{
+	const struct arc_dma_config *dev_config = dev->config;
+	uint32_t attr = ARC_DMA_SET_DONE_ATTR | ARC_DMA_NP_ATTR;
+
+	if (last && dev_config->irq_config != NULL) {
+		attr |= ARC_DMA_INT_ATTR;
+	}
+
+	return attr;
+}
+
+/* Make sure a transfer that was just started is noticed when it completes */
+static void dma_arc_hs_arm_completion(const struct device *dev)
+{
+	const struct arc_dma_config *dev_config = dev->config;
+	struct arc_dma_data *data = dev->data;
+
+	if (dev_config->irq_config != NULL) {
+		return;
+	}
+
+	K_SPINLOCK(&data->lock) {
+		data->poll_us = ARC_DMA_POLL_MIN_US;
+	}
+	k_timer_start(&data->poll_timer, K_USEC(ARC_DMA_POLL_MIN_US), K_NO_WAIT);
+}
+
 static int dma_arc_hs_config(const struct device *dev, uint32_t channel, struct dma_config *config)
 {
 	const struct arc_dma_config *dev_config = dev->config;
@@ -204,9 +250,18 @@ static int dma_arc_hs_config(const struct device *dev, uint32_t channel, struct
 		return -EINVAL;
 	}
 
+	int ret = 0;
+
 	K_SPINLOCK(&data->lock) {
 		chan = &data->channels[channel];
 
+		/* The descriptors of a transfer in progress must not be rewritten under it */
+		if (chan->state == ARC_DMA_ACTIVE) {
+			LOG_ERR("Channel %u is busy", channel);
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
 		/* Implicit channel allocation - allocate if not already allocated */
 		if (chan->state == ARC_DMA_FREE) {
 			/* Update atomic bitmap for consistency with DMA framework */
@@ -229,8 +284,11 @@ static int dma_arc_hs_config(const struct device *dev, uint32_t channel, struct
 		}
 	}
 
-	LOG_DBG("Configured channel %u", channel);
-	return 0;
+	if (ret == 0) {
+		LOG_DBG("Configured channel %u", channel);
+	}
+
+	return ret;
 }
 
 static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
@@ -239,7 +297,6 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 	struct arc_dma_data *data = dev->data;
 	struct arc_dma_channel *chan;
 	struct dma_block_config *block;
-	uint32_t attr;
 	uint32_t block_idx = 0;
 	k_spinlock_key_t key, hw_key;
 	uint32_t current_channel = channel;
@@ -287,8 +344,6 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 		return -EINVAL;
 	}
 
-	attr = ARC_DMA_SET_DONE_ATTR | ARC_DMA_NP_ATTR;
-
 	/* Lock hardware access for this channel */
 	hw_key = k_spin_lock(&chan->hw_lock);
 
@@ -300,7 +355,8 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 		(uint32_t)block->dest_address, block->block_size);
 
 	dma_arc_hs_start_hw(current_channel, (const void *)block->source_address,
-			    (void *)block->dest_address, block->block_size, attr);
+			    (void *)block->dest_address, block->block_size,
+			    dma_arc_hs_attr(dev, chan->config.block_count == 1));
 	block_idx++;
 	block = block->next_block;
 
@@ -311,7 +367,8 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 			block->block_size);
 
 		dma_arc_hs_next_hw((const void *)block->source_address, (void *)block->dest_address,
-				   block->block_size, attr);
+				   block->block_size,
+				   dma_arc_hs_attr(dev, block_idx + 1 == chan->config.block_count));
 		block_idx++;
 		block = block->next_block;
 	}
@@ -328,8 +385,7 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 
 	k_spin_unlock(&data->lock, key);
 
-	/* Schedule completion work to check for transfer completion */
-	k_work_schedule(&data->completion_work, K_MSEC(1));
+	dma_arc_hs_arm_completion(dev);
 
 	LOG_DBG("Started DMA transfer on channel %u, handle %u", current_channel, chan->handle);
 	return 0;
@@ -366,6 +422,10 @@ static int dma_arc_hs_stop(const struct device *dev, uint32_t channel)
 
 	chan->state = ARC_DMA_IDLE;
 	dma_arc_hs_clear_done_hw(chan->handle);
+	if (dev_config->irq_config != NULL) {
+		chan->stopped_pending = true;
+		chan->stopped_handle = chan->handle;
+	}
 
 	k_spin_unlock(&chan->hw_lock, hw_key);
 	k_spin_unlock(&data->lock, key);
@@ -403,7 +463,8 @@ static size_t dma_arc_hs_calc_linked_transfer_size(struct arc_dma_channel *chan,
 	return transfer_size;
 }
 
-static void dma_arc_hs_check_completion(const struct device *dev, uint32_t channel)
+/* Retire the transfer of a channel if it has completed, returns true if it has */
+static bool dma_arc_hs_check_completion(const struct device *dev, uint32_t channel)
 {
 	struct arc_dma_data *data = dev->data;
 	const struct arc_dma_config *dev_config = dev->config;
@@ -421,7 +482,7 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 
 	if (chan->state != ARC_DMA_ACTIVE) {
 		k_spin_unlock(&data->lock, key);
-		return;
+		return false;
 	}
 
 	/* Copy the minimal state we need for the rest of the function */
@@ -441,7 +502,7 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 	/* Re-check state after acquiring hw_lock in case channel was stopped concurrently */
 	if (chan->state != ARC_DMA_ACTIVE) {
 		k_spin_unlock(&chan->hw_lock, hw_key);
-		return;
+		return false;
 	}
 
 	uint32_t done_status = dma_arc_hs_get_done_hw(handle);
@@ -449,7 +510,7 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 	if (done_status == 0) {
 		/* Transfer still running */
 		k_spin_unlock(&chan->hw_lock, hw_key);
-		return;
+		return false;
 	}
 
 	/* Transfer really finished */
@@ -487,10 +548,9 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 			size_t transfer_size =
 				dma_arc_hs_calc_linked_transfer_size(chan, block, burst_len);
 
-			uint32_t attr = ARC_DMA_SET_DONE_ATTR | ARC_DMA_NP_ATTR;
-
 			dma_arc_hs_start_hw(linked_ch, (const void *)src_addr,
-					    (void *)(uintptr_t)dst_addr, transfer_size, attr);
+					    (void *)(uintptr_t)dst_addr, transfer_size,
+					    dma_arc_hs_attr(dev, true));
 
 			linked_chan->handle = dma_arc_hs_get_handle_hw();
 			linked_chan->state = ARC_DMA_ACTIVE;
@@ -499,12 +559,15 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 			LOG_DBG("Linked channel %u started (size %zu)", linked_ch, transfer_size);
 
 			k_spin_unlock(&linked_chan->hw_lock, linked_hw_key);
+			dma_arc_hs_arm_completion(dev);
 		} else {
 			k_spin_unlock(&data->lock, key);
 			LOG_WRN("Linked channel %u not ready (state=%d)", linked_ch,
 				linked_chan->state);
 		}
 	}
+
+	return true;
 }
 
 static int dma_arc_hs_get_status(const struct device *dev, uint32_t channel,
@@ -614,11 +677,10 @@ static int dma_arc_hs_get_status(const struct device *dev, uint32_t channel,
 					size_t transfer_size = dma_arc_hs_calc_linked_transfer_size(
 						chan, block, burst_len);
 
-					uint32_t attr = ARC_DMA_SET_DONE_ATTR | ARC_DMA_NP_ATTR;
-
 					dma_arc_hs_start_hw(linked_ch, (const void *)src_addr,
 							    (void *)(uintptr_t)dst_addr,
-							    transfer_size, attr);
+							    transfer_size,
+							    dma_arc_hs_attr(dev, true));
 
 					/* Get handle for the linked channel */
 					linked_chan->handle = dma_arc_hs_get_handle_hw();
@@ -629,6 +691,7 @@ static int dma_arc_hs_get_status(const struct device *dev, uint32_t channel,
 						transfer_size);
 
 					k_spin_unlock(&linked_chan->hw_lock, linked_hw_key);
+					dma_arc_hs_arm_completion(dev);
 				} else {
 					k_spin_unlock(&data->lock, key);
 					LOG_WRN("Linked channel %u not ready (state=%d)", linked_ch,
@@ -667,41 +730,188 @@ static int dma_arc_hs_get_attribute(const struct device *dev, uint32_t type, uin
 	return 0;
 }
 
-static void dma_arc_hs_completion_work_handler(struct k_work *work)
+static void dma_arc_hs_poll_timer_handler(struct k_timer *timer)
 {
-	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
-	struct arc_dma_data *data = CONTAINER_OF(dwork, struct arc_dma_data, completion_work);
+	struct arc_dma_data *data = CONTAINER_OF(timer, struct arc_dma_data, poll_timer);
 	const struct device *dev = data->dev;
 	const struct arc_dma_config *config = dev->config;
+	bool completed = false;
 	bool any_active = false;
+	uint32_t poll_us;
 	int i;
 
 	/* Check all channels for completion */
 	for (i = 0; i < config->channels; i++) {
 		if (data->channels[i].state == ARC_DMA_ACTIVE) {
-			any_active = true;
-			dma_arc_hs_check_completion(dev, i);
+			completed |= dma_arc_hs_check_completion(dev, i);
 		}
 	}
 
-	/* Reschedule work if there are still active transfers */
-	if (any_active) {
-		/* Poll every 1ms when transfers are active */
-		k_work_schedule(&data->completion_work, K_MSEC(1));
-	} else {
-		LOG_DBG("No active transfers, work handler idle");
+	/* Completions can start linked channels, so look again */
+	for (i = 0; i < config->channels; i++) {
+		any_active |= data->channels[i].state == ARC_DMA_ACTIVE;
+	}
+
+	if (!any_active) {
+		LOG_DBG("No active transfers, poll timer idle");
+		return;
+	}
+
+	K_SPINLOCK(&data->lock) {
+		data->poll_us = completed ? ARC_DMA_POLL_MIN_US
+					  : MIN(data->poll_us * 2, ARC_DMA_POLL_MAX_US);
+		poll_us = data->poll_us;
 	}
+	k_timer_start(timer, K_USEC(poll_us), K_NO_WAIT);
 }
 
-int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *src, void *dst,
-			size_t len, k_timeout_t timeout)
+/*
+ * Clear the done status of a transfer that was stopped before completing. Its done bit raises
+ * the interrupt when the transfer ends, and nothing else would clear it. The descriptor is left
+ * alone while a new transfer uses it.
+ */
+static void dma_arc_hs_ack_stopped(const struct device *dev, uint32_t channel)
 {
-	const struct arc_dma_config *dev_config = dev->config;
+	const struct arc_dma_config *config = dev->config;
 	struct arc_dma_data *data = dev->data;
+	struct arc_dma_channel *chan = &data->channels[channel];
+
+	K_SPINLOCK(&data->lock) {
+		if (!chan->stopped_pending) {
+			K_SPINLOCK_BREAK;
+		}
+
+		for (uint32_t i = 0; i < config->channels; i++) {
+			if (data->channels[i].state == ARC_DMA_ACTIVE &&
+			    data->channels[i].handle == chan->stopped_handle) {
+				chan->stopped_pending = false;
+			}
+		}
+
+		if (chan->stopped_pending && dma_arc_hs_get_done_hw(chan->stopped_handle) != 0) {
+			dma_arc_hs_clear_done_hw(chan->stopped_handle);
+			chan->stopped_pending = false;
+		}
+	}
+}
+
+static __maybe_unused void dma_arc_hs_isr(const struct device *dev)
+{
+	const struct arc_dma_config *config = dev->config;
+	struct arc_dma_data *data = dev->data;
+
+	/* Retiring a transfer clears its done status, which acknowledges the interrupt */
+	for (uint32_t i = 0; i < config->channels; i++) {
+		if (data->channels[i].state == ARC_DMA_ACTIVE) {
+			dma_arc_hs_check_completion(dev, i);
+		}
+		dma_arc_hs_ack_stopped(dev, i);
+	}
+}
+
+static void dma_arc_hs_transfer_done(const struct device *dev, void *user_data, uint32_t channel,
+				     int status)
+{
+	k_sem_give((struct k_sem *)user_data);
+}
+
+/*
+ * Queue a prepared block list on a channel. Threads are woken through the channel's semaphore when
+ * the last block completes, callers that cannot sleep poll the channel status instead.
+ */
+static int dma_arc_hs_start_blocks(const struct device *dev, uint32_t channel,
+				   struct dma_block_config *head_block, uint32_t block_count)
+{
+	struct arc_dma_data *data = dev->data;
+	struct k_sem *done = &data->channels[channel].done;
 	struct dma_config cfg = {0};
+	int rc;
+
+	cfg.channel_direction = MEMORY_TO_MEMORY;
+	cfg.head_block = head_block;
+	cfg.block_count = block_count;
+	if (!k_is_in_isr() && !k_is_pre_kernel()) {
+		cfg.dma_callback = dma_arc_hs_transfer_done;
+		cfg.user_data = done;
+		k_sem_reset(done);
+	}
+
+	rc = dma_config(dev, channel, &cfg);
+	if (rc < 0) {
+		return rc;
+	}
+
+	return dma_start(dev, channel);
+}
+
+/* Wait for the block list started by dma_arc_hs_start_blocks() and release the channel */
+static int dma_arc_hs_wait_blocks(const struct device *dev, uint32_t channel, k_timeout_t timeout)
+{
+	struct arc_dma_data *data = dev->data;
+	struct k_sem *done = &data->channels[channel].done;
 	struct dma_status stat;
 	k_timepoint_t end_time;
 	int rc;
+
+	if (!k_is_in_isr() && !k_is_pre_kernel()) {
+		rc = k_sem_take(done, timeout);
+		dma_stop(dev, channel);
+		return (rc == 0) ? 0 : -ETIMEDOUT;
+	}
+
+	end_time = sys_timepoint_calc(timeout);
+
+	do {
+		if (dma_get_status(dev, channel, &stat) == 0 && !stat.busy) {
+			dma_stop(dev, channel);
+			return 0;
+		}
+
+		/* Update timeout with remaining time */
+		timeout = sys_timepoint_timeout(end_time);
+
+		/* Busy wait for a short period */
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_busy_wait(ARC_DMA_POLL_MIN_US);
+		}
+	} while (!K_TIMEOUT_EQ(timeout, K_NO_WAIT));
+
+	/* Timeout expired */
+	dma_stop(dev, channel);
+	return -ETIMEDOUT;
+}
+
+static int dma_arc_hs_run_blocks(const struct device *dev, uint32_t channel,
+				 struct dma_block_config *head_block, uint32_t block_count,
+				 k_timeout_t timeout)
+{
+	int rc = dma_arc_hs_start_blocks(dev, channel, head_block, block_count);
+
+	if (rc < 0) {
+		return rc;
+	}
+
+	return dma_arc_hs_wait_blocks(dev, channel, timeout);
+}
+
+/* The transfer_blocks of one channel, so transfers on different channels can be split at once */
+static struct dma_block_config *dma_arc_hs_channel_blocks(const struct device *dev,
+							  uint32_t channel)
+{
+	const struct arc_dma_config *dev_config = dev->config;
+	struct arc_dma_data *data = dev->data;
+
+	return &data->transfer_blocks[channel * dev_config->descriptors];
+}
+
+/*
+ * Check a contiguous transfer against the hardware limits and split it into the channel's
+ * transfer_blocks, at most max_block_size bytes each.
+ */
+static int dma_arc_hs_split(const struct device *dev, uint32_t channel, const void *src, void *dst,
+			    size_t len, size_t *block_count)
+{
+	const struct arc_dma_config *dev_config = dev->config;
 	size_t num_blocks;
 	size_t max_block_size;
 
@@ -710,10 +920,6 @@ int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *
 		return -ENODEV;
 	}
 
-	if (len == 0) {
-		return 0;
-	}
-
 	uint32_t required_alignment;
 	int ret = dma_get_attribute(dev, DMA_ATTR_BUFFER_ADDRESS_ALIGNMENT, &required_alignment);
 
@@ -748,7 +954,7 @@ int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *
 	}
 
 	/* Use statically allocated transfer_blocks array (no malloc needed) */
-	struct dma_block_config *blocks = data->transfer_blocks;
+	struct dma_block_config *blocks = dma_arc_hs_channel_blocks(dev, channel);
 
 	/* Split the transfer into multiple blocks */
 	size_t remaining = len;
@@ -774,40 +980,112 @@ int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *
 			max_block_size);
 	}
 
-	cfg.channel_direction = MEMORY_TO_MEMORY;
-	cfg.head_block = blocks;
-	cfg.block_count = num_blocks;
+	*block_count = num_blocks;
+	return 0;
+}
 
-	rc = dma_config(dev, channel, &cfg);
-	if (rc < 0) {
-		return rc;
+int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *src, void *dst,
+			size_t len, k_timeout_t timeout)
+{
+	size_t num_blocks;
+	int ret;
+
+	if (len == 0) {
+		return 0;
 	}
 
-	rc = dma_start(dev, channel);
-	if (rc < 0) {
-		return rc;
+	ret = dma_arc_hs_split(dev, channel, src, dst, len, &num_blocks);
+	if (ret < 0) {
+		return ret;
 	}
 
-	end_time = sys_timepoint_calc(timeout);
+	return dma_arc_hs_run_blocks(dev, channel, dma_arc_hs_channel_blocks(dev, channel),
+				     num_blocks, timeout);
+}
 
-	do {
-		if (dma_get_status(dev, channel, &stat) == 0 && !stat.busy) {
-			dma_stop(dev, channel);
-			return 0;
+int dma_arc_hs_transfer_start(const struct device *dev, uint32_t channel, const void *src,
+			      void *dst, size_t len)
+{
+	size_t num_blocks;
+	int ret;
+
+	if (len == 0) {
+		return -EINVAL;
+	}
+
+	ret = dma_arc_hs_split(dev, channel, src, dst, len, &num_blocks);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The descriptors are written at start, so transfer_blocks is free again on return */
+	return dma_arc_hs_start_blocks(dev, channel, dma_arc_hs_channel_blocks(dev, channel),
+				       num_blocks);
+}
+
+int dma_arc_hs_transfer_wait(const struct device *dev, uint32_t channel, k_timeout_t timeout)
+{
+	const struct arc_dma_config *dev_config = dev->config;
+
+	if (channel >= dev_config->channels) {
+		LOG_ERR("Invalid channel %u", channel);
+		return -EINVAL;
+	}
+
+	return dma_arc_hs_wait_blocks(dev, channel, timeout);
+}
+
+int dma_arc_hs_transfer_blocks(const struct device *dev, uint32_t channel,
+			       struct dma_block_config *head_block, uint32_t block_count,
+			       k_timeout_t timeout)
+{
+	const struct arc_dma_config *dev_config;
+	struct dma_block_config *block = head_block;
+	uint32_t alignment_mask;
+
+	if (dev == NULL || !device_is_ready(dev)) {
+		LOG_ERR("DMA device not ready");
+		return -ENODEV;
+	}
+
+	dev_config = dev->config;
+
+	if (channel >= dev_config->channels) {
+		LOG_ERR("Invalid channel %u", channel);
+		return -EINVAL;
+	}
+
+	if (block_count == 0 || block_count > dev_config->descriptors) {
+		LOG_ERR("block_count %u must be between 1 and %u", block_count,
+			dev_config->descriptors);
+		return -EINVAL;
+	}
+
+	/* Buffers are 32-bit aligned, see dma_arc_hs_get_attribute */
+	alignment_mask = 4 - 1;
+
+	for (uint32_t i = 0; i < block_count; i++) {
+		if (block == NULL) {
+			LOG_ERR("Block list shorter than block_count %u", block_count);
+			return -EINVAL;
 		}
 
-		/* Update timeout with remaining time */
-		timeout = sys_timepoint_timeout(end_time);
+		if ((block->source_address & alignment_mask) ||
+		    (block->dest_address & alignment_mask)) {
+			LOG_ERR("Block %u src/dst not aligned to %u", i, alignment_mask + 1);
+			return -EINVAL;
+		}
 
-		/* Busy wait for a short period */
-		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-			k_busy_wait(100);
+		if (block->block_size > dev_config->max_block_size) {
+			LOG_ERR("Block %u size %u exceeds max block size %u", i, block->block_size,
+				dev_config->max_block_size);
+			return -EINVAL;
 		}
-	} while (!K_TIMEOUT_EQ(timeout, K_NO_WAIT));
 
-	/* Timeout expired */
-	dma_stop(dev, channel);
-	return -ETIMEDOUT;
+		block = block->next_block;
+	}
+
+	return dma_arc_hs_run_blocks(dev, channel, head_block, block_count, timeout);
 }
 
 static const struct dma_driver_api dma_arc_hs_api = {
@@ -840,6 +1118,8 @@ static int dma_arc_hs_init(const struct device *dev)
 		data->channels[i].callback = NULL;
 		data->channels[i].callback_arg = NULL;
 		data->channels[i].block_count = 0;
+		data->channels[i].stopped_pending = false;
+		k_sem_init(&data->channels[i].done, 0, 1);
 		/* Spinlocks are zero-initialized by default in Zephyr */
 	}
 
@@ -849,16 +1129,32 @@ static int dma_arc_hs_init(const struct device *dev)
 		dma_arc_hs_init_channel_hw(i, 0, config->descriptors - 1);
 	}
 
-	/* Initialize completion work queue */
+	/* Completion is signalled by the done interrupts if there are any, else polled */
 	data->dev = dev;
-	k_work_init_delayable(&data->completion_work, dma_arc_hs_completion_work_handler);
-	data->work_initialized = true;
+	k_timer_init(&data->poll_timer, dma_arc_hs_poll_timer_handler, NULL);
+	if (config->irq_config != NULL) {
+		config->irq_config();
+	}
 
 	LOG_DBG("ARC DMA initialized successfully");
 	return 0;
 }
 
+#define ARC_DMA_IRQ_CONNECT(idx, inst)                                                             \
+	IRQ_CONNECT(DT_INST_IRQN_BY_IDX(inst, idx), DT_INST_IRQ_BY_IDX(inst, idx, priority),      \
+		    dma_arc_hs_isr, DEVICE_DT_INST_GET(inst), 0);                                  \
+	irq_enable(DT_INST_IRQN_BY_IDX(inst, idx))
+
+/* One done interrupt per channel, or a single one shared by all of them */
+#define ARC_DMA_IRQ_CONFIG(inst)                                                                   \
+	static void arc_dma_irq_config_##inst(void)                                                \
+	{                                                                                          \
+		LISTIFY(DT_INST_NUM_IRQS(inst), ARC_DMA_IRQ_CONNECT, (;), inst);                   \
+	}
+
 #define ARC_DMA_INIT(inst)                                                                         \
+	IF_ENABLED(DT_INST_IRQ_HAS_IDX(inst, 0), (ARC_DMA_IRQ_CONFIG(inst)))                       \
+                                                                                                   \
 	static const struct arc_dma_config arc_dma_config_##inst = {                               \
 		.base = DMA_AUX_BASE, /*not in addressable memory*/                                \
 		.channels = DT_INST_PROP(inst, dma_channels),                                      \
@@ -868,12 +1164,16 @@ static int dma_arc_hs_init(const struct device *dev)
 		.buffer_size = DT_INST_PROP(inst, buffer_size),                                    \
 		.max_block_size = DT_INST_PROP(inst, dma_max_block_size),                          \
 		.coherency_support = DT_INST_PROP(inst, coherency_support),                        \
+		.irq_config = COND_CODE_1(DT_INST_IRQ_HAS_IDX(inst, 0),                            \
+					  (arc_dma_irq_config_##inst), (NULL)),                    \
 	};                                                                                         \
                                                                                                    \
 	/* Allocate only the needed number of channels */                                          \
 	static struct arc_dma_channel arc_dma_channels_##inst[DT_INST_PROP(inst, dma_channels)];   \
-	/* Statically allocate transfer blocks - sized by max descriptors */                       \
-	static struct dma_block_config arc_dma_blocks_##inst[DT_INST_PROP(inst, dma_descriptors)]; \
+	/* Statically allocate transfer blocks - max descriptors per channel */                    \
+	static struct dma_block_config                                                             \
+		arc_dma_blocks_##inst[DT_INST_PROP(inst, dma_channels) *                           \
+				      DT_INST_PROP(inst, dma_descriptors)];                        \
 	static struct arc_dma_data arc_dma_data_##inst = {                                         \
 		.channels = arc_dma_channels_##inst,                                               \
 		.transfer_blocks = arc_dma_blocks_##inst,                                          \
@@ -21,13 +21,10 @@
 
 LOG_MODULE_REGISTER(dma_noc_tt_bh, CONFIG_DMA_LOG_LEVEL);
 
-#define NOC_DMA_TLB        0
 #define NOC_DMA_NOC_ID     0
 #define NOC_DMA_TIMEOUT_MS 50
 #define NOC_MAX_BURST_SIZE 16384
 
-#define DMA_MAX_TRANSFER_BLOCKS 4
-
 /* NOC CMD fields */
 #define NOC_CMD_CPY               (0 << 0)
 #define NOC_CMD_RD                (0 << 1)
@@ -58,16 +55,31 @@ LOG_MODULE_REGISTER(dma_noc_tt_bh, CONFIG_DMA_LOG_LEVEL);
 #define DMA_CHANNEL_INVALID 0xFFFFFFFF
 
 struct tt_bh_dma_channel_resettable_data {
-	/* Hardware completion tracking for get_status() */
-	uint32_t last_noc_cmd;
-	uint32_t last_expected_acks;
-	uint16_t block_index;
-	uint16_t block_count;
+	/* Next block of the chain to land, and the ack counter value once it has */
+	const struct dma_block_config *landing;
+	uint32_t landing_ack;
+	/* Ack counter value once the whole chain has landed */
+	uint32_t end_ack;
+	uint32_t pending_length;
+	/* NIU_MST_WR_ACK_RECEIVED or NIU_MST_RD_RESP_RECEIVED, depending on the direction */
+	uint32_t ack_reg;
+	k_timepoint_t timeout;
+	/* Blocks that have landed */
+	uint32_t block_index;
+	uint32_t block_count;
+	/* Tile whose NIU runs the commands, and the TLB entry mapping its registers */
+	uint8_t niu_x, niu_y;
+	uint8_t tlb;
 	bool configured: 1;
+	bool issued: 1;
+	bool busy: 1;
 };
 
+/*
+ * The blocks are not copied, the chain of the dma_config stays with the caller until the
+ * transfer completes.
+ */
 struct tt_bh_dma_channel_data {
-	struct dma_block_config blocks[DMA_MAX_TRANSFER_BLOCKS];
 	struct tt_bh_dma_noc_coords coords;
 	struct dma_config config;
 	struct tt_bh_dma_channel_resettable_data state;
@@ -88,31 +100,27 @@ struct tt_bh_dma_noc_config {
  * Initialized in the tt_bh_dma_noc_init() functions.
  */
 struct tt_bh_dma_noc_data {
+	/* Protects the channel state, which the poll timer reads */
 	struct k_spinlock lock;
+	/* Serializes writes to the NIU command registers */
+	struct k_mutex issue_lock;
+	/* Retires the blocks of busy channels */
+	struct k_timer poll_timer;
+	bool polling;
 };
 
-static bool noc_wait_cmd_ready(void)
+static bool noc_wait_cmd_ready(uint8_t tlb)
 {
 	uint32_t cmd_ctrl;
 	k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
 
 	do {
-		cmd_ctrl = NOC2AXIRead32(NOC_DMA_NOC_ID, NOC_DMA_TLB, CMD_CTRL);
+		cmd_ctrl = NOC2AXIRead32(NOC_DMA_NOC_ID, tlb, CMD_CTRL);
 	} while (cmd_ctrl != 0 && !sys_timepoint_expired(timeout));
 
 	return cmd_ctrl == 0;
 }
 
-static uint32_t get_expected_acks(uint32_t noc_cmd, uint64_t size)
-{
-	uint32_t ack_reg_addr =
-		(noc_cmd & NOC_CMD_WR) ? NIU_MST_WR_ACK_RECEIVED : NIU_MST_RD_RESP_RECEIVED;
-	uint32_t packet_received = NOC2AXIRead32(NOC_DMA_NOC_ID, NOC_DMA_TLB, ack_reg_addr);
-	uint32_t expected_acks = packet_received + DIV_ROUND_UP(size, NOC_MAX_BURST_SIZE);
-
-	return expected_acks;
-}
-
 /* wrap around aware comparison for half-range rule */
 static inline bool is_behind(uint32_t current, uint32_t target)
 {
@@ -143,37 +151,65 @@ static inline uint32_t noc_coord_encode_range(uint32_t start_x, uint32_t start_y
 	return (start_y << 18) | (start_y << 12) | (end_y << 6) | end_x;
 }
 
-static void handle_transfer_callbacks(const struct device *dev,
-				      struct tt_bh_dma_channel_data *chan_data, uint32_t channel,
-				      int transfer_ret, bool is_final_block)
+static void handle_transfer_callbacks(const struct device *dev, const struct dma_config *config,
+				      uint32_t channel, int transfer_ret, bool is_final_block)
 {
-	if (!chan_data->config.dma_callback) {
+	if (!config->dma_callback) {
 		return;
 	}
 
 	if (transfer_ret == 0) {
 		/* Success callbacks */
-		if (chan_data->config.complete_callback_en && !is_final_block) {
+		if (config->complete_callback_en && !is_final_block) {
 			/* Per-block callback */
-			chan_data->config.dma_callback(dev, chan_data->config.user_data, channel,
-						       DMA_STATUS_BLOCK);
+			config->dma_callback(dev, config->user_data, channel, DMA_STATUS_BLOCK);
 		}
 
 		if (is_final_block) {
 			/* Transfer completion callback */
-			chan_data->config.dma_callback(dev, chan_data->config.user_data, channel,
-						       DMA_STATUS_COMPLETE);
+			config->dma_callback(dev, config->user_data, channel, DMA_STATUS_COMPLETE);
 		}
-	} else if (!chan_data->config.error_callback_dis) {
+	} else if (!config->error_callback_dis) {
 		/* Error callback - pass negative errno */
-		chan_data->config.dma_callback(dev, chan_data->config.user_data, channel, -EIO);
+		config->dma_callback(dev, config->user_data, channel, -EIO);
+	}
+}
+
+static inline uint32_t noc_dma_bursts(const struct dma_block_config *block)
+{
+	return DIV_ROUND_UP(block->block_size, NOC_MAX_BURST_SIZE);
+}
+
+/*
+ * Ack counter value after which new commands on a tile land. The counter is shared by every
+ * command the NIU of a tile runs, so commands issued while others are still in flight on the
+ * same tile land after them, not after the acks received so far. Must be called with the lock
+ * held.
+ */
+static uint32_t noc_dma_ack_base(const struct tt_bh_dma_noc_config *cfg, uint8_t tlb,
+				 uint8_t niu_x, uint8_t niu_y, uint32_t ack_reg)
+{
+	uint32_t base = NOC2AXIRead32(NOC_DMA_NOC_ID, tlb, ack_reg);
+
+	for (uint32_t i = 0; i < cfg->num_channels; i++) {
+		struct tt_bh_dma_channel_resettable_data *other = &cfg->channels[i].state;
+
+		if (!other->busy || !other->issued || other->ack_reg != ack_reg ||
+		    other->niu_x != niu_x || other->niu_y != niu_y) {
+			continue;
+		}
+
+		if (is_behind(base, other->end_ack)) {
+			base = other->end_ack;
+		}
 	}
+
+	return base;
 }
 
-static int noc_dma_transfer(uint32_t cmd, uint32_t ret_coord, uint64_t ret_addr,
+static int noc_dma_transfer(uint8_t tlb, uint32_t cmd, uint32_t ret_coord, uint64_t ret_addr,
 			    uint32_t targ_coord, uint64_t targ_addr, uint32_t size, bool multicast,
-			    uint8_t transaction_id, bool include_self, uint32_t *noc_cmd_out,
-			    uint32_t *expected_acks_out)
+			    uint8_t transaction_id, bool include_self)
 {
 	uint32_t ret_addr_lo = low32(ret_addr);
 	uint32_t ret_addr_mid = high32(ret_addr);
@@ -198,41 +234,33 @@ static int noc_dma_transfer(uint32_t cmd, uint32_t ret_coord, uint64_t ret_addr,
 
 	/* Always enable response marking for completion tracking */
 	noc_ctrl |= NOC_CMD_RESP_MARKED;
-	uint32_t expected_acks = get_expected_acks(noc_ctrl, size);
 
-	/* Return tracking info to caller */
-	if (noc_cmd_out) {
-		*noc_cmd_out = noc_ctrl;
-	}
-	if (expected_acks_out) {
-		*expected_acks_out = expected_acks;
-	}
-
-	if (!noc_wait_cmd_ready()) {
+	/* Only the command registers need to be free, earlier commands can still be in flight */
+	if (!noc_wait_cmd_ready(tlb)) {
 		LOG_ERR("Waiting for transfer command timed out");
 		return -ETIMEDOUT;
 	}
 
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, TARGET_ADDR_LO, targ_addr_lo);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, TARGET_ADDR_MID, targ_addr_mid);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, TARGET_ADDR_HI, targ_addr_hi);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, RET_ADDR_LO, ret_addr_lo);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, RET_ADDR_MID, ret_addr_mid);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, RET_ADDR_HI, ret_addr_hi);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, PACKET_TAG, noc_packet_tag);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, AT_LEN, noc_at_len_be);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, AT_LEN_1, 0);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, AT_DATA, 0);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, BRCST_EXCLUDE, 0);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, CMD_BRCST, noc_ctrl);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, CMD_CTRL, 1);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, TARGET_ADDR_LO, targ_addr_lo);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, TARGET_ADDR_MID, targ_addr_mid);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, TARGET_ADDR_HI, targ_addr_hi);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, RET_ADDR_LO, ret_addr_lo);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, RET_ADDR_MID, ret_addr_mid);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, RET_ADDR_HI, ret_addr_hi);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, PACKET_TAG, noc_packet_tag);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, AT_LEN, noc_at_len_be);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, AT_LEN_1, 0);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, AT_DATA, 0);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, BRCST_EXCLUDE, 0);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, CMD_BRCST, noc_ctrl);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, CMD_CTRL, 1);
 
 	return 0;
 }
 
 /*
- * Config the source and dest NOC coordinates, the source and dest addresses and
- * the size of data transfer.
+ * Config the source and dest NOC coordinates, and the chain of blocks to transfer. The chain may
+ * be of any length, and must stay valid until the transfer has completed.
  */
 static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 				struct dma_config *config)
@@ -241,42 +269,38 @@ static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 	const struct tt_bh_dma_noc_config *dma_cfg =
 		(const struct tt_bh_dma_noc_config *)dev->config;
 
-	if (config->block_count == 0) {
+	if (config->block_count == 0 || config->head_block == NULL) {
 		LOG_ERR("No block configuration provided");
 		return -EINVAL;
 	}
-	if (config->block_count > DMA_MAX_TRANSFER_BLOCKS) {
-		LOG_ERR("Too many blocks: %u > %u", config->block_count, DMA_MAX_TRANSFER_BLOCKS);
-		return -EINVAL;
-	}
-	if (channel > dma_cfg->num_channels) {
+	if (channel >= dma_cfg->num_channels) {
 		LOG_ERR("Invalid channel %u", channel);
 		return -EINVAL;
 	}
 
-	struct tt_bh_dma_channel_data *chan_data = &dma_cfg->channels[channel];
+	struct dma_block_config *block = config->head_block;
 
-	k_spinlock_key_t key = k_spin_lock(&dma_data->lock);
+	for (uint32_t i = 1; i < config->block_count; i++) {
+		block = block->next_block;
+		if (block == NULL) {
+			LOG_ERR("Chain ends before block %u of %u", i, config->block_count);
+			return -EINVAL;
+		}
+	}
 
-	/* Deep copy all blocks from the linked list */
-	struct dma_block_config *src_block = config->head_block;
+	struct tt_bh_dma_channel_data *chan_data = &dma_cfg->channels[channel];
 
-	for (int i = 0; i < config->block_count && src_block != NULL; i++) {
-		chan_data->blocks[i] = *src_block;
-		/* Clear the next_block pointer since we're storing in an array */
-		chan_data->blocks[i].next_block = NULL;
+	k_spinlock_key_t key = k_spin_lock(&dma_data->lock);
 
-		src_block = src_block->next_block;
+	if (chan_data->state.busy) {
+		k_spin_unlock(&dma_data->lock, key);
+		return -EBUSY;
 	}
 
 	chan_data->state.block_index = 0;
 	chan_data->state.block_count = config->block_count;
 	chan_data->config = *config;
-	/* Update the config to point to our copied blocks */
-	chan_data->config.head_block = &chan_data->blocks[0];
 	chan_data->state.configured = true;
-	chan_data->state.last_noc_cmd = 0;
-	chan_data->state.last_expected_acks = 0;
 
 	if (config->user_data) {
 		chan_data->coords = *(struct tt_bh_dma_noc_coords *)config->user_data;
@@ -291,72 +315,283 @@ static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 	return 0;
 }
 
-static int noc_dma_write_multicast(uint8_t local_x, uint8_t local_y, uint64_t local_addr,
-				   uint8_t remote_start_x, uint8_t remote_start_y,
-				   uint8_t remote_end_x, uint8_t remote_end_y, uint64_t remote_addr,
-				   uint32_t size, bool include_self, uint32_t *noc_cmd_out,
-				   uint32_t *expected_acks_out)
+/* Issue one block of a channel to the NIU of its tile, see tt_bh_dma_noc_start() */
+static int noc_dma_issue_block(struct tt_bh_dma_channel_data *chan_data, uint32_t channel,
+			       const struct dma_block_config *block)
 {
-	uint32_t ret_coord =
-		noc_coord_encode_range(remote_start_x, remote_start_y, remote_end_x, remote_end_y);
-	uint64_t ret_addr = remote_addr;
+	struct tt_bh_dma_channel_resettable_data *state = &chan_data->state;
+	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
 
-	uint32_t targ_coord = noc_coord_encode(local_x, local_y);
-	uint64_t targ_addr = local_addr;
+	switch ((uint32_t)chan_data->config.channel_direction) {
+	case MEMORY_TO_PERIPHERAL:
+		return noc_dma_transfer(state->tlb, NOC_CMD_RD,
+					noc_coord_encode(coords->source_x, coords->source_y),
+					block->source_address,
+					noc_coord_encode(coords->dest_x, coords->dest_y),
+					block->dest_address, block->block_size, false, channel,
+					false);
+	case PERIPHERAL_TO_MEMORY:
+		return noc_dma_transfer(state->tlb, NOC_CMD_WR,
+					noc_coord_encode(coords->dest_x, coords->dest_y),
+					block->dest_address,
+					noc_coord_encode(coords->source_x, coords->source_y),
+					block->source_address, block->block_size, false, channel,
+					false);
+	case TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER: {
+		const struct tt_bh_dma_noc_scatter_block *scatter =
+			CONTAINER_OF(block, struct tt_bh_dma_noc_scatter_block, block);
+
+		return noc_dma_transfer(state->tlb, NOC_CMD_WR,
+					noc_coord_encode(scatter->dest_x, scatter->dest_y),
+					block->dest_address,
+					noc_coord_encode(coords->source_x, coords->source_y),
+					block->source_address, block->block_size, false, channel,
+					false);
+	}
+	case TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST: {
+		/* Use pre translation coords as NOC translation has enabled. */
+		uint8_t remote_start_x = 2;
+		uint8_t remote_start_y = 2;
+		uint8_t remote_end_x = 1;
+		uint8_t remote_end_y = 11;
+
+		return noc_dma_transfer(state->tlb, NOC_CMD_WR,
+					noc_coord_encode_range(remote_start_x, remote_start_y,
+							       remote_end_x, remote_end_y),
+					block->dest_address,
+					noc_coord_encode(coords->dest_x, coords->dest_y),
+					block->source_address, block->block_size, true, channel,
+					false);
+	}
+	default:
+		return -EINVAL;
+	}
+}
 
-	NOC2AXITlbSetup(NOC_DMA_NOC_ID, NOC_DMA_TLB, local_x, local_y, TARGET_ADDR_LO);
+/*
+ * Issue every block of the chain back to back. Each waits only for the command registers, so
+ * the NIU always has the next block queued while the previous ones are in flight. The blocks of a
+ * chain land in order, so only the ack count of the next block to land and of the whole chain are
+ * kept. Must be called with the issue lock held, so no other command can interleave.
+ */
+static int noc_dma_issue_chain(const struct device *dev, uint32_t channel)
+{
+	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
+	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
+	struct tt_bh_dma_channel_resettable_data *state = &chan_data->state;
+	const struct dma_block_config *block = chan_data->config.head_block;
+	uint32_t pending_length = 0;
+	uint32_t acks;
+	int ret = 0;
+
+	K_SPINLOCK(&data->lock) {
+		acks = noc_dma_ack_base(cfg, state->tlb, state->niu_x, state->niu_y,
+					state->ack_reg);
+		state->landing = block;
+		state->landing_ack = acks + noc_dma_bursts(block);
+	}
+
+	for (uint32_t i = 0; i < state->block_count; i++, block = block->next_block) {
+		ret = noc_dma_issue_block(chan_data, channel, block);
+		if (ret != 0) {
+			break;
+		}
+		acks += noc_dma_bursts(block);
+		pending_length += block->block_size;
+	}
+
+	K_SPINLOCK(&data->lock) {
+		state->end_ack = acks;
+		state->pending_length = pending_length;
+		state->issued = true;
+	}
+
+	return ret;
+}
 
-	return noc_dma_transfer(NOC_CMD_WR, ret_coord, ret_addr, targ_coord, targ_addr, size, true,
-				0, include_self, noc_cmd_out, expected_acks_out);
+/* Spin until the ack counter of a tile reaches a value, for the blocking copy */
+static int noc_dma_wait_acks(uint8_t tlb, uint32_t ack_reg, uint32_t expected)
+{
+	k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+
+	while (is_behind(NOC2AXIRead32(NOC_DMA_NOC_ID, tlb, ack_reg), expected)) {
+		if (sys_timepoint_expired(timeout)) {
+			return -ETIMEDOUT;
+		}
+		k_busy_wait(1);
+	}
+
+	return 0;
 }
 
-static int tt_bh_dma_noc_start_mem_to_per(const struct device *dev, uint32_t channel)
+/*
+ * Copy within the destination tile by bouncing each block through address 0 of the source tile.
+ * The write depends on the read, so this waits for each command to land before returning.
+ */
+static int noc_dma_copy(const struct device *dev, uint32_t channel)
 {
 	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
 	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
 	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
-	struct dma_block_config *current_block = &chan_data->blocks[chan_data->state.block_index];
+	uint32_t source_coord = noc_coord_encode(coords->source_x, coords->source_y);
+	uint32_t dest_coord = noc_coord_encode(coords->dest_x, coords->dest_y);
+	uint8_t tlb;
+	int ret = 0;
 
-	uint32_t ret_coord = noc_coord_encode(coords->source_x, coords->source_y);
-	uint64_t ret_addr = current_block->source_address;
+	tlb = NOC2AXITlbAcquire(NOC_DMA_NOC_ID, coords->source_x, coords->source_y, TARGET_ADDR_LO);
 
-	uint32_t targ_coord = noc_coord_encode(coords->dest_x, coords->dest_y);
-	uint64_t targ_addr = current_block->dest_address;
+	struct dma_block_config *block = chan_data->config.head_block;
 
-	NOC2AXITlbSetup(NOC_DMA_NOC_ID, NOC_DMA_TLB, coords->source_x, coords->source_y,
-			TARGET_ADDR_LO);
+	for (uint32_t i = 0; i < chan_data->state.block_count; i++, block = block->next_block) {
+		uint32_t expected;
 
-	return noc_dma_transfer(NOC_CMD_RD, ret_coord, ret_addr, targ_coord, targ_addr,
-				current_block->block_size, false, 0, false,
-				&chan_data->state.last_noc_cmd,
-				&chan_data->state.last_expected_acks);
+		K_SPINLOCK(&data->lock) {
+			expected = noc_dma_ack_base(cfg, tlb, coords->source_x, coords->source_y,
+						    NIU_MST_RD_RESP_RECEIVED) +
+				   noc_dma_bursts(block);
+		}
+		ret = noc_dma_transfer(tlb, NOC_CMD_RD, source_coord, 0, dest_coord,
+				       block->source_address, block->block_size, false, channel,
+				       false);
+		if (ret == 0) {
+			ret = noc_dma_wait_acks(tlb, NIU_MST_RD_RESP_RECEIVED, expected);
+		}
+		if (ret != 0) {
+			break;
+		}
+
+		K_SPINLOCK(&data->lock) {
+			expected = noc_dma_ack_base(cfg, tlb, coords->source_x, coords->source_y,
+						    NIU_MST_WR_ACK_RECEIVED) +
+				   noc_dma_bursts(block);
+		}
+		ret = noc_dma_transfer(tlb, NOC_CMD_WR, dest_coord, block->dest_address,
+				       source_coord, 0, block->block_size, false, channel, false);
+		if (ret == 0) {
+			ret = noc_dma_wait_acks(tlb, NIU_MST_WR_ACK_RECEIVED, expected);
+		}
+		if (ret != 0) {
+			break;
+		}
+
+		/* Invoke callback function at transfer or block completion */
+		handle_transfer_callbacks(dev, &chan_data->config, channel, 0,
+					  i + 1 == chan_data->state.block_count);
+	}
+
+	NOC2AXITlbRelease(NOC_DMA_NOC_ID, tlb);
+
+	if (ret != 0) {
+		handle_transfer_callbacks(dev, &chan_data->config, channel, ret, true);
+	}
+
+	return ret;
 }
 
-static int tt_bh_dma_noc_start_per_to_mem(const struct device *dev, uint32_t channel)
+/*
+ * Retire the blocks of a channel that have landed, and report them through the callback. This
+ * runs from the poll timer, and from get_status() so that a caller polling for completion sees
+ * it without waiting for the timer.
+ */
+static void noc_dma_poll_channel(const struct device *dev, uint32_t channel)
 {
 	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
 	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
-	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
-	struct dma_block_config *current_block = &chan_data->blocks[chan_data->state.block_index];
+	struct tt_bh_dma_channel_resettable_data *state = &chan_data->state;
+	struct dma_config config;
+	uint32_t landed = 0;
+	bool done;
+	bool timed_out;
 
-	uint32_t ret_coord = noc_coord_encode(coords->dest_x, coords->dest_y);
-	uint64_t ret_addr = current_block->dest_address;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
 
-	uint32_t targ_coord = noc_coord_encode(coords->source_x, coords->source_y);
-	uint64_t targ_addr = current_block->source_address;
+	/* Blocks are still being issued, start() picks up where the poll leaves off */
+	if (!state->busy || !state->issued) {
+		k_spin_unlock(&data->lock, key);
+		return;
+	}
 
-	NOC2AXITlbSetup(NOC_DMA_NOC_ID, NOC_DMA_TLB, coords->source_x, coords->source_y,
-			TARGET_ADDR_LO);
+	uint32_t acks = NOC2AXIRead32(NOC_DMA_NOC_ID, state->tlb, state->ack_reg);
 
-	return noc_dma_transfer(NOC_CMD_WR, ret_coord, ret_addr, targ_coord, targ_addr,
-				current_block->block_size, false, 0, false,
-				&chan_data->state.last_noc_cmd,
-				&chan_data->state.last_expected_acks);
+	while (state->landing != NULL && !is_behind(acks, state->landing_ack)) {
+		state->pending_length -= state->landing->block_size;
+		state->block_index++;
+		landed++;
+
+		if (state->block_index < state->block_count) {
+			state->landing = state->landing->next_block;
+			state->landing_ack += noc_dma_bursts(state->landing);
+		} else {
+			state->landing = NULL;
+		}
+	}
+
+	/* A long chain only times out if it stops making progress */
+	if (landed > 0) {
+		state->timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+	}
+
+	done = state->block_index == state->block_count;
+	timed_out = !done && sys_timepoint_expired(state->timeout);
+	if (done || timed_out) {
+		state->busy = false;
+		NOC2AXITlbRelease(NOC_DMA_NOC_ID, state->tlb);
+	}
+
+	/* The channel can be reconfigured as soon as the lock is dropped */
+	config = chan_data->config;
+
+	k_spin_unlock(&data->lock, key);
+
+	if (timed_out) {
+		LOG_ERR("Channel %u timed out with %u of %u blocks done", channel,
+			state->block_index, state->block_count);
+		handle_transfer_callbacks(dev, &config, channel, -ETIMEDOUT, true);
+		return;
+	}
+
+	for (uint32_t i = 0; i < landed; i++) {
+		handle_transfer_callbacks(dev, &config, channel, 0, done && i + 1 == landed);
+	}
 }
 
+static void noc_dma_poll_timer_handler(struct k_timer *timer)
+{
+	const struct device *dev = k_timer_user_data_get(timer);
+	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
+	bool busy = false;
+
+	for (uint32_t channel = 0; channel < cfg->num_channels; channel++) {
+		noc_dma_poll_channel(dev, channel);
+	}
+
+	K_SPINLOCK(&data->lock) {
+		for (uint32_t channel = 0; channel < cfg->num_channels; channel++) {
+			busy |= cfg->channels[channel].state.busy;
+		}
+
+		if (!busy) {
+			k_timer_stop(timer);
+			data->polling = false;
+		}
+	}
+}
+
+/*
+ * Issue every block of a channel and return without waiting for them to land. Completion is
+ * reported through the DMA callback, and by get_status(). Channels that run from different tiles,
+ * or from the same one, are in flight at the same time. A scatter chain writes each block to its
+ * own tile, so one chain covers what would otherwise take a transfer per tile. A memory to memory
+ * copy still blocks, because each write depends on the read before it.
+ */
 static int tt_bh_dma_noc_start(const struct device *dev, uint32_t channel)
 {
 	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
 
 	if (channel >= cfg->num_channels) {
 		LOG_ERR("Invalid channel %u", channel);
@@ -364,134 +599,116 @@ static int tt_bh_dma_noc_start(const struct device *dev, uint32_t channel)
 	}
 
 	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
+	struct tt_bh_dma_channel_resettable_data *state = &chan_data->state;
+	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
 
-	if (!chan_data->state.configured) {
+	if (!state->configured) {
 		LOG_ERR("Channel %u not configured", channel);
 		return -EINVAL;
 	}
 
-	chan_data->state.block_index = 0;
-
-	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
-	struct dma_block_config *current_block = &chan_data->blocks[chan_data->state.block_index];
-
-	if (!current_block) {
-		LOG_ERR("No valid block configuration");
+	uint8_t niu_x = coords->source_x;
+	uint8_t niu_y = coords->source_y;
+	uint32_t ack_reg = NIU_MST_WR_ACK_RECEIVED;
+
+	switch ((uint32_t)chan_data->config.channel_direction) {
+	case MEMORY_TO_MEMORY:
+		break;
+	case MEMORY_TO_PERIPHERAL:
+		ack_reg = NIU_MST_RD_RESP_RECEIVED;
+		break;
+	case PERIPHERAL_TO_MEMORY:
+	case TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER:
+		break;
+	case TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST:
+		niu_x = coords->dest_x;
+		niu_y = coords->dest_y;
+		break;
+	default:
+		LOG_ERR("Invalid channel direction %d", chan_data->config.channel_direction);
 		return -EINVAL;
 	}
 
-	int ret;
-
-	/* Handle different transfer types - all asynchronous except for MEMORY to MEMORY */
-	for (; chan_data->state.block_index < chan_data->state.block_count;
-	     chan_data->state.block_index++) {
-		current_block = &chan_data->blocks[chan_data->state.block_index];
-		if (!current_block) {
-			LOG_ERR("No valid block configuration");
-			return -EINVAL;
-		}
+	int ret = 0;
 
-		switch (chan_data->config.channel_direction) {
-		case MEMORY_TO_MEMORY: {
-			int dest_address_ = current_block->dest_address;
+	k_mutex_lock(&data->issue_lock, K_FOREVER);
 
-			current_block->dest_address = current_block->source_address;
-			current_block->source_address = 0;
-
-			ret = tt_bh_dma_noc_start_mem_to_per(dev, channel);
-			if (ret != 0) {
-				return ret;
-			}
-
-			current_block->dest_address = dest_address_;
+	if (state->busy) {
+		k_mutex_unlock(&data->issue_lock);
+		return -EBUSY;
+	}
 
-			/* Wait for read operation to complete */
-			k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
-			struct dma_status status;
+	if (chan_data->config.channel_direction == MEMORY_TO_MEMORY) {
+		ret = noc_dma_copy(dev, channel);
+		k_mutex_unlock(&data->issue_lock);
 
-			do {
-				dma_get_status(dev, channel, &status);
-			} while (status.busy && !sys_timepoint_expired(timeout));
+		if (ret == 0 && chan_data->config.linked_channel != DMA_CHANNEL_INVALID) {
+			uint32_t linked_chan = chan_data->config.linked_channel;
 
-			if (sys_timepoint_expired(timeout)) {
-				return -ETIMEDOUT;
+			if (linked_chan < cfg->num_channels &&
+			    cfg->channels[linked_chan].state.configured &&
+			    (chan_data->config.dest_chaining_en ||
+			     chan_data->config.source_chaining_en)) {
+				tt_bh_dma_noc_start(dev, linked_chan);
 			}
+		}
 
-			ret = tt_bh_dma_noc_start_per_to_mem(dev, channel);
-			if (ret != 0) {
-				return ret;
-			}
+		return ret;
+	}
 
-			/* Wait for write operation to complete */
-			timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+	uint8_t tlb = NOC2AXITlbAcquire(NOC_DMA_NOC_ID, niu_x, niu_y, TARGET_ADDR_LO);
 
-			do {
-				dma_get_status(dev, channel, &status);
-			} while (status.busy && !sys_timepoint_expired(timeout));
+	K_SPINLOCK(&data->lock) {
+		state->block_index = 0;
+		state->issued = false;
+		state->niu_x = niu_x;
+		state->niu_y = niu_y;
+		state->ack_reg = ack_reg;
+		state->tlb = tlb;
+		state->busy = true;
+	}
 
-			if (sys_timepoint_expired(timeout)) {
-				return -ETIMEDOUT;
+	ret = noc_dma_issue_chain(dev, channel);
+
+	K_SPINLOCK(&data->lock) {
+		if (ret != 0) {
+			state->busy = false;
+			NOC2AXITlbRelease(NOC_DMA_NOC_ID, tlb);
+		} else {
+			state->timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+			if (!data->polling) {
+				k_timer_start(&data->poll_timer,
+					      K_USEC(CONFIG_DMA_TT_BH_NOC_POLL_INTERVAL_US),
+					      K_USEC(CONFIG_DMA_TT_BH_NOC_POLL_INTERVAL_US));
+				data->polling = true;
 			}
-
-			/* Invoke callback function at transfer or block completion */
-			handle_transfer_callbacks(dev, chan_data, channel, 0,
-						  chan_data->state.block_index + 1 ==
-							  chan_data->state.block_count);
-
-			break;
 		}
-		case MEMORY_TO_PERIPHERAL: {
-			return tt_bh_dma_noc_start_mem_to_per(dev, channel);
-		}
-		case PERIPHERAL_TO_MEMORY: {
-			return tt_bh_dma_noc_start_per_to_mem(dev, channel);
-		}
-		case TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST: {
-			/* Use pre translation coords as NOC translation has enabled. */
-			uint8_t remote_start_x = 2;
-			uint8_t remote_start_y = 2;
-			uint8_t remote_end_x = 1;
-			uint8_t remote_end_y = 11;
-			uint64_t local_addr = current_block->source_address;
-			uint64_t remote_addr = current_block->dest_address;
-
-			ret = noc_dma_write_multicast(
-				coords->dest_x, coords->dest_y, local_addr, remote_start_x,
-				remote_start_y, remote_end_x, remote_end_y, remote_addr,
-				current_block->block_size, false, &chan_data->state.last_noc_cmd,
-				&chan_data->state.last_expected_acks);
+	}
 
-			return ret;
-		}
-		default:
-			LOG_ERR("Invalid channel direction %d",
-				chan_data->config.channel_direction);
-			return -EINVAL;
-		}
+	k_mutex_unlock(&data->issue_lock);
 
-		if (chan_data->config.linked_channel != DMA_CHANNEL_INVALID) {
-			uint32_t linked_chan = chan_data->config.linked_channel;
-			if (linked_chan < cfg->num_channels &&
-			    cfg->channels[linked_chan].state.configured) {
-				if (chan_data->config.dest_chaining_en ||
-				    chan_data->config.source_chaining_en) {
-					tt_bh_dma_noc_start(dev, linked_chan);
-				}
-			}
-		}
+	if (ret != 0) {
+		handle_transfer_callbacks(dev, &chan_data->config, channel, ret, true);
 	}
 
-	return 0;
+	return ret;
 }
 
 static int tt_bh_dma_noc_init(const struct device *dev)
 {
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
+
+	k_mutex_init(&data->issue_lock);
+	k_timer_init(&data->poll_timer, noc_dma_poll_timer_handler, NULL);
+	k_timer_user_data_set(&data->poll_timer, (void *)dev);
+
 	return 0;
 }
 
 static int tt_bh_dma_noc_get_status(const struct device *dev, uint32_t channel,
 				    struct dma_status *status)
 {
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
 	const struct tt_bh_dma_noc_config *dma_cfg =
 		(const struct tt_bh_dma_noc_config *)dev->config;
 
@@ -501,21 +718,67 @@ static int tt_bh_dma_noc_get_status(const struct device *dev, uint32_t channel,
 
 	struct tt_bh_dma_channel_data *chan_data = &dma_cfg->channels[channel];
 
-	uint32_t ack_reg_addr = (chan_data->state.last_noc_cmd & NOC_CMD_WR)
-					? NIU_MST_WR_ACK_RECEIVED
-					: NIU_MST_RD_RESP_RECEIVED;
-	uint32_t ack_received = NOC2AXIRead32(NOC_DMA_NOC_ID, NOC_DMA_TLB, ack_reg_addr);
+	noc_dma_poll_channel(dev, channel);
 
-	status->busy = is_behind(ack_received, chan_data->state.last_expected_acks);
+	memset(status, 0, sizeof(*status));
+
+	K_SPINLOCK(&data->lock) {
+		status->busy = chan_data->state.busy;
+		status->dir = chan_data->config.channel_direction;
+		if (status->busy) {
+			status->pending_length = chan_data->state.pending_length;
+		}
+	}
 
 	return 0;
 }
 
+/*
+ * Stop tracking a channel. Commands already issued to the NIU cannot be recalled, so they still
+ * land, but no callback is made for them.
+ */
 static int tt_bh_dma_noc_stop(const struct device *dev, uint32_t channel)
 {
+	struct tt_bh_dma_noc_data *data = (struct tt_bh_dma_noc_data *)dev->data;
+	const struct tt_bh_dma_noc_config *dma_cfg =
+		(const struct tt_bh_dma_noc_config *)dev->config;
+
+	if (channel >= dma_cfg->num_channels) {
+		return -EINVAL;
+	}
+
+	struct tt_bh_dma_channel_resettable_data *state = &dma_cfg->channels[channel].state;
+
+	K_SPINLOCK(&data->lock) {
+		if (state->busy && state->issued) {
+			state->busy = false;
+			NOC2AXITlbRelease(NOC_DMA_NOC_ID, state->tlb);
+		}
+	}
+
 	return 0;
 }
 
+int tt_bh_dma_noc_wait(const struct device *dev, uint32_t channel, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct dma_status status;
+
+	do {
+		int ret = tt_bh_dma_noc_get_status(dev, channel, &status);
+
+		if (ret != 0) {
+			return ret;
+		}
+		if (!status.busy) {
+			return 0;
+		}
+		k_busy_wait(1);
+	} while (!sys_timepoint_expired(end));
+
+	return -ETIMEDOUT;
+}
+
 static const struct dma_driver_api tt_bh_dma_noc_api = {
 	.config = tt_bh_dma_noc_config,
 	.reload = NULL,
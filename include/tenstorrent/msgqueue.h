@@ -11,8 +11,8 @@
 
 #include <zephyr/sys/iterable_sections.h>
 
-#define NUM_MSG_QUEUES         4
-#define MSG_QUEUE_SIZE         4
+#define NUM_MSG_QUEUES         CONFIG_TT_BH_ARC_NUM_MSG_QUEUES
+#define MSG_QUEUE_SIZE         CONFIG_TT_BH_ARC_MSG_QUEUE_SIZE
 #define MSG_QUEUE_POINTER_WRAP (2 * MSG_QUEUE_SIZE)
 #define REQUEST_MSG_LEN        8
 #define RESPONSE_MSG_LEN       8
@@ -331,6 +331,173 @@ struct test_rqst {
 	uint32_t test_value;
 };
 
+/** @brief Host request to read message handler statistics
+ * @details Messages of this type are processed by @ref get_msg_stats_handler. The response
+ * contains the call count in data[1], the worst-case execution time in microseconds in data[2],
+ * the number of histogram buckets in the low byte of data[3] and up to eight 16-bit histogram
+ * buckets, starting at @ref first_bucket, packed into data[4] to data[7].
+ */
+struct get_msg_stats_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_GET_MSG_STATS */
+	uint8_t command_code;
+
+	/** @brief Set to 1 to clear the statistics of @ref msg_code after reading them */
+	uint8_t clear: 1;
+
+	/** @brief Index of the first histogram bucket to return */
+	uint8_t first_bucket;
+
+	/** @brief One byte of padding */
+	uint8_t pad;
+
+	/** @brief The message code to report statistics for */
+	uint32_t msg_code;
+};
+
+/** @brief Host request to summarize the telemetry history
+ * @details Messages of this type are processed by @ref get_telem_history_handler. The response
+ * contains the minimum in data[1], the maximum in data[2] and the average in data[3] of the
+ * most recent samples of @ref channel, the number of samples summarized in data[4], the address
+ * of the history ring in data[5] and the total number of samples recorded in data[6].
+ */
+struct get_telem_history_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_GET_TELEM_HISTORY */
+	uint8_t command_code;
+
+	/** @brief The history channel: 0 VCORE, 1 TDP, 2 TDC, 3 AICLK, 4 ASIC temperature */
+	uint8_t channel;
+
+	/** @brief Number of most recent samples to summarize, 0 for the whole history */
+	uint16_t num_samples;
+};
+
+/** @brief Host request to read the throttling statistics of one AICLK max arbiter
+ * @details Messages of this type are processed by @ref get_aiclk_limit_stats_handler. An arbiter
+ * is limiting while it holds AICLK below the frequency requested by the busy/idle state. The
+ * response contains the total time in milliseconds the arbiter has been limiting in data[1], the
+ * number of times it started limiting in data[2], the uptime in milliseconds when it last started
+ * limiting in data[3], the current uptime in data[4], 1 if it is limiting now in data[5], 1 if it
+ * is enabled in data[6] and its current frequency in MHz in data[7]. The min arbiters only raise
+ * AICLK, so they never limit it and have no statistics.
+ */
+struct get_aiclk_limit_stats_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_GET_AICLK_LIMIT_STATS */
+	uint8_t command_code;
+
+	/** @brief The arbiter: 0 fmax, 1 TDP, 2 fast TDC, 3 TDC, 4 thermal, 5 board power,
+	 * 6 voltage, 7 GDDR thermal, 8 Doppler slow, 9 Doppler critical
+	 */
+	uint8_t arbiter;
+
+	/** @brief Two bytes of padding */
+	uint8_t pad[2];
+};
+
+/** @brief Host request to set the DVFS period
+ * @details Messages of this type are processed by @ref set_dvfs_period_handler. The response
+ * contains the period now in use in microseconds in data[1], and the shortest and longest
+ * periods allowed in data[2] and data[3].
+ */
+struct set_dvfs_period_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_SET_DVFS_PERIOD */
+	uint8_t command_code;
+
+	/** @brief Three bytes of padding */
+	uint8_t pad[3];
+
+	/** @brief The period to pin DVFS to in microseconds, or 0 to adapt it to the load */
+	uint32_t period_us;
+};
+
+/** @brief Host request to start a PCIe DMA transfer
+ * @details Requests of this type are processed by @ref pcie_dma_transfer_handler. A transfer
+ * starts on an idle HDMA channel of its direction, or is queued until one becomes idle. The
+ * request is rejected with a nonzero status only if that queue is full. Completion is signalled by
+ * the HDMA writing @ref completion_data to the MSI completion address.
+ */
+struct pcie_dma_transfer_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_PCIE_DMA_CHIP_TO_HOST_TRANSFER
+	 * or @ref TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER
+	 */
+	uint8_t command_code;
+
+	/** @brief The MSI data written on completion */
+	uint8_t completion_data;
+
+	/** @brief 1 - chip_addr is the chip address of a list of HDMA linked-list elements, which
+	 * describe the segments of the transfer. host_addr and transfer_size_bytes are ignored.
+	 * <br> 0 - A single segment of transfer_size_bytes between chip_addr and host_addr
+	 */
+	uint8_t linked_list: 1;
+
+	/** @brief Reserved */
+	uint8_t reserved: 7;
+
+	/** @brief One byte of padding */
+	uint8_t pad;
+
+	/** @brief The size of the transfer in bytes */
+	uint32_t transfer_size_bytes;
+
+	/** @brief The lower 32 bits of the chip address */
+	uint32_t chip_addr_lo;
+
+	/** @brief The upper 32 bits of the chip address */
+	uint32_t chip_addr_hi;
+
+	/** @brief The lower 32 bits of the host address */
+	uint32_t host_addr_lo;
+
+	/** @brief The upper 32 bits of the host address */
+	uint32_t host_addr_hi;
+
+	/** @brief The lower 32 bits of the MSI completion address. The HDMA writes to the next
+	 * word instead if the transfer aborts.
+	 */
+	uint32_t msi_completion_addr_lo;
+
+	/** @brief The upper 32 bits of the MSI completion address */
+	uint32_t msi_completion_addr_hi;
+};
+
+/** @brief Host request to benchmark a DMA engine
+ * @details Runs @ref iterations copies of @ref transfer_size bytes one after another. The
+ * response is deferred until the run ends. It holds the throughput in MB/s in data[1], the run
+ * time and the CPU time in microseconds in data[2] and data[3], and the 50th, 90th and 99th
+ * percentile and the maximum transfer latency in nanoseconds in data[4] to data[7].
+ */
+struct dma_bench_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_DMA_BENCH */
+	uint8_t command_code;
+
+	/** @brief 0 - ARC HS DMA, between two buffers in ARC memory <br>
+	 * 1 - NOC DMA, within the L1 of the first enabled Tensix <br>
+	 * 2 - PCIe HDMA, host to chip <br>
+	 * 3 - PCIe HDMA, chip to host
+	 */
+	uint8_t engine;
+
+	/** @brief Number of copies, at most CONFIG_TT_BH_ARC_DMA_BENCH_MAX_ITERATIONS */
+	uint16_t iterations;
+
+	/** @brief The size of each copy in bytes */
+	uint32_t transfer_size;
+
+	/** @brief The lower 32 bits of the chip address. For the NOC DMA, the L1 address copied
+	 * from, the copy is written right after it. For the PCIe HDMA, the chip side of the copy.
+	 */
+	uint32_t chip_addr_lo;
+
+	/** @brief The upper 32 bits of the chip address */
+	uint32_t chip_addr_hi;
+
+	/** @brief The lower 32 bits of the host address, the host side of PCIe HDMA copies */
+	uint32_t host_addr_lo;
+
+	/** @brief The upper 32 bits of the host address */
+	uint32_t host_addr_hi;
+};
+
 /** @brief A tenstorrent host request*/
 union request {
 	/** @brief The interpretation of the request as an array of uint32_t entries*/
@@ -385,6 +552,24 @@ union request {
 
 	/** @brief A test request */
 	struct test_rqst test;
+
+	/** @brief A get message handler statistics request */
+	struct get_msg_stats_rqst get_msg_stats;
+
+	/** @brief A get telemetry history request */
+	struct get_telem_history_rqst get_telem_history;
+
+	/** @brief A get AICLK throttling statistics request */
+	struct get_aiclk_limit_stats_rqst get_aiclk_limit_stats;
+
+	/** @brief A set DVFS period request */
+	struct set_dvfs_period_rqst set_dvfs_period;
+
+	/** @brief A PCIe DMA transfer request */
+	struct pcie_dma_transfer_rqst pcie_dma_transfer;
+
+	/** @brief A DMA benchmark request */
+	struct dma_bench_rqst dma_bench;
 };
 
 /** @} */
@@ -395,6 +580,21 @@ struct response {
 
 typedef uint8_t (*msgqueue_request_handler_t)(const union request *req, struct response *rsp);
 
+struct k_work;
+
+/**
+ * @brief Handle to a message whose response has been deferred
+ *
+ * @details A handler that cannot complete quickly calls @ref msgqueue_defer_response, hands the
+ * remaining work to another context (for example with @ref msgqueue_submit_deferred_work) and
+ * returns immediately. Its return value and response are discarded. The message queue it came
+ * from is not serviced again until the response is posted with
+ * @ref msgqueue_complete_deferred_response, while all other queues continue to be serviced.
+ */
+struct msgqueue_deferred_response {
+	uint32_t msgqueue_id;
+};
+
 struct msgqueue_handler {
 	uint32_t msg_type;
 	msgqueue_request_handler_t handler;
@@ -406,6 +606,18 @@ struct msgqueue_handler {
 		.handler = func,                                                                   \
 	}
 
+/** @brief Execution statistics of a single message code handler */
+struct msgqueue_msg_stats {
+	/** @brief Number of times the handler has run */
+	uint32_t count;
+
+	/** @brief Worst-case handler execution time in microseconds */
+	uint32_t max_us;
+
+	/** @brief Saturating log2 histogram of handler execution time in microseconds */
+	uint16_t hist[CONFIG_TT_BH_ARC_MSG_STATS_NUM_BUCKETS];
+};
+
 void process_message_queues(void);
 void msgqueue_register_handler(uint32_t msg_code, msgqueue_request_handler_t handler);
 
@@ -414,6 +626,12 @@ int msgqueue_request_pop(uint32_t msgqueue_id, union request *request);
 int msgqueue_response_push(uint32_t msgqueue_id, const struct response *response);
 int msgqueue_response_pop(uint32_t msgqueue_id, struct response *response);
 void init_msgqueue(void);
+int msgqueue_defer_response(struct msgqueue_deferred_response *deferred);
+int msgqueue_complete_deferred_response(const struct msgqueue_deferred_response *deferred,
+					uint8_t exit_code, const struct response *response);
+int msgqueue_submit_deferred_work(struct k_work *work);
+int msgqueue_get_msg_stats(uint32_t msg_code, struct msgqueue_msg_stats *stats);
+void msgqueue_clear_msg_stats(uint32_t msg_code);
 
 #ifdef __cplusplus
 }
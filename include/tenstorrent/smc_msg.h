@@ -132,6 +132,16 @@ enum tt_smc_msg {
 	TT_SMC_MSG_CONFIRM_FLASHED_SPI = 0xC4,
 	/** @brief Toggle red blinky on the board */
 	TT_SMC_MSG_BLINKY = 0xC5,
+	/** @brief @ref get_msg_stats_rqst "Get message handler statistics request" */
+	TT_SMC_MSG_GET_MSG_STATS = 0xC6,
+	/** @brief @ref get_telem_history_rqst "Get telemetry history request" */
+	TT_SMC_MSG_GET_TELEM_HISTORY = 0xC7,
+	/** @brief @ref get_aiclk_limit_stats_rqst "Get AICLK throttling statistics request" */
+	TT_SMC_MSG_GET_AICLK_LIMIT_STATS = 0xC8,
+	/** @brief @ref set_dvfs_period_rqst "Set DVFS period request" */
+	TT_SMC_MSG_SET_DVFS_PERIOD = 0xC9,
+	/** @brief @ref dma_bench_rqst "DMA benchmark request" */
+	TT_SMC_MSG_DMA_BENCH = 0xCA,
 };
 
 /** @} */
@@ -17,5 +17,8 @@ int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t i
 			  int (*cb)(uint8_t *src, uint8_t *dst, size_t len));
 int spi_arc_dma_transfer_to_tile(const struct device *dev, size_t spi_address, size_t image_size,
 				 uint8_t *buf, size_t buf_size, uint8_t *tlb_dst);
+int spi_arc_dma_transfer_to_tiles(const struct device *dev, size_t spi_address, size_t image_size,
+				  uint8_t *buf, size_t buf_size, uint8_t *const *tlb_dsts,
+				  size_t num_dsts);
 
 #endif
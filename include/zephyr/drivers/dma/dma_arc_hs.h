@@ -6,6 +6,13 @@
 
 #include <zephyr/drivers/dma.h>
 
+/*
+ * The dma_callback set with dma_config() runs in interrupt context and must not block. It is
+ * called from the channel done ISR when the devicetree node has interrupts, and from the poll
+ * timer expiry otherwise. A dma_get_status() call that finds the transfer complete calls it in
+ * the caller's context instead.
+ */
+
 /**
  * @brief Blocking memory-to-memory transfer using ARC HS DMA
  *
@@ -20,3 +27,47 @@
 
 int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *src, void *dst,
 			size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Blocking multi-block memory-to-memory transfer using ARC HS DMA
+ *
+ * All blocks are queued on the channel as one descriptor chain and the call returns when the
+ * last block has completed, so scattered buffers can be gathered in a single transfer.
+ *
+ * @param dev         DMA device (from DEVICE_DT_GET)
+ * @param channel     DMA channel (0 to N-1)
+ * @param head_block  First block of a list linked through next_block. Each block's source,
+ *                    destination and size are used; addresses must be 4-byte aligned.
+ * @param block_count Number of blocks in the list, at most the number of DMA descriptors
+ * @param timeout     Timeout for the whole transfer
+ * @return 0 on success, negative errno on error
+ */
+int dma_arc_hs_transfer_blocks(const struct device *dev, uint32_t channel,
+			       struct dma_block_config *head_block, uint32_t block_count,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Start a memory-to-memory transfer using ARC HS DMA without waiting for it
+ *
+ * The transfer is split like dma_arc_hs_transfer(). The caller may use the CPU while it runs and
+ * must finish it with dma_arc_hs_transfer_wait() before starting another on the same channel.
+ *
+ * @param dev     DMA device (from DEVICE_DT_GET)
+ * @param channel DMA channel (0 to N-1)
+ * @param src     Source address (4-byte aligned), left untouched until the transfer is waited on
+ * @param dst     Destination address (4-byte aligned)
+ * @param len     Transfer length in bytes, not zero
+ * @return 0 on success, negative errno on error
+ */
+int dma_arc_hs_transfer_start(const struct device *dev, uint32_t channel, const void *src,
+			      void *dst, size_t len);
+
+/**
+ * @brief Wait for a transfer started with dma_arc_hs_transfer_start()
+ *
+ * @param dev     DMA device (from DEVICE_DT_GET)
+ * @param channel DMA channel the transfer was started on
+ * @param timeout Timeout for the transfer to complete
+ * @return 0 on success, negative errno on error
+ */
+int dma_arc_hs_transfer_wait(const struct device *dev, uint32_t channel, k_timeout_t timeout);
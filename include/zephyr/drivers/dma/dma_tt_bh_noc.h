@@ -7,7 +7,9 @@
 #include <zephyr/drivers/dma.h>
 
 enum tt_bh_dma_noc_channel_direction {
-	TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST = DMA_CHANNEL_DIRECTION_PRIV_START
+	TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST = DMA_CHANNEL_DIRECTION_PRIV_START,
+	/* Like PERIPHERAL_TO_MEMORY, with blocks of struct tt_bh_dma_noc_scatter_block */
+	TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER,
 };
 
 struct tt_bh_dma_noc_coords {
@@ -25,3 +27,47 @@ tt_bh_dma_noc_coords_init(uint8_t source_x, uint8_t source_y, uint8_t dest_x, ui
 		.dest_y = dest_y,
 	};
 }
+
+/**
+ * @brief Wait for a NOC DMA channel to finish
+ *
+ * Transfers started with dma_start() complete in the background and are reported through the
+ * DMA callback. This polls the channel instead, for callers that have nothing else to do or
+ * cannot sleep.
+ *
+ * @param dev     DMA device (from DEVICE_DT_GET)
+ * @param channel DMA channel (0 to N-1)
+ * @param timeout How long to wait for the channel to become idle
+ * @return 0 once the channel is idle, -ETIMEDOUT if it is still busy, other negative errno on
+ *         error
+ */
+int tt_bh_dma_noc_wait(const struct device *dev, uint32_t channel, k_timeout_t timeout);
+
+/**
+ * @brief Block of a TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER chain
+ *
+ * Every block is read from the source tile of the channel and written to its own destination
+ * tile, so a single chain can fill many tiles. The chain is linked through block.next_block.
+ */
+struct tt_bh_dma_noc_scatter_block {
+	struct dma_block_config block;
+	uint8_t dest_x, dest_y;
+};
+
+/**
+ * @brief Link an array of scatter blocks into a chain
+ *
+ * @param blocks Blocks to link, in order
+ * @param count  Number of blocks
+ * @return The head block, for dma_config.head_block
+ */
+static inline struct dma_block_config *
+tt_bh_dma_noc_scatter_link(struct tt_bh_dma_noc_scatter_block *blocks, size_t count)
+{
+	for (size_t i = 0; i + 1 < count; i++) {
+		blocks[i].block.next_block = &blocks[i + 1].block;
+	}
+	blocks[count - 1].block.next_block = NULL;
+
+	return &blocks[0].block;
+}
@@ -6,24 +6,40 @@
 
 #include "aiclk_ppm.h"
 #include "dvfs.h"
+#include "fixed_point.h"
 #include "voltage.h"
 #include "vf_curve.h"
 
+#include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <tenstorrent/smc_msg.h>
 #include <tenstorrent/msgqueue.h>
 #include <tenstorrent/sys_init_defines.h>
 #include <zephyr/init.h>
+#include <zephyr/kernel.h>
 #include <zephyr/drivers/misc/bh_fwtable.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/clock_control/clock_control_tt_bh.h>
 #include <zephyr/drivers/clock_control.h>
+#include <zephyr/spinlock.h>
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
 
 static const struct device *const pll_dev_0 = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(pll0));
 
+/* Longest wait for an AICLK slew to finish before the DVFS tick gives up */
+#define AICLK_SETTLE_TIMEOUT_MS 10
+
+static K_SEM_DEFINE(aiclk_settled, 0, 1);
+
 /* Bounds checks for FMAX and FMIN (in MHz) */
 #define AICLK_FMAX_MAX 1400.0F
 #define AICLK_FMAX_MIN 800.0F
@@ -39,7 +55,7 @@ typedef enum {
 
 typedef struct {
 	bool enabled;
-	float value;
+	q16_t value; /* in MHz */
 } AiclkArb;
 
 typedef struct {
@@ -63,14 +79,88 @@ static AiclkPPM aiclk_ppm = {
 
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
 
+/* Throttling statistics of the max arbiters. An arbiter is limiting while it pulls targ_freq
+ * below what the min arbiters ask for; if several tie, the lowest index is charged. The min
+ * arbiters are not tracked: they can only raise targ_freq, so they never throttle AICLK, and
+ * which of them sets the floor follows from the busy/idle state the host already knows.
+ */
+static struct k_spinlock limit_stats_lock;
+static AiclkArbStats limit_stats[kAiclkArbMaxCount];
+static AiclkArbMax limiter = kAiclkArbMaxCount;
+static uint32_t limiter_since_ms;
+
+/* Charge the time since the last update to the previous limiter and switch to the new one */
+static void UpdateLimitStats(AiclkArbMax new_limiter)
+{
+	uint32_t now = k_uptime_get_32();
+	k_spinlock_key_t key = k_spin_lock(&limit_stats_lock);
+
+	if (limiter != kAiclkArbMaxCount) {
+		limit_stats[limiter].time_limited_ms += now - limiter_since_ms;
+	}
+
+	if (new_limiter != limiter && new_limiter != kAiclkArbMaxCount) {
+		limit_stats[new_limiter].entry_count++;
+		limit_stats[new_limiter].last_entry_ms = now;
+	}
+
+	limiter = new_limiter;
+	limiter_since_ms = now;
+
+	k_spin_unlock(&limit_stats_lock, key);
+}
+
+static void ResetLimitStats(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&limit_stats_lock);
+
+	memset(limit_stats, 0, sizeof(limit_stats));
+	limiter = kAiclkArbMaxCount;
+	limiter_since_ms = k_uptime_get_32();
+
+	k_spin_unlock(&limit_stats_lock, key);
+}
+
+/* Includes the time the current limiter has spent limiting since the last DVFS update */
+int GetAiclkArbStats(AiclkArbMax arb_max, AiclkArbStats *stats)
+{
+	if (arb_max >= kAiclkArbMaxCount) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&limit_stats_lock);
+
+	*stats = limit_stats[arb_max];
+	if (arb_max == limiter) {
+		stats->time_limited_ms += k_uptime_get_32() - limiter_since_ms;
+	}
+
+	k_spin_unlock(&limit_stats_lock, key);
+
+	return 0;
+}
+
+/* Returns kAiclkArbMaxCount if no max arbiter is limiting AICLK */
+AiclkArbMax GetAiclkLimiter(void)
+{
+	return limiter;
+}
+
+void SetAiclkArbMaxFixed(AiclkArbMax arb_max, q16_t freq)
+{
+	aiclk_ppm.arbiter_max[arb_max].value =
+		CLAMP(freq, q16_from_int(aiclk_ppm.fmin), q16_from_int(aiclk_ppm.fmax));
+}
+
 void SetAiclkArbMax(AiclkArbMax arb_max, float freq)
 {
-	aiclk_ppm.arbiter_max[arb_max].value = CLAMP(freq, aiclk_ppm.fmin, aiclk_ppm.fmax);
+	SetAiclkArbMaxFixed(arb_max, q16_from_float(CLAMP(freq, aiclk_ppm.fmin, aiclk_ppm.fmax)));
 }
 
 void SetAiclkArbMin(AiclkArbMin arb_min, float freq)
 {
-	aiclk_ppm.arbiter_min[arb_min].value = CLAMP(freq, aiclk_ppm.fmin, aiclk_ppm.fmax);
+	aiclk_ppm.arbiter_min[arb_min].value =
+		q16_from_float(CLAMP(freq, aiclk_ppm.fmin, aiclk_ppm.fmax));
 }
 
 void EnableArbMax(AiclkArbMax arb_max, bool enable)
@@ -90,16 +180,20 @@ void CalculateTargAiclk(void)
 	/* Then limit to the lowest arbiter_max */
 	/* Finally make sure that the target frequency is at least Fmin */
 	uint32_t targ_freq = aiclk_ppm.fmin;
+	AiclkArbMax new_limiter = kAiclkArbMaxCount;
 
 	for (AiclkArbMin i = 0; i < kAiclkArbMinCount; i++) {
 		if (aiclk_ppm.arbiter_min[i].enabled) {
-			targ_freq = MAX(targ_freq, aiclk_ppm.arbiter_min[i].value);
+			targ_freq = MAX(targ_freq, q16_to_int(aiclk_ppm.arbiter_min[i].value));
 		}
 	}
 
 	for (AiclkArbMax i = 0; i < kAiclkArbMaxCount; i++) {
-		if (aiclk_ppm.arbiter_max[i].enabled) {
-			targ_freq = MIN(targ_freq, aiclk_ppm.arbiter_max[i].value);
+		uint32_t arb_freq = q16_to_int(aiclk_ppm.arbiter_max[i].value);
+
+		if (aiclk_ppm.arbiter_max[i].enabled && arb_freq < targ_freq) {
+			targ_freq = arb_freq;
+			new_limiter = i;
 		}
 	}
 
@@ -111,15 +205,52 @@ void CalculateTargAiclk(void)
 	if (aiclk_ppm.sweep_en == 1) {
 		aiclk_ppm.targ_freq = rand() % (aiclk_ppm.sweep_high - aiclk_ppm.sweep_low + 1) +
 				      aiclk_ppm.sweep_low;
+		new_limiter = kAiclkArbMaxCount;
 	}
 
 	/* Apply forced frequency at the end, regardless of any limits */
 	if (aiclk_ppm.forced_freq != 0) {
 		aiclk_ppm.targ_freq = aiclk_ppm.forced_freq;
+		new_limiter = kAiclkArbMaxCount;
+	}
+
+	UpdateLimitStats(new_limiter);
+}
+
+static void AiclkSettled(const struct device *dev, clock_control_subsys_t subsys, void *user_data)
+{
+	k_sem_give(&aiclk_settled);
+}
+
+/* AICLK slews in the background, wait for a slew in progress to reach its target. Returns false
+ * if it did not within AICLK_SETTLE_TIMEOUT_MS.
+ */
+static bool WaitAiclkSettled(void)
+{
+	const clock_control_subsys_t aiclk =
+		(clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK;
+	k_timepoint_t end = sys_timepoint_calc(K_MSEC(AICLK_SETTLE_TIMEOUT_MS));
+
+	/* Drop a completion left behind by a wait that timed out */
+	k_sem_reset(&aiclk_settled);
+
+	if (clock_control_async_on(pll_dev_0, aiclk, AiclkSettled, NULL) == 0) {
+		return k_sem_take(&aiclk_settled, sys_timepoint_timeout(end)) == 0;
+	}
+
+	/* The driver is busy or a callback is already pending, poll the slew instead */
+	while (clock_control_get_status(pll_dev_0, aiclk) == CLOCK_CONTROL_STATUS_STARTING) {
+		if (sys_timepoint_expired(end)) {
+			return false;
+		}
+		k_sleep(K_TICKS(1));
 	}
+
+	return true;
 }
 
-void DecreaseAiclk(void)
+/* Returns false if AICLK did not settle, in which case VCORE must not be lowered */
+bool DecreaseAiclk(void)
 {
 	if (aiclk_ppm.targ_freq < aiclk_ppm.curr_freq) {
 		clock_control_set_rate(pll_dev_0,
@@ -127,11 +258,20 @@ void DecreaseAiclk(void)
 				       (clock_control_subsys_rate_t)aiclk_ppm.targ_freq);
 		aiclk_ppm.curr_freq = aiclk_ppm.targ_freq;
 	}
+
+	/* VCORE may only drop once AICLK is down, and an increase may still be ramping */
+	return WaitAiclkSettled();
 }
 
 void IncreaseAiclk(void)
 {
 	if (aiclk_ppm.targ_freq > aiclk_ppm.curr_freq) {
+		/* VCORE must have reached the voltage the new frequency needs, otherwise the
+		 * increase is left to the next tick. The ramp itself runs in the background.
+		 */
+		if (VoltageWaitSettled() != 0) {
+			return;
+		}
 		clock_control_set_rate(pll_dev_0,
 				       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
 				       (clock_control_subsys_rate_t)aiclk_ppm.targ_freq);
@@ -140,33 +280,34 @@ void IncreaseAiclk(void)
 }
 
 float GetThrottlerArbMax(AiclkArbMax arb_max)
+{
+	return q16_to_float(aiclk_ppm.arbiter_max[arb_max].value);
+}
+
+q16_t GetThrottlerArbMaxFixed(AiclkArbMax arb_max)
 {
 	return aiclk_ppm.arbiter_max[arb_max].value;
 }
 
-/* TODO: Write a Zephyr unit test for this function */
+/* Returns fmin - 1 if even fmin needs more than the voltage */
 uint32_t GetMaxAiclkForVoltage(uint32_t voltage)
 {
-	/* Assume monotonically increasing relationship between frequency and voltage */
-	/* and conduct binary search. */
-	/* Note this function doesn't work if you would need lower than fmin to achieve the voltage
-	 */
+	int32_t freq = VFCurveMaxFreq(voltage);
 
-	/* starting high_freq at fmax + 1 solves the case where the Max AICLK is fmax */
-	uint32_t high_freq = aiclk_ppm.fmax + 1;
-	uint32_t low_freq = aiclk_ppm.fmin;
+	/* The curve is convex, so the frequencies that fit form a range. If it extends past
+	 * fmax, fmax fits unless the whole range lies above it.
+	 */
+	if (freq > (int32_t)aiclk_ppm.fmax) {
+		bool fmax_fits = VFCurveLookup(aiclk_ppm.fmax) <= ((int64_t)voltage << Q16_SHIFT);
 
-	while (low_freq < high_freq) {
-		uint32_t mid_freq = (low_freq + high_freq) / 2;
+		freq = fmax_fits ? aiclk_ppm.fmax : VF_CURVE_NO_FREQ;
+	}
 
-		if (VFCurve(mid_freq) > voltage) {
-			high_freq = mid_freq;
-		} else {
-			low_freq = mid_freq + 1;
-		}
+	if (freq < (int32_t)aiclk_ppm.fmin) {
+		return aiclk_ppm.fmin - 1;
 	}
 
-	return low_freq - 1;
+	return freq;
 }
 
 void InitArbMaxVoltage(void)
@@ -175,16 +316,10 @@ void InitArbMaxVoltage(void)
 	SetAiclkArbMax(kAiclkArbMaxVoltage, GetMaxAiclkForVoltage(voltage_arbiter.vdd_max));
 }
 
-static int InitAiclkPPM(void)
+/* Initialize the AICLK tracking variables and arbiters, given the frequency the PLL booted at */
+STATIC void InitAiclkPPMState(uint32_t boot_freq)
 {
-	if (IS_ENABLED(CONFIG_TT_SMC_RECOVERY) || !IS_ENABLED(CONFIG_ARC)) {
-		return 0;
-	}
-
-	/* Initialize some AICLK tracking variables */
-
-	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
-			       &aiclk_ppm.boot_freq);
+	aiclk_ppm.boot_freq = boot_freq;
 	aiclk_ppm.curr_freq = aiclk_ppm.boot_freq;
 	aiclk_ppm.targ_freq = aiclk_ppm.curr_freq;
 
@@ -200,15 +335,30 @@ static int InitAiclkPPM(void)
 	aiclk_ppm.sweep_en = 0;
 
 	for (int i = 0; i < kAiclkArbMaxCount; i++) {
-		aiclk_ppm.arbiter_max[i].value = aiclk_ppm.fmax;
+		aiclk_ppm.arbiter_max[i].value = q16_from_int(aiclk_ppm.fmax);
 		aiclk_ppm.arbiter_max[i].enabled = true;
 	}
 
 	for (int i = 0; i < kAiclkArbMinCount; i++) {
-		aiclk_ppm.arbiter_min[i].value = aiclk_ppm.fmin;
+		aiclk_ppm.arbiter_min[i].value = q16_from_int(aiclk_ppm.fmin);
 		aiclk_ppm.arbiter_min[i].enabled = true;
 	}
 
+	ResetLimitStats();
+}
+
+static int InitAiclkPPM(void)
+{
+	if (IS_ENABLED(CONFIG_TT_SMC_RECOVERY) || !IS_ENABLED(CONFIG_ARC)) {
+		return 0;
+	}
+
+	uint32_t boot_freq;
+
+	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
+			       &boot_freq);
+	InitAiclkPPMState(boot_freq);
+
 	return 0;
 }
 SYS_INIT_APP(InitAiclkPPM);
@@ -310,9 +460,36 @@ static uint8_t SweepAiclkHandler(const union request *request, struct response *
 	return 0;
 }
 
+/** @brief Handles the request to read the throttling statistics of one AICLK max arbiter
+ * @param[in] request The request, of type @ref get_aiclk_limit_stats_rqst
+ * @param[out] response The response to the host
+ * @return 0 for success, EINVAL if the arbiter does not exist
+ */
+static uint8_t get_aiclk_limit_stats_handler(const union request *request,
+					     struct response *response)
+{
+	AiclkArbMax arb_max = request->get_aiclk_limit_stats.arbiter;
+	AiclkArbStats stats;
+
+	if (GetAiclkArbStats(arb_max, &stats) != 0) {
+		return EINVAL;
+	}
+
+	response->data[1] = stats.time_limited_ms;
+	response->data[2] = stats.entry_count;
+	response->data[3] = stats.last_entry_ms;
+	response->data[4] = k_uptime_get_32();
+	response->data[5] = GetAiclkLimiter() == arb_max;
+	response->data[6] = aiclk_ppm.arbiter_max[arb_max].enabled;
+	response->data[7] = q16_to_int(aiclk_ppm.arbiter_max[arb_max].value);
+
+	return 0;
+}
+
 REGISTER_MESSAGE(TT_SMC_MSG_AICLK_GO_BUSY, aiclk_busy_handler);
 REGISTER_MESSAGE(TT_SMC_MSG_AICLK_GO_LONG_IDLE, aiclk_busy_handler);
 REGISTER_MESSAGE(TT_SMC_MSG_FORCE_AICLK, ForceAiclkHandler);
 REGISTER_MESSAGE(TT_SMC_MSG_GET_AICLK, get_aiclk_handler);
 REGISTER_MESSAGE(TT_SMC_MSG_AISWEEP_START, SweepAiclkHandler);
 REGISTER_MESSAGE(TT_SMC_MSG_AISWEEP_STOP, SweepAiclkHandler);
+REGISTER_MESSAGE(TT_SMC_MSG_GET_AICLK_LIMIT_STATS, get_aiclk_limit_stats_handler);
@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "fixed_point.h"
+
 typedef enum {
 	kAiclkArbMaxFmax,
 	kAiclkArbMaxTDP,
@@ -29,20 +31,31 @@ typedef enum {
 	kAiclkArbMinCount,
 } AiclkArbMin;
 
+/* Throttling statistics of a max arbiter, see GetAiclkArbStats. Min arbiters have none. */
+typedef struct {
+	uint32_t time_limited_ms; /* Total time the arbiter has limited AICLK */
+	uint32_t entry_count;     /* Number of times the arbiter started limiting AICLK */
+	uint32_t last_entry_ms;   /* Uptime when the arbiter last started limiting AICLK */
+} AiclkArbStats;
+
 void aiclk_set_busy(bool is_busy);
 void SetAiclkArbMax(AiclkArbMax arb_max, float freq);
+void SetAiclkArbMaxFixed(AiclkArbMax arb_max, q16_t freq);
 void SetAiclkArbMin(AiclkArbMin arb_min, float freq);
 void EnableArbMax(AiclkArbMax arb_max, bool enable);
 void EnableArbMin(AiclkArbMin arb_min, bool enable);
 void CalculateTargAiclk(void);
-void DecreaseAiclk(void);
+bool DecreaseAiclk(void);
 void IncreaseAiclk(void);
 void InitArbMaxVoltage(void);
 float GetThrottlerArbMax(AiclkArbMax arb_max);
+q16_t GetThrottlerArbMaxFixed(AiclkArbMax arb_max);
 uint8_t ForceAiclk(uint32_t freq);
 uint32_t GetAiclkTarg(void);
 uint32_t GetMaxAiclkForVoltage(uint32_t voltage);
 uint32_t GetAiclkFmin(void);
 uint32_t GetAiclkFmax(void);
+int GetAiclkArbStats(AiclkArbMax arb_max, AiclkArbStats *stats);
+AiclkArbMax GetAiclkLimiter(void);
 
 #endif
@@ -7,8 +7,12 @@
 #include "avs.h"
 #include "regulator.h"
 
+#include <errno.h>
+
 #include <tenstorrent/sys_init_defines.h>
 #include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
@@ -34,6 +38,9 @@ static const struct device *const pll_dev_1 = DEVICE_DT_GET_OR_NULL(DT_NODELABEL
 #define APB2AVSBUS_AVS_FIFOS_STATUS_CMD_FIFO_VACANT_SLOTS_MASK        0xF00
 #define APB2AVSBUS_AVS_FIFOS_STATUS_READBACK_FIFO_OCCUPIED_SLOTS_MASK 0xF0000
 
+#define APB2AVSBUS_AVS_FIFOS_STATUS_CMD_FIFO_VACANT_SLOTS_SHIFT        8
+#define APB2AVSBUS_AVS_FIFOS_STATUS_READBACK_FIFO_OCCUPIED_SLOTS_SHIFT 16
+
 #define APB2AVSBUS_AVS_CMD_CMD_DATA_SHIFT       3
 #define APB2AVSBUS_AVS_READBACK_CMD_DATA_SHIFT  8
 #define APB2AVSBUS_AVS_CMD_RAIL_SEL_SHIFT       19
@@ -87,70 +94,335 @@ typedef enum {
 	AVSRead = 3,
 } AVSReadWriteType;
 
-static void WaitCmdFifoNotFull(void)
+/* Rails whose voltage writes are tracked until the output has slewed */
+#define AVS_NUM_RAILS 2
+
+/* 150us to cover voltage switch from 0.65V to 0.95V with 50us of margin */
+#define AVS_SLEW_US 150
+
+/* The bus runs at 20 MHz, so a 32-bit frame and its readback take a few us */
+#define AVS_POLL_US 10
+
+#define AVS_QUEUE_DEPTH       CONFIG_TT_BH_ARC_AVS_QUEUE_DEPTH
+#define AVS_TEMP_C_PER_LSB    0.1f
+
+struct avs_cmd {
+	uint32_t cmd; /* APB2AVSBUS_AVS_CMD register value */
+	uint8_t rail_sel;
+	bool slew; /* Voltage write, the rail slews once it is acknowledged */
+	uint8_t num_tries;
+	AVSCallback callback;
+	void *user_data;
+};
+
+struct avs_sync {
+	struct k_sem done;
+	AVSStatus status;
+	uint16_t response;
+};
+
+/* Commands are completed in the order they were queued, as the controller returns readbacks in
+ * command order. The oldest avs_in_flight commands are in the controller and avs_pending more
+ * wait behind them for room in its command FIFO.
+ */
+static struct k_spinlock avs_lock;
+static struct avs_cmd avs_queue[AVS_QUEUE_DEPTH];
+static uint32_t avs_head;
+static uint32_t avs_in_flight;
+static uint32_t avs_pending;
+
+/* Unacknowledged voltage writes, and whether the rail is still slewing, per rail */
+static uint8_t avs_slew_writes[AVS_NUM_RAILS];
+static bool avs_slewing[AVS_NUM_RAILS];
+static K_EVENT_DEFINE(avs_slew_event);
+
+static void AVSPollTimerHandler(struct k_timer *timer);
+static void AVSSlewTimerHandler(struct k_timer *timer);
+static K_TIMER_DEFINE(avs_poll_timer, AVSPollTimerHandler, NULL);
+static K_TIMER_DEFINE(avs_vcore_slew_timer, AVSSlewTimerHandler, NULL);
+static K_TIMER_DEFINE(avs_vcorem_slew_timer, AVSSlewTimerHandler, NULL);
+
+static struct k_timer *const avs_slew_timer[AVS_NUM_RAILS] = {
+	[AVS_VCORE_RAIL] = &avs_vcore_slew_timer,
+	[AVS_VCOREM_RAIL] = &avs_vcorem_slew_timer,
+};
+
+static uint32_t EncodeCmd(uint16_t cmd_data, uint8_t rail_sel, uint8_t cmd_code, uint8_t cmd_grp,
+			  AVSReadWriteType r_or_w)
+{
+	uint32_t cmd_data_pos = cmd_data << GET_AVS_FIELD_SHIFT(CMD, CMD_DATA);
+	uint32_t rail_sel_pos = (rail_sel << GET_AVS_FIELD_SHIFT(CMD, RAIL_SEL)) &
+				GET_AVS_FIELD_MASK(CMD, RAIL_SEL);
+	uint32_t cmd_code_pos = (cmd_code << GET_AVS_FIELD_SHIFT(CMD, CMD_CODE)) &
+				GET_AVS_FIELD_MASK(CMD, CMD_CODE);
+	uint32_t cmd_grp_pos =
+		(cmd_grp << GET_AVS_FIELD_SHIFT(CMD, CMD_GRP)) & GET_AVS_FIELD_MASK(CMD, CMD_GRP);
+	uint32_t r_or_w_pos = r_or_w << GET_AVS_FIELD_SHIFT(CMD, R_OR_W);
+
+	return cmd_data_pos | rail_sel_pos | cmd_code_pos | cmd_grp_pos | r_or_w_pos;
+}
+
+static uint32_t CmdFifoVacantSlots(uint32_t fifos_status)
+{
+	return (fifos_status & GET_AVS_FIELD_MASK(FIFOS_STATUS, CMD_FIFO_VACANT_SLOTS)) >>
+	       GET_AVS_FIELD_SHIFT(FIFOS_STATUS, CMD_FIFO_VACANT_SLOTS);
+}
+
+static uint32_t ReadbackFifoOccupiedSlots(uint32_t fifos_status)
+{
+	return (fifos_status & GET_AVS_FIELD_MASK(FIFOS_STATUS, READBACK_FIFO_OCCUPIED_SLOTS)) >>
+	       GET_AVS_FIELD_SHIFT(FIFOS_STATUS, READBACK_FIFO_OCCUPIED_SLOTS);
+}
+
+static void AVSSlewTimerHandler(struct k_timer *timer)
+{
+	for (uint8_t rail_sel = 0; rail_sel < AVS_NUM_RAILS; rail_sel++) {
+		if (avs_slew_timer[rail_sel] != timer) {
+			continue;
+		}
+
+		k_spinlock_key_t key = k_spin_lock(&avs_lock);
+
+		/* A write queued since the timer started restarts it when acknowledged */
+		if (avs_slew_writes[rail_sel] == 0) {
+			avs_slewing[rail_sel] = false;
+			k_event_post(&avs_slew_event, BIT(rail_sel));
+		}
+
+		k_spin_unlock(&avs_lock, key);
+	}
+}
+
+/* Collect the readbacks of finished commands and refill the command FIFO from the queue.
+ * Completion callbacks are called from here, in thread or timer context. Returns true while
+ * any command is outstanding.
+ */
+static bool AVSServiceQueue(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&avs_lock);
+	uint32_t fifos_status = ReadReg(APB2AVSBUS_AVS_FIFOS_STATUS_REG_ADDR);
+	uint32_t occupied = ReadbackFifoOccupiedSlots(fifos_status);
+
+	while (occupied > 0 && avs_in_flight > 0) {
+		struct avs_cmd *cmd = &avs_queue[avs_head];
+		uint32_t readback_data = ReadReg(APB2AVSBUS_AVS_READBACK_REG_ADDR);
+		AVSStatus slave_ack = readback_data >> GET_AVS_FIELD_SHIFT(READBACK, SLAVE_ACK);
+
+		occupied--;
+		cmd->num_tries++;
+
+		/* The controller retries a NACKed command by itself and posts a readback for each
+		 * try. Assume users do not program max_retries while commands are in flight.
+		 */
+		if (slave_ack != AVSOk &&
+		    cmd->num_tries <= (uint8_t)ReadReg(APB2AVSBUS_AVS_CFG_0_REG_ADDR)) {
+			continue;
+		}
+
+		struct avs_cmd done = *cmd;
+		uint16_t response = AVS_ERR_RB_DATA;
+
+		if (slave_ack == AVSOk) {
+			response = (readback_data & GET_AVS_FIELD_MASK(READBACK, CMD_DATA)) >>
+				   GET_AVS_FIELD_SHIFT(READBACK, CMD_DATA);
+		}
+
+		avs_head = (avs_head + 1) % AVS_QUEUE_DEPTH;
+		avs_in_flight--;
+
+		/* A NACKed write still waits out the slew of any earlier write to the rail */
+		if (done.slew && --avs_slew_writes[done.rail_sel] == 0) {
+			k_timer_start(avs_slew_timer[done.rail_sel], K_USEC(AVS_SLEW_US),
+				      K_NO_WAIT);
+		}
+
+		if (done.callback != NULL) {
+			k_spin_unlock(&avs_lock, key);
+			done.callback(slave_ack, response, done.user_data);
+			key = k_spin_lock(&avs_lock);
+
+			/* The queue may have been serviced from elsewhere in the meantime */
+			fifos_status = ReadReg(APB2AVSBUS_AVS_FIFOS_STATUS_REG_ADDR);
+			occupied = ReadbackFifoOccupiedSlots(fifos_status);
+		}
+	}
+
+	/* Draining the readback FIFO never takes up command FIFO slots */
+	uint32_t vacant = CmdFifoVacantSlots(fifos_status);
+
+	while (vacant > 0 && avs_pending > 0) {
+		WriteReg(APB2AVSBUS_AVS_CMD_REG_ADDR,
+			 avs_queue[(avs_head + avs_in_flight) % AVS_QUEUE_DEPTH].cmd);
+		avs_in_flight++;
+		avs_pending--;
+		vacant--;
+	}
+
+	bool outstanding = avs_in_flight + avs_pending > 0;
+
+	k_spin_unlock(&avs_lock, key);
+
+	return outstanding;
+}
+
+static void AVSPollTimerHandler(struct k_timer *timer)
+{
+	if (!AVSServiceQueue()) {
+		k_timer_stop(timer);
+	}
+}
+
+/* Start whatever fits in the command FIFO and poll for the rest from the timer */
+static void AVSKick(void)
+{
+	if (AVSServiceQueue()) {
+		k_timer_start(&avs_poll_timer, K_USEC(AVS_POLL_US), K_USEC(AVS_POLL_US));
+	}
+}
+
+/* Called with avs_lock held */
+static int AVSEnqueue(uint32_t cmd, uint8_t rail_sel, bool slew, AVSCallback callback,
+		      void *user_data)
+{
+	if (avs_in_flight + avs_pending == AVS_QUEUE_DEPTH) {
+		return -EBUSY;
+	}
+
+	avs_queue[(avs_head + avs_in_flight + avs_pending) % AVS_QUEUE_DEPTH] = (struct avs_cmd){
+		.cmd = cmd,
+		.rail_sel = rail_sel,
+		.slew = slew,
+		.callback = callback,
+		.user_data = user_data,
+	};
+	avs_pending++;
+
+	if (slew) {
+		avs_slew_writes[rail_sel]++;
+		avs_slewing[rail_sel] = true;
+		k_event_clear(&avs_slew_event, BIT(rail_sel));
+	}
+
+	return 0;
+}
+
+static int AVSSubmit(uint32_t cmd, uint8_t rail_sel, bool slew, AVSCallback callback,
+		     void *user_data)
 {
-	uint32_t cmd_fifo_vacant_slots = 0;
+	k_spinlock_key_t key = k_spin_lock(&avs_lock);
+	int ret = AVSEnqueue(cmd, rail_sel, slew, callback, user_data);
 
-	do {
-		cmd_fifo_vacant_slots = ReadReg(APB2AVSBUS_AVS_FIFOS_STATUS_REG_ADDR) &
-					GET_AVS_FIELD_MASK(FIFOS_STATUS, CMD_FIFO_VACANT_SLOTS);
-	} while (cmd_fifo_vacant_slots == 0);
+	k_spin_unlock(&avs_lock, key);
+
+	if (ret == 0) {
+		AVSKick();
+	}
+
+	return ret;
+}
+
+static bool AVSCanSleep(void)
+{
+	return !k_is_pre_kernel() && !k_is_in_isr();
 }
 
-static void WaitRxFifoNotEmpty(void)
+static void AVSSyncDone(AVSStatus status, uint16_t response, void *user_data)
 {
-	uint32_t readback_fifo_occupied_slots = 0;
+	struct avs_sync *sync = user_data;
 
-	do {
-		readback_fifo_occupied_slots =
-			ReadReg(APB2AVSBUS_AVS_FIFOS_STATUS_REG_ADDR) &
-			GET_AVS_FIELD_MASK(FIFOS_STATUS, READBACK_FIFO_OCCUPIED_SLOTS);
-	} while (readback_fifo_occupied_slots == 0);
+	sync->status = status;
+	sync->response = response;
+	k_sem_give(&sync->done);
 }
 
-/* Assume users do not program max_retries while reading from the RX FIFO. */
-/* TODO: log the debug status in CSM. */
-static AVSStatus ReadRxFifo(uint16_t *response)
+/* Drop the callback of a queued command, the command itself still runs. Returns -EALREADY if it
+ * has already completed, in which case the callback has been or is being called.
+ */
+int AVSCancel(AVSCallback callback, void *user_data)
 {
-	uint8_t max_retries = ReadReg(APB2AVSBUS_AVS_CFG_0_REG_ADDR);
-	uint32_t readback_data = 0;
-	uint8_t num_tries = 0;
-	AVSStatus slave_ack = AVSOk;
+	int ret = -EALREADY;
+
+	K_SPINLOCK(&avs_lock) {
+		for (uint32_t i = 0; i < avs_in_flight + avs_pending; i++) {
+			struct avs_cmd *cmd = &avs_queue[(avs_head + i) % AVS_QUEUE_DEPTH];
 
-	do {
-		WaitRxFifoNotEmpty();
-		readback_data = ReadReg(APB2AVSBUS_AVS_READBACK_REG_ADDR);
-		slave_ack = readback_data >> GET_AVS_FIELD_SHIFT(READBACK, SLAVE_ACK);
-		num_tries++;
-	} while (slave_ack != AVSOk && num_tries <= max_retries);
+			if (cmd->callback == callback && cmd->user_data == user_data) {
+				cmd->callback = NULL;
+				ret = 0;
+				break;
+			}
+		}
+	}
 
+	return ret;
+}
+
+/* Queue a command behind any asynchronous ones and wait for its readback. The calling thread
+ * sleeps while the poll timer services the queue. Before the kernel starts or from an ISR the
+ * queue is polled instead. Gives up with AVSTimeout after AVS_TIMEOUT_US.
+ */
+static AVSStatus AVSTransaction(uint32_t cmd, uint8_t rail_sel, bool slew, uint16_t *response)
+{
+	struct avs_sync sync;
+	uint32_t polls = 0;
+
+	k_sem_init(&sync.done, 0, 1);
 	if (response != NULL) {
-		if (slave_ack != AVSOk) {
-			*response = AVS_ERR_RB_DATA;
-		} else {
-			*response = (readback_data & GET_AVS_FIELD_MASK(READBACK, CMD_DATA)) >>
-				    GET_AVS_FIELD_SHIFT(READBACK, CMD_DATA);
+		*response = AVS_ERR_RB_DATA;
+	}
+
+	/* The queue drains within a few bus frames */
+	while (AVSSubmit(cmd, rail_sel, slew, AVSSyncDone, &sync) != 0) {
+		if (++polls > AVS_TIMEOUT_US / AVS_POLL_US) {
+			return AVSTimeout;
+		}
+		AVSServiceQueue();
+		k_busy_wait(AVS_POLL_US);
+	}
+
+	if (AVSCanSleep()) {
+		if (k_sem_take(&sync.done, K_USEC(AVS_TIMEOUT_US)) != 0) {
+			if (AVSCancel(AVSSyncDone, &sync) == 0) {
+				return AVSTimeout;
+			}
+			/* The readback arrived as the wait timed out and AVSSyncDone is already
+			 * running, it must finish with sync before it goes out of scope.
+			 */
+			k_sem_take(&sync.done, K_FOREVER);
 		}
+	} else {
+		while (k_sem_take(&sync.done, K_NO_WAIT) != 0) {
+			/* Nothing else services the queue, so a failed cancel means the readback
+			 * has just been handled.
+			 */
+			if (++polls > AVS_TIMEOUT_US / AVS_POLL_US &&
+			    AVSCancel(AVSSyncDone, &sync) == 0) {
+				return AVSTimeout;
+			}
+			AVSServiceQueue();
+			k_busy_wait(AVS_POLL_US);
+		}
+	}
+
+	if (response != NULL) {
+		*response = sync.response;
 	}
 
-	return slave_ack;
+	return sync.status;
 }
 
-static void SendCmd(uint16_t cmd_data, uint8_t rail_sel, uint8_t cmd_code, uint8_t cmd_grp,
-		    AVSReadWriteType r_or_w)
+static AVSStatus AVSReadCmd(uint8_t rail_sel, uint8_t cmd_code, uint8_t cmd_grp,
+			    uint16_t *response)
 {
-	WaitCmdFifoNotFull();
-	uint32_t cmd_data_pos = cmd_data << GET_AVS_FIELD_SHIFT(CMD, CMD_DATA);
-	uint32_t rail_sel_pos = (rail_sel << GET_AVS_FIELD_SHIFT(CMD, RAIL_SEL)) &
-				GET_AVS_FIELD_MASK(CMD, RAIL_SEL);
-	uint32_t cmd_code_pos = (cmd_code << GET_AVS_FIELD_SHIFT(CMD, CMD_CODE)) &
-				GET_AVS_FIELD_MASK(CMD, CMD_CODE);
-	uint32_t cmd_grp_pos =
-		(cmd_grp << GET_AVS_FIELD_SHIFT(CMD, CMD_GRP)) & GET_AVS_FIELD_MASK(CMD, CMD_GRP);
-	uint32_t r_or_w_pos = r_or_w << GET_AVS_FIELD_SHIFT(CMD, R_OR_W);
+	return AVSTransaction(EncodeCmd(AVS_RD_CMD_DATA, rail_sel, cmd_code, cmd_grp, AVSRead),
+			      rail_sel, false, response);
+}
 
-	WriteReg(APB2AVSBUS_AVS_CMD_REG_ADDR,
-		 cmd_data_pos | rail_sel_pos | cmd_code_pos | cmd_grp_pos | r_or_w_pos);
+static AVSStatus AVSWriteCmd(uint16_t cmd_data, uint8_t rail_sel, uint8_t cmd_code,
+			     uint8_t cmd_grp)
+{
+	return AVSTransaction(EncodeCmd(cmd_data, rail_sel, cmd_code, cmd_grp, AVSCommitWrite),
+			      rail_sel, false, NULL);
 }
 
 /* Program CFG_0, CFG_1 registers and interrupt settings. */
@@ -190,25 +462,63 @@ void AVSInit(void)
 
 AVSStatus AVSReadVoltage(uint8_t rail_sel, uint16_t *voltage_in_mV)
 {
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_VOLTAGE, AVSRead);
-	return ReadRxFifo(voltage_in_mV);
+	return AVSReadCmd(rail_sel, AVS_CMD_VOLTAGE, voltage_in_mV);
 }
 
 AVSStatus AVSWriteVoltage(uint16_t voltage_in_mV, uint8_t rail_sel)
 {
-	SendCmd(voltage_in_mV, rail_sel, AVS_CMD_VOLTAGE, AVSCommitWrite);
-	AVSStatus status = ReadRxFifo(NULL);
+	bool slew = rail_sel < AVS_NUM_RAILS;
+	uint32_t cmd = EncodeCmd(voltage_in_mV, rail_sel, AVS_CMD_VOLTAGE, AVSCommitWrite);
+	AVSStatus status = AVSTransaction(cmd, rail_sel, slew, NULL);
+
+	if (slew && AVSCanSleep()) {
+		AVSWaitSlew(rail_sel, K_USEC(AVS_TIMEOUT_US));
+	} else {
+		WaitUs(AVS_SLEW_US);
+	}
 
-	/* 150us to cover voltage switch from 0.65V to 0.95V with 50us of margin */
-	WaitUs(150);
 	return status;
 }
 
+/* Returns once the write is queued. The callback is called when the regulator acknowledges it,
+ * and the rail is reported as settled AVS_SLEW_US later, see AVSWaitSlew.
+ */
+int AVSWriteVoltageAsync(uint16_t voltage_in_mV, uint8_t rail_sel, AVSCallback callback,
+			 void *user_data)
+{
+	if (rail_sel >= AVS_NUM_RAILS) {
+		return -EINVAL;
+	}
+
+	return AVSSubmit(EncodeCmd(voltage_in_mV, rail_sel, AVS_CMD_VOLTAGE, AVSCommitWrite),
+			 rail_sel, true, callback, user_data);
+}
+
+/* Wait until every voltage write queued to the rail has been acknowledged and slewed.
+ * Returns -EAGAIN on timeout.
+ */
+int AVSWaitSlew(uint8_t rail_sel, k_timeout_t timeout)
+{
+	if (rail_sel >= AVS_NUM_RAILS) {
+		return -EINVAL;
+	}
+
+	/* The event is cleared whenever a write is queued, so it is only valid while slewing */
+	if (!avs_slewing[rail_sel]) {
+		return 0;
+	}
+
+	if (k_event_wait(&avs_slew_event, BIT(rail_sel), false, timeout) == 0) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
 AVSStatus AVSReadVoutTransRate(uint8_t rail_sel, uint8_t *rise_rate, uint8_t *fall_rate)
 {
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_VOUT_TRANS_RATE, AVSRead);
 	uint16_t trans_rate;
-	AVSStatus status = ReadRxFifo(&trans_rate);
+	AVSStatus status = AVSReadCmd(rail_sel, AVS_CMD_VOUT_TRANS_RATE, &trans_rate);
 	*rise_rate = trans_rate >> 8;
 	*fall_rate = trans_rate & 0xff;
 	return status;
@@ -218,59 +528,51 @@ AVSStatus AVSWriteVoutTransRate(uint8_t rise_rate, uint8_t fall_rate, uint8_t ra
 {
 	uint16_t trans_rate = (rise_rate << 8) | fall_rate;
 
-	SendCmd(trans_rate, rail_sel, AVS_CMD_VOUT_TRANS_RATE, AVSCommitWrite);
-	return ReadRxFifo(NULL);
+	return AVSWriteCmd(trans_rate, rail_sel, AVS_CMD_VOUT_TRANS_RATE);
 }
 
 /* Returns current in A */
 AVSStatus AVSReadCurrent(uint8_t rail_sel, float *current_in_A)
 {
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_CURRENT_READ, AVSRead);
 	uint16_t current_in_10mA;
-	AVSStatus status = ReadRxFifo(&current_in_10mA);
-	*current_in_A = current_in_10mA * 0.01f;
+	AVSStatus status = AVSReadCmd(rail_sel, AVS_CMD_CURRENT_READ, &current_in_10mA);
+	*current_in_A = current_in_10mA * AVS_CURRENT_A_PER_LSB;
 	return status;
 }
 
 AVSStatus AVSReadTemp(uint8_t rail_sel, float *temp_in_C)
 {
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_TEMP_READ, AVSRead);
 	uint16_t temp; /* 1LSB = 0.1degC  */
-	AVSStatus status = ReadRxFifo(&temp);
-	*temp_in_C = temp * 0.1;
+	AVSStatus status = AVSReadCmd(rail_sel, AVS_CMD_TEMP_READ, &temp);
+	*temp_in_C = temp * AVS_TEMP_C_PER_LSB;
 	return status;
 }
 
 AVSStatus AVSForceVoltageReset(uint8_t rail_sel)
 {
-	SendCmd(AVS_FORCE_RESET_DATA, rail_sel, AVS_CMD_FORCE_RESET, AVSCommitWrite);
-	return ReadRxFifo(NULL);
+	return AVSWriteCmd(AVS_FORCE_RESET_DATA, rail_sel, AVS_CMD_FORCE_RESET);
 }
 
 /* This command is not supported by MAX20816, but will be ACKed. */
 AVSStatus AVSReadPowerMode(uint8_t rail_sel, AVSPwrMode *power_mode)
 {
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_POWER_MODE, AVSRead);
-	return ReadRxFifo((uint16_t *)power_mode);
+	return AVSReadCmd(rail_sel, AVS_CMD_POWER_MODE, (uint16_t *)power_mode);
 }
 
 /* This command is not supported by MAX20816, but will be ACKed. */
 AVSStatus AVSWritePowerMode(AVSPwrMode power_mode, uint8_t rail_sel)
 {
-	SendCmd(power_mode, rail_sel, AVS_CMD_POWER_MODE, AVSCommitWrite);
-	return ReadRxFifo(NULL);
+	return AVSWriteCmd(power_mode, rail_sel, AVS_CMD_POWER_MODE);
 }
 
 AVSStatus AVSReadStatus(uint8_t rail_sel, uint16_t *status)
 {
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_STATUS, AVSRead);
-	return ReadRxFifo(status);
+	return AVSReadCmd(rail_sel, AVS_CMD_STATUS, status);
 }
 
 AVSStatus AVSWriteStatus(uint16_t status, uint8_t rail_sel)
 {
-	SendCmd(status, rail_sel, AVS_CMD_STATUS, AVSCommitWrite);
-	return ReadRxFifo(NULL);
+	return AVSWriteCmd(status, rail_sel, AVS_CMD_STATUS);
 }
 
 /* For AVSBus version read, the rail_sel is broadcast. */
@@ -278,16 +580,14 @@ AVSStatus AVSWriteStatus(uint16_t status, uint8_t rail_sel)
 /* Any other PMBus versions are not supported by the AVS controller. */
 AVSStatus AVSReadVersion(uint16_t *version)
 {
-	SendCmd(AVS_RD_CMD_DATA, AVS_RAIL_SEL_BROADCAST, AVS_CMD_VERSION_READ, AVSRead);
-	return ReadRxFifo(version);
+	return AVSReadCmd(AVS_RAIL_SEL_BROADCAST, AVS_CMD_VERSION_READ, version);
 }
 
 AVSStatus AVSReadSystemInputCurrent(uint16_t *response)
 {
 	uint8_t rail_sel = 0x0; /* Rail A and Rail B return the same data. */
 
-	SendCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_SYS_INPUT_CURRENT_READ, AVSRead);
-	return ReadRxFifo(response);
+	return AVSReadCmd(rail_sel, AVS_CMD_SYS_INPUT_CURRENT_READ, response);
 	/* TODO: need to figure the formula to calculate the system input current */
 	/* System Input Current (read only) returns the ADC output of voltage at IINSEN pin. */
 	/* The raw ADC data is decoded to determine the VIINSEN voltage: */
@@ -301,6 +601,19 @@ AVSStatus AVSReadSystemInputCurrent(uint16_t *response)
 	 */
 }
 
+/* Queue a current read of a rail. The callback gets the current in units of
+ * AVS_CURRENT_A_PER_LSB.
+ */
+int AVSReadCurrentAsync(uint8_t rail_sel, AVSCallback callback, void *user_data)
+{
+	if (rail_sel >= AVS_NUM_RAILS) {
+		return -EINVAL;
+	}
+
+	return AVSSubmit(EncodeCmd(AVS_RD_CMD_DATA, rail_sel, AVS_CMD_CURRENT_READ, AVSRead),
+			 rail_sel, false, callback, user_data);
+}
+
 static int avs_init(void)
 {
 	if (IS_ENABLED(CONFIG_TT_SMC_RECOVERY) || !IS_ENABLED(CONFIG_ARC)) {
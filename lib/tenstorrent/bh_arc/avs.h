@@ -7,12 +7,19 @@
 #define AVS_H
 
 #include <stdint.h>
+#include <zephyr/kernel.h>
+
+/* Bound on waiting for the readback of a queued command, or for a voltage write to be
+ * acknowledged and slewed.
+ */
+#define AVS_TIMEOUT_US 10000
 
 typedef enum {
 	AVSOk = 0,
 	AVSResourceUnavailable = 1, /* retry */
 	AVSBadCrc = 2,              /* retry */
 	AVSGoodCrcBadData = 3,      /* no retry */
+	AVSTimeout = 4,             /* no readback within AVS_TIMEOUT_US */
 } AVSStatus;
 
 typedef enum {
@@ -23,6 +30,14 @@ typedef enum {
 #define AVS_VCORE_RAIL  0
 #define AVS_VCOREM_RAIL 1
 
+/* Scale of the current read response */
+#define AVS_CURRENT_A_PER_LSB 0.01f
+
+/* Completion callbacks may be called from the AVS poll timer interrupt and must not block. The
+ * response is AVS_ERR_RB_DATA (0xffff) if the command failed.
+ */
+typedef void (*AVSCallback)(AVSStatus status, uint16_t response, void *user_data);
+
 AVSStatus AVSReadVoltage(uint8_t rail_sel, uint16_t *voltage_in_mV);
 AVSStatus AVSWriteVoltage(uint16_t voltage_in_mV, uint8_t rail_sel);
 AVSStatus AVSReadVoutTransRate(uint8_t rail_sel, uint8_t *rise_rate, uint8_t *fall_rate);
@@ -36,4 +51,9 @@ AVSStatus AVSReadStatus(uint8_t rail_sel, uint16_t *status);
 AVSStatus AVSWriteStatus(uint16_t status, uint8_t rail_sel);
 AVSStatus AVSReadVersion(uint16_t *version);
 AVSStatus AVSReadSystemInputCurrent(uint16_t *response);
+int AVSWriteVoltageAsync(uint16_t voltage_in_mV, uint8_t rail_sel, AVSCallback callback,
+			 void *user_data);
+int AVSWaitSlew(uint8_t rail_sel, k_timeout_t timeout);
+int AVSReadCurrentAsync(uint8_t rail_sel, AVSCallback callback, void *user_data);
+int AVSCancel(AVSCallback callback, void *user_data);
 #endif
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/dma_arc_hs.h>
+#include <zephyr/drivers/dma/dma_tt_bh_noc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <tenstorrent/msgqueue.h>
+#include <tenstorrent/smc_msg.h>
+
+#include "dma_bench.h"
+#include "noc_init.h"
+#include "pcie_dma.h"
+
+/* Channels that nothing else in the firmware uses */
+#define ARC_DMA_CHANNEL 3
+#define NOC_DMA_CHANNEL 3
+
+#define TRANSFER_TIMEOUT K_MSEC(100)
+#define MAX_ITERATIONS   CONFIG_TT_BH_ARC_DMA_BENCH_MAX_ITERATIONS
+#define ARC_BUF_SIZE     CONFIG_TT_BH_ARC_DMA_BENCH_ARC_BUF_SIZE
+
+#ifdef CONFIG_DMA_ARC_HS
+static const struct device *const arc_dma_dev = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma0));
+static uint8_t arc_src[ARC_BUF_SIZE] __aligned(4);
+static uint8_t arc_dst[ARC_BUF_SIZE] __aligned(4);
+#endif
+
+#ifdef CONFIG_DMA_TT_BH_NOC
+static const struct device *const dma_noc = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma1));
+#endif
+
+static K_MUTEX_DEFINE(bench_lock);
+static uint32_t latency_cycles[MAX_ITERATIONS];
+
+#ifdef CONFIG_DMA_TT_BH_NOC
+static int DmaBenchNocTransfer(const DmaBenchParams *params)
+{
+	uint8_t tensix_x, tensix_y;
+
+	GetEnabledTensix(&tensix_x, &tensix_y);
+
+	struct tt_bh_dma_noc_coords coords =
+		tt_bh_dma_noc_coords_init(tensix_x, tensix_y, tensix_x, tensix_y);
+	struct dma_block_config block = {
+		.source_address = params->chip_addr,
+		.dest_address = params->chip_addr + params->transfer_size,
+		.block_size = params->transfer_size,
+	};
+	struct dma_config config = {
+		.channel_direction = PERIPHERAL_TO_MEMORY,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.block_count = 1,
+		.head_block = &block,
+		.user_data = &coords,
+	};
+	int ret = dma_config(dma_noc, NOC_DMA_CHANNEL, &config);
+
+	if (ret == 0) {
+		ret = dma_start(dma_noc, NOC_DMA_CHANNEL);
+	}
+	if (ret == 0) {
+		ret = tt_bh_dma_noc_wait(dma_noc, NOC_DMA_CHANNEL, TRANSFER_TIMEOUT);
+	}
+
+	return ret;
+}
+#endif
+
+static int DmaBenchTransfer(const DmaBenchParams *params)
+{
+	switch (params->engine) {
+#ifdef CONFIG_DMA_ARC_HS
+	case DmaBenchArc:
+		return dma_arc_hs_transfer(arc_dma_dev, ARC_DMA_CHANNEL, arc_src, arc_dst,
+					   params->transfer_size, TRANSFER_TIMEOUT);
+#endif
+#ifdef CONFIG_DMA_TT_BH_NOC
+	case DmaBenchNoc:
+		return DmaBenchNocTransfer(params);
+#endif
+	case DmaBenchPcieHostToChip:
+	case DmaBenchPcieChipToHost:
+		return PcieDmaTransferWait(params->engine == DmaBenchPcieChipToHost,
+					   params->chip_addr, params->host_addr,
+					   params->transfer_size, TRANSFER_TIMEOUT);
+	default:
+		return -ENODEV;
+	}
+}
+
+int DmaBenchCheck(const DmaBenchParams *params)
+{
+	if (params->transfer_size == 0 || params->iterations == 0 ||
+	    params->iterations > MAX_ITERATIONS) {
+		return -EINVAL;
+	}
+
+	switch (params->engine) {
+#ifdef CONFIG_DMA_ARC_HS
+	case DmaBenchArc:
+		if (!device_is_ready(arc_dma_dev)) {
+			return -ENODEV;
+		}
+		return params->transfer_size <= ARC_BUF_SIZE ? 0 : -EINVAL;
+#endif
+#ifdef CONFIG_DMA_TT_BH_NOC
+	case DmaBenchNoc:
+		return device_is_ready(dma_noc) ? 0 : -ENODEV;
+#endif
+	case DmaBenchPcieHostToChip:
+	case DmaBenchPcieChipToHost:
+		return 0;
+	default:
+		return -ENODEV;
+	}
+}
+
+/* Cycles spent outside the idle thread since boot */
+static uint64_t DmaBenchBusyCycles(void)
+{
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	k_thread_runtime_stats_t stats;
+
+	k_thread_runtime_stats_all_get(&stats);
+	return stats.total_cycles;
+#else
+	/* Without usage accounting the CPU counts as busy for the whole run */
+	return k_cycle_get_64();
+#endif
+}
+
+static uint32_t DmaBenchPercentileNs(uint32_t iterations, uint32_t percentile)
+{
+	return k_cyc_to_ns_ceil64(latency_cycles[(iterations - 1) * percentile / 100]);
+}
+
+int DmaBenchRun(const DmaBenchParams *params, DmaBenchResult *result)
+{
+	int ret = DmaBenchCheck(params);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	k_mutex_lock(&bench_lock, K_FOREVER);
+
+	uint64_t start_busy = DmaBenchBusyCycles();
+	uint64_t start = k_cycle_get_64();
+
+	for (uint32_t i = 0; i < params->iterations && ret == 0; i++) {
+		uint32_t issue = k_cycle_get_32();
+
+		ret = DmaBenchTransfer(params);
+		latency_cycles[i] = k_cycle_get_32() - issue;
+	}
+
+	uint64_t wall_us = MAX(k_cyc_to_us_ceil64(k_cycle_get_64() - start), 1);
+	uint64_t busy_cycles = DmaBenchBusyCycles() - start_busy;
+
+	if (ret == 0) {
+		/* Insertion sort, the iteration count is small */
+		for (uint32_t i = 1; i < params->iterations; i++) {
+			uint32_t latency = latency_cycles[i];
+			uint32_t j = i;
+
+			for (; j > 0 && latency_cycles[j - 1] > latency; j--) {
+				latency_cycles[j] = latency_cycles[j - 1];
+			}
+			latency_cycles[j] = latency;
+		}
+
+		/* Bytes per microsecond are MB/s */
+		*result = (DmaBenchResult){
+			.mb_per_s = (uint64_t)params->transfer_size * params->iterations / wall_us,
+			.wall_us = wall_us,
+			.cpu_us = MIN(k_cyc_to_us_ceil64(busy_cycles), wall_us),
+			.p50_ns = DmaBenchPercentileNs(params->iterations, 50),
+			.p90_ns = DmaBenchPercentileNs(params->iterations, 90),
+			.p99_ns = DmaBenchPercentileNs(params->iterations, 99),
+			.max_ns = DmaBenchPercentileNs(params->iterations, 100),
+		};
+	}
+
+	k_mutex_unlock(&bench_lock);
+
+	return ret;
+}
+
+static struct {
+	atomic_t busy;
+	DmaBenchParams params;
+	struct msgqueue_deferred_response deferred;
+} bench_msg;
+
+static uint8_t DmaBenchRespond(const DmaBenchParams *params, struct response *response)
+{
+	DmaBenchResult result;
+	int ret = DmaBenchRun(params, &result);
+
+	if (ret == 0) {
+		response->data[1] = result.mb_per_s;
+		response->data[2] = result.wall_us;
+		response->data[3] = result.cpu_us;
+		response->data[4] = result.p50_ns;
+		response->data[5] = result.p90_ns;
+		response->data[6] = result.p99_ns;
+		response->data[7] = result.max_ns;
+	}
+
+	return -ret;
+}
+
+static void dma_bench_work_handler(struct k_work *work)
+{
+	struct response response = {0};
+	uint8_t exit_code = DmaBenchRespond(&bench_msg.params, &response);
+	/* Once busy is clear a new run may take over bench_msg, so respond via a copy */
+	struct msgqueue_deferred_response deferred = bench_msg.deferred;
+
+	atomic_clear(&bench_msg.busy);
+	msgqueue_complete_deferred_response(&deferred, exit_code, &response);
+}
+
+static K_WORK_DEFINE(dma_bench_work, dma_bench_work_handler);
+
+static uint8_t dma_bench_handler(const union request *request, struct response *response)
+{
+	const struct dma_bench_rqst *rqst = &request->dma_bench;
+	DmaBenchParams params = {
+		.engine = rqst->engine,
+		.transfer_size = rqst->transfer_size,
+		.iterations = rqst->iterations,
+		.chip_addr = ((uint64_t)rqst->chip_addr_hi << 32) | rqst->chip_addr_lo,
+		.host_addr = ((uint64_t)rqst->host_addr_hi << 32) | rqst->host_addr_lo,
+	};
+	int ret = DmaBenchCheck(&params);
+
+	if (ret != 0) {
+		return -ret;
+	}
+
+	if (!atomic_cas(&bench_msg.busy, 0, 1)) {
+		/* A run requested from another message queue is still going */
+		return EBUSY;
+	}
+
+	/* A run can take seconds, so finish it off the message queue and respond later */
+	bench_msg.params = params;
+	if (msgqueue_defer_response(&bench_msg.deferred) != 0) {
+		uint8_t exit_code = DmaBenchRespond(&params, response);
+
+		atomic_clear(&bench_msg.busy);
+		return exit_code;
+	}
+
+	if (msgqueue_submit_deferred_work(&dma_bench_work) < 0) {
+		/* No deferred work queue; complete in place. */
+		dma_bench_work_handler(&dma_bench_work);
+	}
+
+	return 0;
+}
+
+REGISTER_MESSAGE(TT_SMC_MSG_DMA_BENCH, dma_bench_handler);
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DMA_BENCH_H
+#define DMA_BENCH_H
+
+#include <stdint.h>
+
+typedef enum {
+	DmaBenchArc = 0,
+	DmaBenchNoc = 1,
+	DmaBenchPcieHostToChip = 2,
+	DmaBenchPcieChipToHost = 3,
+	DmaBenchNumEngines,
+} DmaBenchEngine;
+
+typedef struct {
+	DmaBenchEngine engine;
+	uint32_t transfer_size;
+	uint32_t iterations;
+	/* NOC: L1 address in the first enabled Tensix, copied to the bytes right after it.
+	 * PCIe: chip side of the transfer. Unused by the ARC engine, which copies between two
+	 * buffers of its own.
+	 */
+	uint64_t chip_addr;
+	/* PCIe: host side of the transfer */
+	uint64_t host_addr;
+} DmaBenchParams;
+
+typedef struct {
+	uint32_t mb_per_s;
+	uint32_t wall_us;
+	/* Time the CPU was not idle during the run, in any thread */
+	uint32_t cpu_us;
+	/* Per-transfer latency from issue to completion */
+	uint32_t p50_ns;
+	uint32_t p90_ns;
+	uint32_t p99_ns;
+	uint32_t max_ns;
+} DmaBenchResult;
+
+/* Check that an engine is present and the parameters fit it. Returns 0 or a negative errno. */
+int DmaBenchCheck(const DmaBenchParams *params);
+
+/* Run params->iterations back-to-back copies of params->transfer_size bytes, one at a time.
+ * Runs are serialised. Returns 0 or a negative errno, in which case result is not valid.
+ */
+int DmaBenchRun(const DmaBenchParams *params, DmaBenchResult *result);
+
+#endif
@@ -4,7 +4,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
+
+#include <tenstorrent/smc_msg.h>
+#include <tenstorrent/msgqueue.h>
+#include <zephyr/drivers/misc/bh_fwtable.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include "dvfs.h"
+#include "fixed_point.h"
 #include "vf_curve.h"
 #include "throttler.h"
 #include "aiclk_ppm.h"
@@ -12,27 +20,117 @@
 
 bool dvfs_enabled;
 
-void DVFSChange(void)
+/* A change in VCORE power or current of at least DVFS_TRANSIENT_PERMILLE of its limit within
+ * one period drops straight to the shortest period. While they move by less than
+ * DVFS_QUIET_PERMILLE the period doubles every tick, up to the longest one.
+ */
+#define DVFS_TRANSIENT_PERMILLE 50
+#define DVFS_QUIET_PERMILLE     10
+
+static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
+
+static uint32_t dvfs_period_us = CONFIG_TT_BH_ARC_DVFS_PERIOD_US;
+static uint32_t dvfs_period_nominal_us = CONFIG_TT_BH_ARC_DVFS_PERIOD_US;
+static uint32_t dvfs_period_min_us = CONFIG_TT_BH_ARC_DVFS_PERIOD_MIN_US;
+static uint32_t dvfs_period_max_us = CONFIG_TT_BH_ARC_DVFS_PERIOD_MAX_US;
+static uint32_t dvfs_forced_period_us; /* Zero while the period adapts */
+static bool dvfs_timer_running;
+
+/* Serializes DVFS ticks between the DVFS work item and the host message handlers that force
+ * AICLK, VDD or the period, which run on the message queue work queue.
+ */
+static K_MUTEX_DEFINE(dvfs_lock);
+
+static ThrottlerInputs dvfs_prev_inputs;
+static bool dvfs_prev_inputs_valid;
+static uint32_t dvfs_tdp_limit;
+static uint32_t dvfs_tdc_limit;
+
+/* Arbitrate the AICLK and voltage targets from the current throttler state, without touching
+ * the clocks or regulators.
+ */
+void CalculateDVFSTargets(void)
 {
-	CalculateThrottlers();
 	CalculateTargAiclk();
 
 	uint32_t targ_freq = GetAiclkTarg();
-	uint32_t aiclk_voltage = VFCurve(targ_freq);
+	uint32_t aiclk_voltage = q16_to_int(VFCurveLookup(targ_freq));
 
 	VoltageArbRequest(VoltageReqAiclk, aiclk_voltage);
 
 	CalculateTargVoltage();
+}
 
-	DecreaseAiclk();
-	VoltageChange();
-	IncreaseAiclk();
+/* Change between two samples as a fraction of the limit, saturating at the full limit */
+static uint32_t ChangePermille(float prev, float curr, uint32_t limit)
+{
+	float change = curr > prev ? curr - prev : prev - curr;
+
+	return MIN(change * 1000 / MAX(limit, 1), 1000.0F);
 }
 
-static void dvfs_work_handler(struct k_work *work)
+/* Pick the period until the next DVFS tick. A transient drops straight to the shortest period so
+ * a load step is tracked closely, and quiet ticks stretch it again so an idle card does not spend
+ * cycles on a loop that has nothing to do. While a throttler holds AICLK down, or Doppler counts
+ * samples, the period stays at most nominal.
+ */
+static uint32_t NextDVFSPeriod(const ThrottlerInputs *inputs)
 {
-	DVFSChange();
+	uint32_t change = 0;
+	uint32_t period = dvfs_period_us;
+	uint32_t ceiling = dvfs_period_max_us;
+
+	if (dvfs_prev_inputs_valid) {
+		change = MAX(ChangePermille(dvfs_prev_inputs.vcore_power, inputs->vcore_power,
+					    dvfs_tdp_limit),
+			     ChangePermille(dvfs_prev_inputs.vcore_current, inputs->vcore_current,
+					    dvfs_tdc_limit));
+	}
+	dvfs_prev_inputs = *inputs;
+	dvfs_prev_inputs_valid = true;
+
+	if (dvfs_forced_period_us != 0) {
+		return dvfs_forced_period_us;
+	}
+
+	if (!IS_ENABLED(CONFIG_TT_BH_ARC_DVFS_ADAPTIVE_PERIOD) || DopplerActive()) {
+		return dvfs_period_nominal_us;
+	}
+
+	if (GetAiclkLimiter() != kAiclkArbMaxCount) {
+		ceiling = dvfs_period_nominal_us;
+	}
+
+	if (change >= DVFS_TRANSIENT_PERMILLE) {
+		period = dvfs_period_min_us;
+	} else if (change < DVFS_QUIET_PERMILLE) {
+		period *= 2;
+	} else {
+		period = period < dvfs_period_nominal_us ? period * 2 : dvfs_period_nominal_us;
+	}
+
+	return CLAMP(period, dvfs_period_min_us, ceiling);
 }
+
+/**
+ * @brief Run one DVFS tick on the given measurements, without touching the clocks or regulators
+ *
+ * @param inputs The measurements to throttle on
+ *
+ * @return The time until the next tick in microseconds
+ */
+uint32_t DVFSStep(const ThrottlerInputs *inputs)
+{
+	SetThrottlerPeriod(dvfs_period_us);
+	UpdateThrottlers(inputs);
+	CalculateDVFSTargets();
+
+	dvfs_period_us = NextDVFSPeriod(inputs);
+
+	return dvfs_period_us;
+}
+
+static void dvfs_work_handler(struct k_work *work);
 static K_WORK_DEFINE(dvfs_worker, dvfs_work_handler);
 
 static void dvfs_timer_handler(struct k_timer *timer)
@@ -41,34 +139,119 @@ static void dvfs_timer_handler(struct k_timer *timer)
 }
 static K_TIMER_DEFINE(dvfs_timer, dvfs_timer_handler, NULL);
 
+static void RestartDVFSTimer(void)
+{
+	if (dvfs_timer_running) {
+		k_timer_start(&dvfs_timer, K_USEC(dvfs_period_us), K_USEC(dvfs_period_us));
+	}
+}
+
+void DVFSChange(void)
+{
+	k_mutex_lock(&dvfs_lock, K_FOREVER);
+
+	uint32_t period_us = dvfs_period_us;
+	ThrottlerInputs inputs;
+
+	/* Telemetry cached within the last period is as fresh as the loop needs. The cache age is
+	 * kept in ms, so a sub-ms period rounds up to 1 ms instead of down to 0, which would read
+	 * the sensors again on every tick.
+	 */
+	ReadThrottlerInputs(MAX(DIV_ROUND_UP(period_us, USEC_PER_MSEC), 1), &inputs);
+
+	if (DVFSStep(&inputs) != period_us) {
+		RestartDVFSTimer();
+	}
+
+	/* If AICLK is still slewing, leave VCORE and the increase to the next tick */
+	if (DecreaseAiclk()) {
+		VoltageChange();
+		IncreaseAiclk();
+	}
+
+	k_mutex_unlock(&dvfs_lock);
+}
+
+static void dvfs_work_handler(struct k_work *work)
+{
+	DVFSChange();
+}
+
+/* Take the period bounds from the FW table where it sets them, and start again from the nominal
+ * period.
+ */
+void InitDVFSPeriod(void)
+{
+	const FwTable_ChipLimits *limits = &tt_bh_fwtable_get_fw_table(fwtable_dev)->chip_limits;
+
+	dvfs_period_min_us = limits->dvfs_period_min_us != 0 ? limits->dvfs_period_min_us
+							     : CONFIG_TT_BH_ARC_DVFS_PERIOD_MIN_US;
+	dvfs_period_max_us = limits->dvfs_period_max_us != 0 ? limits->dvfs_period_max_us
+							     : CONFIG_TT_BH_ARC_DVFS_PERIOD_MAX_US;
+	dvfs_period_max_us = MAX(dvfs_period_max_us, dvfs_period_min_us);
+	dvfs_period_nominal_us =
+		CLAMP(CONFIG_TT_BH_ARC_DVFS_PERIOD_US, dvfs_period_min_us, dvfs_period_max_us);
+
+	dvfs_period_us = dvfs_period_nominal_us;
+	dvfs_forced_period_us = 0;
+	dvfs_prev_inputs_valid = false;
+	dvfs_tdp_limit = limits->tdp_limit;
+	dvfs_tdc_limit = limits->tdc_limit;
+}
+
 void InitDVFS(void)
 {
-	InitVFCurve();
 	InitVoltagePPM();
 	InitArbMaxVoltage();
 	InitThrottlers();
+	InitDVFSPeriod();
 	dvfs_enabled = true;
 }
 
-#define DVFS_MSEC 1
-
 void StartDVFSTimer(void)
 {
-	k_timer_start(&dvfs_timer, K_MSEC(DVFS_MSEC), K_MSEC(DVFS_MSEC));
+	dvfs_timer_running = true;
+	RestartDVFSTimer();
 }
 
-#define DVFS_TICKS (CONFIG_SYS_CLOCK_TICKS_PER_SEC * DVFS_MSEC / MSEC_PER_SEC)
+uint32_t GetDVFSPeriod(void)
+{
+	return dvfs_period_us;
+}
+
+/**
+ * @brief Pin the DVFS period, or let it adapt again
+ *
+ * @param period_us The period in microseconds, or 0 to adapt it to the load
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the period is outside the bounds from the FW table
+ */
+int SetDVFSPeriod(uint32_t period_us)
+{
+	if (period_us != 0 && (period_us < dvfs_period_min_us || period_us > dvfs_period_max_us)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&dvfs_lock, K_FOREVER);
+	dvfs_forced_period_us = period_us;
+	dvfs_period_us = period_us != 0 ? period_us : dvfs_period_nominal_us;
+	RestartDVFSTimer();
+	k_mutex_unlock(&dvfs_lock);
+
+	return 0;
+}
 
 /* If DVFS is already scheduled "close enough" to the board power message, then don't try to adjust
  * it. There may be some jitter in the message arrival and we don't want to suddenly go from being
  * very close to very far away. 10% is arbitrary.
  */
-#define DVFS_ADJUSTMENT_THRESHOLD (DVFS_TICKS * 10 / 100) /* 10% of DVFS interval */
+#define DVFS_ADJUSTMENT_THRESHOLD_PERCENT 10
 
-/* DVFS's PID controllers assume they are run on a 1ms interval. Changing the interval implicitly
- * changes their behaviour. 1% should be small enough to not cause trouble.
+/* The throttlers are told the period of each tick, not how long it actually took. 1% should be
+ * small enough to not cause trouble.
  */
-#define DVFS_ADJUSTMENT_STEP (DVFS_TICKS * 1 / 100) /* 1% of DVFS interval */
+#define DVFS_ADJUSTMENT_STEP_PERCENT 1
 
 void AdjustDVFSTimer(void)
 {
@@ -77,12 +260,34 @@ void AdjustDVFSTimer(void)
 	 * the DMC->DVFS latency down.
 	 */
 	if (dvfs_enabled) {
+		k_ticks_t dvfs_ticks = k_us_to_ticks_ceil64(dvfs_period_us);
 		k_ticks_t dvfs_remaining = k_timer_remaining_ticks(&dvfs_timer);
 
-		if (dvfs_remaining > DVFS_ADJUSTMENT_THRESHOLD) {
-			k_timeout_t delay = K_TICKS(dvfs_remaining - DVFS_ADJUSTMENT_STEP);
+		if (dvfs_remaining > dvfs_ticks * DVFS_ADJUSTMENT_THRESHOLD_PERCENT / 100) {
+			k_ticks_t step = MAX(dvfs_ticks * DVFS_ADJUSTMENT_STEP_PERCENT / 100, 1);
+			k_timeout_t delay = K_TICKS(dvfs_remaining - step);
 
-			k_timer_start(&dvfs_timer, delay, K_MSEC(DVFS_MSEC));
+			k_timer_start(&dvfs_timer, delay, K_USEC(dvfs_period_us));
 		}
 	}
 }
+
+/** @brief Handles the request to set the DVFS period
+ * @param[in] request The request, of type @ref set_dvfs_period_rqst
+ * @param[out] response The response to the host
+ * @return 0 for success, EINVAL if the period is outside the bounds from the FW table
+ */
+static uint8_t set_dvfs_period_handler(const union request *request, struct response *response)
+{
+	if (SetDVFSPeriod(request->set_dvfs_period.period_us) != 0) {
+		return EINVAL;
+	}
+
+	response->data[1] = dvfs_period_us;
+	response->data[2] = dvfs_period_min_us;
+	response->data[3] = dvfs_period_max_us;
+
+	return 0;
+}
+
+REGISTER_MESSAGE(TT_SMC_MSG_SET_DVFS_PERIOD, set_dvfs_period_handler);
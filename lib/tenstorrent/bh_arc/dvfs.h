@@ -7,12 +7,20 @@
 #define DVFS_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "throttler.h"
 
 extern bool dvfs_enabled;
 
 void InitDVFS(void);
+void InitDVFSPeriod(void);
 void StartDVFSTimer(void);
 void AdjustDVFSTimer(void);
+void CalculateDVFSTargets(void);
+uint32_t DVFSStep(const ThrottlerInputs *inputs);
 void DVFSChange(void);
+uint32_t GetDVFSPeriod(void);
+int SetDVFSPeriod(uint32_t period_us);
 
 #endif
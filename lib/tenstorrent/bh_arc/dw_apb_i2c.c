@@ -4,7 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/devicetree.h>
 #include <zephyr/drivers/i2c.h>
+#include <zephyr/init.h>
+#include <zephyr/irq.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
 #include <string.h>
 #include "timer.h"
 #include "dw_apb_i2c.h"
@@ -39,7 +44,14 @@
 #define DW_APB_I2C_IC_SDA_HOLD_REG_OFFSET                   0x0000007C
 #define DW_APB_I2C_IC_FS_SCL_HCNT_REG_OFFSET                0x0000001C
 #define DW_APB_I2C_IC_FS_SCL_LCNT_REG_OFFSET                0x00000020
+#define DW_APB_I2C_IC_INTR_STAT_REG_OFFSET                  0x0000002C
+#define DW_APB_I2C_IC_INTR_MASK_REG_OFFSET                  0x00000030
 #define DW_APB_I2C_IC_RAW_INTR_STAT_REG_OFFSET              0x00000034
+#define DW_APB_I2C_IC_RX_TL_REG_OFFSET                      0x00000038
+#define DW_APB_I2C_IC_CLR_INTR_REG_OFFSET                   0x00000040
+#define DW_APB_I2C_IC_TXFLR_REG_OFFSET                      0x00000074
+#define DW_APB_I2C_IC_RXFLR_REG_OFFSET                      0x00000078
+#define DW_APB_I2C_IC_COMP_PARAM_1_REG_OFFSET               0x000000F4
 #define DW_APB_I2C_IC_CLR_RX_OVER_REG_OFFSET                0x00000048
 #define DW_APB_I2C_IC_CLR_RD_REQ_REG_OFFSET                 0x00000050
 #define DW_APB_I2C_IC_CLR_STOP_DET_REG_OFFSET               0x00000060
@@ -59,6 +71,8 @@
 #define DW_APB_I2C_IC_SAR_IC_SAR_MASK           0x3FF
 #define DW_APB_I2C_IC_CON_IC_RESTART_EN_MASK    0x20
 #define DW_APB_I2C_IC_CON_IC_SLAVE_DISABLE_MASK 0x40
+#define DW_APB_I2C_IC_COMP_PARAM_1_RX_DEPTH_MASK GENMASK(15, 8)
+#define DW_APB_I2C_IC_COMP_PARAM_1_TX_DEPTH_MASK GENMASK(23, 16)
 
 #define DW_APB_I2C_IC_CON_SPEED_SHIFT     1
 #define DW_APB_I2C_IC_DATA_CMD_CMD_SHIFT  8
@@ -86,9 +100,31 @@
 /* starting from bit21, bit20-0 is reserved. */
 #define IC_ABRT_A3_STATE (0x1 << 21)
 #define IC_VERIFY_FAIL (0x1 << 22)
+#define IC_ABRT_BUSY     (0x1 << 23) /* another transfer was in flight on the controller */
+#define IC_ABRT_TIMEOUT  (0x1 << 24) /* the transfer did not complete in time */
+
+/* Interrupt bits, the same in IC_INTR_STAT, IC_INTR_MASK and IC_RAW_INTR_STAT. The controller
+ * also has one interrupt line per bit, in the same order.
+ */
+#define IC_INTR_RX_FULL_BIT  2
+#define IC_INTR_TX_EMPTY_BIT 4
+#define IC_INTR_TX_ABRT_BIT  6
+#define IC_INTR_STOP_DET_BIT 9
+#define IC_INTR_RX_FULL      BIT(IC_INTR_RX_FULL_BIT)
+#define IC_INTR_TX_EMPTY     BIT(IC_INTR_TX_EMPTY_BIT)
+#define IC_INTR_TX_ABRT      BIT(IC_INTR_TX_ABRT_BIT)
+#define IC_INTR_STOP_DET     BIT(IC_INTR_STOP_DET_BIT)
 
 #define GET_I2C_OFFSET(REG_NAME) DW_APB_I2C_##REG_NAME##_REG_OFFSET
 
+#define NUM_I2C_CONTROLLERS 3
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 typedef struct {
 	uint32_t master_mode: 1;
 	uint32_t speed: 2;
@@ -153,7 +189,49 @@ typedef union {
 
 extern uint8_t asic_state;
 /* i2c_target_config for Zephyr callbacks in I2C slave mode */
-struct i2c_target_config i2c_target_config[3];
+struct i2c_target_config i2c_target_config[NUM_I2C_CONTROLLERS];
+
+/* State of the interrupt-driven master transfer on each controller. Commands are pushed to the
+ * TX FIFO in order: write_len writes followed by read_len reads.
+ */
+struct i2c_xfer {
+	const uint8_t *write_data;
+	uint8_t *read_data;
+	uint32_t write_len;
+	uint32_t read_len;
+	uint32_t cmds_sent;
+	uint32_t bytes_read;
+	uint32_t tx_depth;
+	uint32_t rx_depth;
+	uint32_t intr_mask;
+	I2CCallback callback;
+	void *user_data;
+	bool busy;
+};
+
+static struct i2c_xfer i2c_xfer[NUM_I2C_CONTROLLERS];
+
+/* Set once the interrupts of a controller are connected */
+STATIC bool i2c_irq_enabled[NUM_I2C_CONTROLLERS];
+
+/* Master configuration each controller was last initialized with, so that I2CInit can skip
+ * controllers that are already set up for the same target.
+ */
+struct i2c_master_config {
+	bool valid;
+	uint32_t slave_addr;
+	I2CSpeedMode speed;
+};
+
+static struct i2c_master_config i2c_master_config[NUM_I2C_CONTROLLERS];
+
+/* Held across I2CInit and the transactions to the target it selects, see I2CLock */
+static K_MUTEX_DEFINE(i2c0_lock);
+static K_MUTEX_DEFINE(i2c1_lock);
+static K_MUTEX_DEFINE(i2c2_lock);
+
+static struct k_mutex *const i2c_lock[NUM_I2C_CONTROLLERS] = {&i2c0_lock, &i2c1_lock,
+							      &i2c2_lock};
 
 static inline uint32_t GetI2CBaseAddress(uint32_t id)
 {
@@ -212,6 +290,8 @@ static inline uint32_t GetI2CPadDataAddr(uint32_t id)
 /* Bitbang recovery sequence on I2C bus */
 void I2CRecoverBus(uint32_t id)
 {
+	i2c_master_config[id].valid = false;
+
 	uint32_t drive_strength = 0x7F; /* 50% of max 0xFF */
 	uint32_t i2c_cntl = (drive_strength << RESET_UNIT_I2C_PAD_CNTL_DRV_SHIFT) |
 				RESET_UNIT_I2C_PAD_CNTL_TRIEN_MASK;
@@ -410,13 +490,37 @@ void I2CInitGPIO(uint32_t id)
 	WriteReg(RESET_UNIT_I2C_CNTL_REG_ADDR, i2c_cntl | 1 << id);
 }
 
-/* Initialize I2C controller by setting up I2C pads and configuration settings. */
-void I2CInit(I2CMode mode, uint32_t slave_addr, I2CSpeedMode speed, uint32_t id)
+/* Threads sharing a controller must hold it from I2CInit until the end of their transactions,
+ * so that nobody retargets the controller in between. The lock nests, and is a no-op before the
+ * kernel starts or from an ISR.
+ */
+void I2CLock(uint32_t id)
+{
+	if (id < NUM_I2C_CONTROLLERS && !k_is_pre_kernel() && !k_is_in_isr()) {
+		k_mutex_lock(i2c_lock[id], K_FOREVER);
+	}
+}
+
+void I2CUnlock(uint32_t id)
+{
+	if (id < NUM_I2C_CONTROLLERS && !k_is_pre_kernel() && !k_is_in_isr()) {
+		k_mutex_unlock(i2c_lock[id]);
+	}
+}
+
+static void I2CInitController(I2CMode mode, uint32_t slave_addr, I2CSpeedMode speed, uint32_t id)
 {
 	if (asic_state == A3State) {
 		return;
 	}
 
+	struct i2c_master_config *master_config = &i2c_master_config[id];
+
+	if (mode == I2CMst && master_config->valid && master_config->slave_addr == slave_addr &&
+	    master_config->speed == speed) {
+		return;
+	}
+
 	WaitTxFifoEmpty(id);
 	WaitMasterIdle(id);
 
@@ -427,6 +531,9 @@ void I2CInit(I2CMode mode, uint32_t slave_addr, I2CSpeedMode speed, uint32_t id)
 	Wait(10 * WAIT_1US);
 	/* lower the number of wait cycles for idle bus from 0xffff (default) to 0xf for now */
 	WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_SMBUS_THIGH_MAX_IDLE_COUNT)), 0xf);
+	/* interrupts are only unmasked while a transfer is in flight */
+	WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_INTR_MASK)), 0);
+	i2c_xfer[id].intr_mask = 0;
 	/* program interrupt FIFO threshold */
 
 	if (mode == I2CMst) {
@@ -469,6 +576,20 @@ void I2CInit(I2CMode mode, uint32_t slave_addr, I2CSpeedMode speed, uint32_t id)
 
 	WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_ENABLE)), 1);
 	Wait(10 * WAIT_1US);
+
+	*master_config = (struct i2c_master_config){
+		.valid = mode == I2CMst,
+		.slave_addr = slave_addr,
+		.speed = speed,
+	};
+}
+
+/* Initialize I2C controller by setting up I2C pads and configuration settings. */
+void I2CInit(I2CMode mode, uint32_t slave_addr, I2CSpeedMode speed, uint32_t id)
+{
+	I2CLock(id);
+	I2CInitController(mode, slave_addr, speed, id);
+	I2CUnlock(id);
 }
 
 /* Resets the all I2C controller instances */
@@ -476,22 +597,275 @@ void I2CReset(void)
 {
 	uint32_t i2c_cntl = ReadReg(RESET_UNIT_I2C_CNTL_REG_ADDR);
 
+	memset(i2c_master_config, 0, sizeof(i2c_master_config));
 	WriteReg(RESET_UNIT_I2C_CNTL_REG_ADDR, i2c_cntl | RESET_UNIT_I2C_CNTL_RESET_MASK);
 	Wait(WAIT_1US);
 	WriteReg(RESET_UNIT_I2C_CNTL_REG_ADDR, i2c_cntl & ~RESET_UNIT_I2C_CNTL_RESET_MASK);
 	Wait(WAIT_1US);
 }
 
-/* Generalized transaction function called by I2CWriteBytes and I2CReadBytes, implements SMBUS write
- * bytes and read bytes protocols, returns TX_ABRT error if any, otherwise returns 0.
+/* Only write IC_INTR_MASK when it changes, the interrupt handler recomputes it every time */
+static void I2CSetIntrMask(uint32_t id, uint32_t intr_mask)
+{
+	if (i2c_xfer[id].intr_mask != intr_mask) {
+		WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_INTR_MASK)), intr_mask);
+		i2c_xfer[id].intr_mask = intr_mask;
+	}
+}
+
+static void I2CFinishTransfer(uint32_t id, uint32_t ic_error)
+{
+	struct i2c_xfer *xfer = &i2c_xfer[id];
+	I2CCallback callback = xfer->callback;
+	void *user_data = xfer->user_data;
+
+	I2CSetIntrMask(id, 0);
+	xfer->busy = false;
+
+	/* The callback may start the next transfer */
+	if (callback != NULL) {
+		callback(id, ic_error, user_data);
+	}
+}
+
+static void I2CDrainRxFifo(uint32_t id)
+{
+	struct i2c_xfer *xfer = &i2c_xfer[id];
+	uint32_t rx_level = ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_RXFLR)));
+
+	for (uint32_t i = 0; i < rx_level && xfer->bytes_read < xfer->read_len; i++) {
+		xfer->read_data[xfer->bytes_read++] =
+			ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_DATA_CMD)));
+	}
+}
+
+/* Push as many commands as fit in the TX FIFO, without issuing more reads than the RX FIFO can
+ * hold. TX_EMPTY stays unmasked only while there are commands left that could be pushed.
  */
-uint32_t I2CTransaction(uint32_t id, const uint8_t *write_data, uint32_t write_len,
-			uint8_t *read_data, uint32_t read_len)
+static void I2CFillTxFifo(uint32_t id)
+{
+	struct i2c_xfer *xfer = &i2c_xfer[id];
+	uint32_t total = xfer->write_len + xfer->read_len;
+	uint32_t tx_level = ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_TXFLR)));
+	uint32_t tx_space = xfer->tx_depth - MIN(tx_level, xfer->tx_depth);
+	bool rx_full = false;
+
+	while (tx_space > 0 && xfer->cmds_sent < total) {
+		uint32_t last_byte_flag = xfer->cmds_sent == total - 1 ? IC_DATA_STOP : 0;
+		uint32_t data;
+
+		if (xfer->cmds_sent < xfer->write_len) {
+			data = xfer->write_data[xfer->cmds_sent] | IC_DATA_WRITE;
+		} else {
+			uint32_t reads_sent = xfer->cmds_sent - xfer->write_len;
+
+			rx_full = reads_sent - xfer->bytes_read >= xfer->rx_depth;
+			if (rx_full) {
+				break;
+			}
+			data = IC_DATA_READ;
+		}
+
+		WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_DATA_CMD)), data | last_byte_flag);
+		xfer->cmds_sent++;
+		tx_space--;
+	}
+
+	/* Once blocked on the RX FIFO, the next RX_FULL refills the TX FIFO */
+	bool tx_pending = xfer->cmds_sent < total && !rx_full;
+
+	I2CSetIntrMask(id, IC_INTR_TX_ABRT | IC_INTR_STOP_DET |
+				   (xfer->read_len > 0 ? IC_INTR_RX_FULL : 0) |
+				   (tx_pending ? IC_INTR_TX_EMPTY : 0));
+}
+
+/* Advance the transfer on a controller, called from its interrupts */
+STATIC void I2CServiceTransfer(uint32_t id)
+{
+	struct i2c_xfer *xfer = &i2c_xfer[id];
+	uint32_t intr_stat = ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_INTR_STAT)));
+
+	if (!xfer->busy) {
+		/* Spurious, e.g. the mask came back up after I2CReset */
+		WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_INTR_MASK)), 0);
+		xfer->intr_mask = 0;
+		return;
+	}
+
+	if (intr_stat & IC_INTR_TX_ABRT) {
+		/* The controller flushes the TX FIFO and ends the transfer with a STOP */
+		I2CFinishTransfer(id, CheckTxAbrt(id));
+		return;
+	}
+
+	if (xfer->bytes_read < xfer->read_len) {
+		I2CDrainRxFifo(id);
+	}
+
+	if (xfer->cmds_sent < xfer->write_len + xfer->read_len) {
+		I2CFillTxFifo(id);
+	}
+
+	if (intr_stat & IC_INTR_STOP_DET) {
+		ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_CLR_STOP_DET)));
+
+		if (xfer->cmds_sent == xfer->write_len + xfer->read_len &&
+		    xfer->bytes_read == xfer->read_len) {
+			I2CFinishTransfer(id, 0);
+		}
+	}
+}
+
+/* Start an interrupt-driven transfer on the I2C master id, with the same protocol as
+ * I2CTransaction. Returns 0 once started, after which callback is called from interrupt context
+ * with the TX_ABRT error if any, otherwise 0. The buffers must stay valid until then.
+ * Returns -EBUSY if a transfer is already in flight on the controller.
+ */
+int I2CTransactionAsync(uint32_t id, const uint8_t *write_data, uint32_t write_len,
+			uint8_t *read_data, uint32_t read_len, I2CCallback callback,
+			void *user_data)
 {
+	if (!IsValidI2CMasterId(id) || write_len + read_len == 0) {
+		return -EINVAL;
+	}
+
 	if (asic_state == A3State) {
-		return IC_ABRT_A3_STATE;
+		return -EPERM;
+	}
+
+	struct i2c_xfer *xfer = &i2c_xfer[id];
+	unsigned int key = irq_lock();
+
+	if (xfer->busy) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+	xfer->busy = true;
+	irq_unlock(key);
+
+	if (xfer->tx_depth == 0) {
+		uint32_t param = ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_COMP_PARAM_1)));
+
+		xfer->tx_depth = FIELD_GET(DW_APB_I2C_IC_COMP_PARAM_1_TX_DEPTH_MASK, param) + 1;
+		xfer->rx_depth = FIELD_GET(DW_APB_I2C_IC_COMP_PARAM_1_RX_DEPTH_MASK, param) + 1;
+	}
+
+	xfer->write_data = write_data;
+	xfer->write_len = write_len;
+	xfer->read_data = read_data;
+	xfer->read_len = read_len;
+	xfer->cmds_sent = 0;
+	xfer->bytes_read = 0;
+	xfer->callback = callback;
+	xfer->user_data = user_data;
+
+	/* RX_FULL fires for every received byte, STOP_DET picks up any stragglers */
+	WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_RX_TL)), 0);
+	ReadReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_CLR_INTR)));
+	/* TX_EMPTY fires straight away and the interrupt handler fills the TX FIFO */
+	I2CSetIntrMask(id, IC_INTR_TX_EMPTY | IC_INTR_TX_ABRT | IC_INTR_STOP_DET |
+				   (read_len > 0 ? IC_INTR_RX_FULL : 0));
+
+	return 0;
+}
+
+/* Stop servicing the transfer on a controller, returns false if it had already completed */
+static bool I2CCancelTransfer(uint32_t id)
+{
+	unsigned int key = irq_lock();
+	bool cancelled = i2c_xfer[id].busy;
+
+	if (cancelled) {
+		I2CSetIntrMask(id, 0);
+		i2c_xfer[id].busy = false;
 	}
+	irq_unlock(key);
 
+	return cancelled;
+}
+
+/* Maps a failure to start a transfer to the IC_ABRT_* bits */
+static uint32_t I2CStartError(int ret)
+{
+	return ret == -EPERM ? IC_ABRT_A3_STATE : IC_ABRT_BUSY;
+}
+
+struct i2c_sync_transfer {
+	struct k_sem done;
+	uint32_t ic_error;
+
+	/* Remaining reads of an I2CReadBytesBatch */
+	const uint8_t *commands;
+	uint8_t *read_buf;
+	uint32_t count;
+	uint32_t data_byte_size;
+	uint32_t next;
+};
+
+static void I2CSyncTransferDone(uint32_t id, uint32_t ic_error, void *user_data)
+{
+	struct i2c_sync_transfer *sync = user_data;
+
+	/* Chain the next read of a batch straight from the interrupt */
+	if (ic_error == 0 && sync->next < sync->count) {
+		uint32_t i = sync->next++;
+		int ret = I2CTransactionAsync(id, &sync->commands[i], 1,
+					      &sync->read_buf[i * sync->data_byte_size],
+					      sync->data_byte_size, I2CSyncTransferDone, sync);
+
+		if (ret == 0) {
+			return;
+		}
+		ic_error = I2CStartError(ret);
+	}
+
+	sync->ic_error = ic_error;
+	k_sem_give(&sync->done);
+}
+
+/* Sleep until the transfers started on sync complete */
+static uint32_t I2CWaitTransfer(uint32_t id, struct i2c_sync_transfer *sync,
+				uint32_t num_transfers)
+{
+	k_timeout_t timeout = COND_CODE_1(
+		CONFIG_TT_BH_ARC_I2C_TIMEOUT,
+		(K_MSEC(CONFIG_TT_BH_ARC_I2C_TIMEOUT_DURATION * num_transfers)), (K_FOREVER));
+
+	if (k_sem_take(&sync->done, timeout) != 0 && I2CCancelTransfer(id)) {
+		I2CRecoverBus(id);
+		return IC_ABRT_TIMEOUT;
+	}
+
+	return sync->ic_error;
+}
+
+/* Run a transfer from the interrupts, sleeping until it completes */
+static uint32_t I2CTransactionIrq(uint32_t id, const uint8_t *write_data, uint32_t write_len,
+				  uint8_t *read_data, uint32_t read_len)
+{
+	struct i2c_sync_transfer sync = {0};
+
+	k_sem_init(&sync.done, 0, 1);
+
+	int ret = I2CTransactionAsync(id, write_data, write_len, read_data, read_len,
+				      I2CSyncTransferDone, &sync);
+
+	if (ret != 0) {
+		return I2CStartError(ret);
+	}
+
+	return I2CWaitTransfer(id, &sync, 1);
+}
+
+static bool I2CUseInterrupts(uint32_t id)
+{
+	return IS_ENABLED(CONFIG_TT_BH_ARC_I2C_INTERRUPT) && i2c_irq_enabled[id] &&
+	       !k_is_pre_kernel() && !k_is_in_isr();
+}
+
+static uint32_t I2CTransactionPolled(uint32_t id, const uint8_t *write_data, uint32_t write_len,
+				     uint8_t *read_data, uint32_t read_len)
+{
 	/* Writing */
 	for (uint32_t i = 0; i < write_len; i++) {
 		uint32_t last_byte_flag = (read_len == 0 && i == write_len - 1) ? IC_DATA_STOP : 0;
@@ -528,6 +902,30 @@ uint32_t I2CTransaction(uint32_t id, const uint8_t *write_data, uint32_t write_l
 	return ic_error;
 }
 
+/* Generalized transaction function called by I2CWriteBytes and I2CReadBytes, implements SMBUS write
+ * bytes and read bytes protocols, returns TX_ABRT error if any, otherwise returns 0. Failures to
+ * run the transfer at all are reported with the IC_ABRT_* bits above the TX_ABRT sources.
+ */
+uint32_t I2CTransaction(uint32_t id, const uint8_t *write_data, uint32_t write_len,
+			uint8_t *read_data, uint32_t read_len)
+{
+	if (asic_state == A3State) {
+		return IC_ABRT_A3_STATE;
+	}
+
+	uint32_t ic_error;
+
+	I2CLock(id);
+	if (I2CUseInterrupts(id)) {
+		ic_error = I2CTransactionIrq(id, write_data, write_len, read_data, read_len);
+	} else {
+		ic_error = I2CTransactionPolled(id, write_data, write_len, read_data, read_len);
+	}
+	I2CUnlock(id);
+
+	return ic_error;
+}
+
 uint32_t I2CWriteBytes(uint32_t id, uint16_t command, uint32_t command_byte_size,
 		       const uint8_t *p_write_buf, uint32_t data_byte_size)
 {
@@ -557,11 +955,8 @@ uint32_t I2CReadBytes(uint32_t id, uint16_t command, uint32_t command_byte_size,
 	return ic_error;
 }
 
-/**
- * @brief I2C Read-Modify-Write-Verify
- */
-uint32_t I2CRMWV(uint32_t id, uint16_t command, uint32_t command_byte_size, const uint8_t *p_data,
-		 const uint8_t *p_mask, uint32_t data_byte_size)
+static uint32_t I2CRMWVLocked(uint32_t id, uint16_t command, uint32_t command_byte_size,
+			      const uint8_t *p_data, const uint8_t *p_mask, uint32_t data_byte_size)
 {
 	uint32_t ic_error;
 	uint8_t buffer[data_byte_size];
@@ -598,6 +993,64 @@ uint32_t I2CRMWV(uint32_t id, uint16_t command, uint32_t command_byte_size, cons
 	return 0;
 }
 
+/* Reads data_byte_size bytes from each of count single-byte commands into consecutive
+ * data_byte_size slots of p_read_buf, stopping at the first error. The controller stays locked for
+ * the whole batch. From interrupts, each read is started as soon as the previous one completes
+ * and the caller only wakes up at the end.
+ */
+uint32_t I2CReadBytesBatch(uint32_t id, const uint8_t *commands, uint32_t count,
+			   uint8_t *p_read_buf, uint32_t data_byte_size)
+{
+	if (asic_state == A3State) {
+		return IC_ABRT_A3_STATE;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	uint32_t ic_error = 0;
+
+	I2CLock(id);
+	if (I2CUseInterrupts(id)) {
+		struct i2c_sync_transfer sync = {
+			.commands = commands,
+			.read_buf = p_read_buf,
+			.count = count,
+			.data_byte_size = data_byte_size,
+		};
+
+		k_sem_init(&sync.done, 0, 1);
+		/* Starts the first read */
+		I2CSyncTransferDone(id, 0, &sync);
+
+		ic_error = I2CWaitTransfer(id, &sync, count);
+	} else {
+		for (uint32_t i = 0; i < count && ic_error == 0; i++) {
+			ic_error = I2CTransactionPolled(id, &commands[i], 1,
+							&p_read_buf[i * data_byte_size],
+							data_byte_size);
+		}
+	}
+	I2CUnlock(id);
+
+	return ic_error;
+}
+
+/**
+ * @brief I2C Read-Modify-Write-Verify
+ */
+uint32_t I2CRMWV(uint32_t id, uint16_t command, uint32_t command_byte_size, const uint8_t *p_data,
+		 const uint8_t *p_mask, uint32_t data_byte_size)
+{
+	I2CLock(id);
+	uint32_t ic_error =
+		I2CRMWVLocked(id, command, command_byte_size, p_data, p_mask, data_byte_size);
+	I2CUnlock(id);
+
+	return ic_error;
+}
+
 void SetI2CSlaveCallbacks(uint32_t id, const struct i2c_target_callbacks *cb)
 {
 	i2c_target_config[id].callbacks = cb;
@@ -662,3 +1115,35 @@ void PollI2CSlave(uint32_t id)
 		}
 	}
 }
+
+#if defined(CONFIG_TT_BH_ARC_I2C_INTERRUPT) && defined(CONFIG_BOARD_TT_BLACKHOLE)
+static void I2CIsr(const void *arg)
+{
+	I2CServiceTransfer((uint32_t)(uintptr_t)arg);
+}
+
+#define I2C_IRQ_CONNECT(node, id, bit)                                                             \
+	IRQ_CONNECT(DT_IRQN_BY_IDX(node, bit), DT_IRQ_BY_IDX(node, bit, priority), I2CIsr,         \
+		    (void *)(id), 0);                                                              \
+	irq_enable(DT_IRQN_BY_IDX(node, bit))
+
+#define I2C_IRQS_CONNECT(node, id)                                                                 \
+	do {                                                                                       \
+		WriteReg(GetI2CRegAddr(id, GET_I2C_OFFSET(IC_INTR_MASK)), 0);                      \
+		I2C_IRQ_CONNECT(node, id, IC_INTR_RX_FULL_BIT);                                    \
+		I2C_IRQ_CONNECT(node, id, IC_INTR_TX_EMPTY_BIT);                                   \
+		I2C_IRQ_CONNECT(node, id, IC_INTR_TX_ABRT_BIT);                                    \
+		I2C_IRQ_CONNECT(node, id, IC_INTR_STOP_DET_BIT);                                   \
+		i2c_irq_enabled[id] = true;                                                        \
+	} while (0)
+
+static int I2CInitInterrupts(void)
+{
+	I2C_IRQS_CONNECT(DT_NODELABEL(i2c0), 0);
+	I2C_IRQS_CONNECT(DT_NODELABEL(i2c1), 1);
+	I2C_IRQS_CONNECT(DT_NODELABEL(i2c2), 2);
+
+	return 0;
+}
+SYS_INIT(I2CInitInterrupts, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
@@ -22,17 +22,27 @@ typedef enum {
 	I2CFastMode = 2,
 } I2CSpeedMode;
 
+/* Completion of I2CTransactionAsync, called from interrupt context */
+typedef void (*I2CCallback)(uint32_t id, uint32_t ic_error, void *user_data);
+
 bool IsValidI2CMasterId(uint32_t id);
 void I2CInitGPIO(uint32_t id);
+void I2CLock(uint32_t id);
+void I2CUnlock(uint32_t id);
 void I2CInit(I2CMode mode, uint32_t slave_addr, I2CSpeedMode speed, uint32_t id);
 void I2CReset(void);
 uint32_t I2CReadRxFifo(uint32_t id, uint8_t *p_read_buf);
 uint32_t I2CTransaction(uint32_t id, const uint8_t *write_data, uint32_t write_len,
 			uint8_t *read_data, uint32_t read_len);
+int I2CTransactionAsync(uint32_t id, const uint8_t *write_data, uint32_t write_len,
+			uint8_t *read_data, uint32_t read_len, I2CCallback callback,
+			void *user_data);
 uint32_t I2CWriteBytes(uint32_t id, uint16_t command, uint32_t command_byte_size,
 		       const uint8_t *p_write_buf, uint32_t data_byte_size);
 uint32_t I2CReadBytes(uint32_t id, uint16_t command, uint32_t command_byte_size,
 		      uint8_t *p_read_buf, uint32_t data_byte_size, uint8_t flip_bytes);
+uint32_t I2CReadBytesBatch(uint32_t id, const uint8_t *commands, uint32_t count,
+			   uint8_t *p_read_buf, uint32_t data_byte_size);
 uint32_t I2CRMWV(uint32_t id, uint16_t command, uint32_t command_byte_size, const uint8_t *p_data,
 			const uint8_t *p_mask, uint32_t data_byte_size);
 void SetI2CSlaveCallbacks(uint32_t id, const struct i2c_target_callbacks *cb);
@@ -28,7 +28,6 @@
 
 LOG_MODULE_REGISTER(eth, CONFIG_TT_APP_LOG_LEVEL);
 
-#define ETH_SETUP_TLB  0
 #define ETH_PARAM_ADDR 0x7c000
 
 #define ERISC_L1_SIZE (512 * 1024)
@@ -51,6 +50,8 @@ static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash
 static const struct device *const arc_dma_dev = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma0));
 static const struct device *dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 
+#define WIPE_TIMEOUT_MS 50
+
 typedef struct {
 	uint32_t sd_mode_sel_0: 1;
 	uint32_t sd_mode_sel_1: 1;
@@ -72,14 +73,14 @@ typedef union {
 #define RESET_UNIT_PCIE1_MISC_CNTL_3_REG_ADDR 0x8003050C
 #define RESET_UNIT_PCIE_MISC_CNTL_3_REG_ADDR  0x8003009C
 
-static inline void SetupEthTlb(uint32_t eth_inst, uint32_t ring, uint64_t addr)
+static inline uint8_t AcquireEthTlb(uint32_t eth_inst, uint32_t ring, uint64_t addr)
 {
 	/* Logical X,Y coordinates */
 	uint8_t x, y;
 
 	GetEthNocCoords(eth_inst, ring, &x, &y);
 
-	NOC2AXITlbSetup(ring, ETH_SETUP_TLB, x, y, addr);
+	return NOC2AXITlbAcquire(ring, x, y, addr);
 }
 
 void SetupEthSerdesMux(uint32_t eth_enabled)
@@ -197,11 +198,12 @@ uint64_t GetMacAddressBase(void)
 
 void ReleaseEthReset(uint32_t eth_inst, uint32_t ring)
 {
-	SetupEthTlb(eth_inst, ring, ETH_RESET_PC_0);
+	uint8_t tlb = AcquireEthTlb(eth_inst, ring, ETH_RESET_PC_0);
 
-	volatile uint32_t *soft_reset_0 =
-		GetTlbWindowAddr(ring, ETH_SETUP_TLB, ETH_RISC_DEBUG_SOFT_RESET_0);
+	volatile uint32_t *soft_reset_0 = GetTlbWindowAddr(ring, tlb, ETH_RISC_DEBUG_SOFT_RESET_0);
 	*soft_reset_0 &= ~(1 << 11); /* Clear bit for RISC0 reset, leave RISC1 in reset still */
+
+	NOC2AXITlbRelease(ring, tlb);
 }
 
 int LoadEthFw(uint32_t eth_inst, uint32_t ring, uint8_t *buf, size_t buf_size, size_t spi_address,
@@ -211,17 +213,20 @@ int LoadEthFw(uint32_t eth_inst, uint32_t ring, uint8_t *buf, size_t buf_size, s
 	/* uint32_t fw_load_addr = ((ETH_PARAM_ADDR - fw_size) >> 2) << 2; */
 	uint32_t fw_load_addr = 0x00070000;
 
-	SetupEthTlb(eth_inst, ring, fw_load_addr);
-	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, ETH_SETUP_TLB, fw_load_addr);
+	uint8_t tlb = AcquireEthTlb(eth_inst, ring, fw_load_addr);
+	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, tlb, fw_load_addr);
+	int rc = spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
+					      (uint8_t *)eth_tlb);
 
-	if (spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
-					 (uint8_t *)eth_tlb)) {
+	NOC2AXITlbRelease(ring, tlb);
+	if (rc) {
 		return -1;
 	}
 
-	SetupEthTlb(eth_inst, ring, ETH_RESET_PC_0);
-	NOC2AXIWrite32(ring, ETH_SETUP_TLB, ETH_RESET_PC_0, fw_load_addr);
-	NOC2AXIWrite32(ring, ETH_SETUP_TLB, ETH_END_PC_0, ETH_PARAM_ADDR - 0x4);
+	tlb = AcquireEthTlb(eth_inst, ring, ETH_RESET_PC_0);
+	NOC2AXIWrite32(ring, tlb, ETH_RESET_PC_0, fw_load_addr);
+	NOC2AXIWrite32(ring, tlb, ETH_END_PC_0, ETH_PARAM_ADDR - 0x4);
+	NOC2AXITlbRelease(ring, tlb);
 
 	return 0;
 }
@@ -282,11 +287,12 @@ int LoadEthFwCfg(uint32_t eth_inst, uint32_t ring, uint8_t *buf, uint32_t eth_en
 	fw_cfg_32b[40] = tile_enable.eth_enabled;
 
 	/* Write the ETH Param table */
-	SetupEthTlb(eth_inst, ring, ETH_PARAM_ADDR);
-	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, ETH_SETUP_TLB, ETH_PARAM_ADDR);
+	uint8_t tlb = AcquireEthTlb(eth_inst, ring, ETH_PARAM_ADDR);
+	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, tlb, ETH_PARAM_ADDR);
 
-	if (dma_arc_hs_transfer(arc_dma_dev, 0, buf, (void *)eth_tlb, image_size, K_MSEC(500)) <
-	    0) {
+	rc = dma_arc_hs_transfer(arc_dma_dev, 0, buf, (void *)eth_tlb, image_size, K_MSEC(500));
+	NOC2AXITlbRelease(ring, tlb);
+	if (rc < 0) {
 		LOG_ERR("DMA transfer failed");
 		return -1;
 	}
@@ -356,7 +362,7 @@ static void SerdesEthInit(void)
 }
 
 /* This function assumes that tensix L1s have already been cleared */
-static void wipe_l1(void)
+static int wipe_l1(void)
 {
 	uint8_t noc_id = 0;
 	uint64_t addr = 0;
@@ -367,36 +373,44 @@ static void wipe_l1(void)
 	struct tt_bh_dma_noc_coords coords =
 		tt_bh_dma_noc_coords_init(tensix_x, tensix_y, 0, 0);
 
-	struct dma_block_config block = {
-		.source_address = addr,
-		.dest_address = addr,
-		.block_size = ERISC_L1_SIZE,
-	};
+	/* One block per ETH tile, all copied from the same Tensix L1 in a single chain */
+	static struct tt_bh_dma_noc_scatter_block blocks[MAX_ETH_INSTANCES];
+	uint32_t block_count = 0;
+
+	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
+		if (tile_enable.eth_enabled & BIT(eth_inst)) {
+			struct tt_bh_dma_noc_scatter_block *block = &blocks[block_count++];
+
+			GetEthNocCoords(eth_inst, noc_id, &block->dest_x, &block->dest_y);
+			block->block = (struct dma_block_config){
+				.source_address = addr,
+				.dest_address = addr,
+				.block_size = ERISC_L1_SIZE,
+			};
+		}
+	}
 
 	struct dma_config config = {
-		.channel_direction = PERIPHERAL_TO_MEMORY,
+		.channel_direction = TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER,
 		.source_data_size = 1,
 		.dest_data_size = 1,
 		.source_burst_length = 1,
 		.dest_burst_length = 1,
-		.block_count = 1,
-		.head_block = &block,
+		.block_count = block_count,
+		.head_block = tt_bh_dma_noc_scatter_link(blocks, block_count),
 		.user_data = &coords,
 	};
 
-	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
-		if (tile_enable.eth_enabled & BIT(eth_inst)) {
-			uint8_t x, y;
-
-			GetEthNocCoords(eth_inst, noc_id, &x, &y);
+	int ret = dma_config(dma_noc, 1, &config);
 
-			coords.dest_x = x;
-			coords.dest_y = y;
-
-			dma_config(dma_noc, 1, &config);
-			dma_start(dma_noc, 1);
-		}
+	if (ret == 0) {
+		ret = dma_start(dma_noc, 1);
 	}
+	if (ret == 0) {
+		ret = tt_bh_dma_noc_wait(dma_noc, 1, K_MSEC(WIPE_TIMEOUT_MS));
+	}
+
+	return ret;
 }
 
 static void EthInit(void)
@@ -412,7 +426,11 @@ static void EthInit(void)
 		return;
 	}
 
-	wipe_l1();
+	rc = wipe_l1();
+	if (rc != 0) {
+		LOG_ERR("%s() failed: %d", "wipe_l1", rc);
+		return;
+	}
 
 	uint8_t buf[SCRATCHPAD_SIZE] __aligned(4);
 
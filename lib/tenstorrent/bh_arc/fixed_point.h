@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+/* Signed 16.16 fixed point, used by the DVFS loop to avoid software float on the ARC.
+ * The range of +/-32767 covers every frequency (MHz), voltage (mV), power (W), current (A) and
+ * temperature (degC) the loop handles.
+ */
+typedef int32_t q16_t;
+
+#define Q16_SHIFT 16
+#define Q16_ONE   (1 << Q16_SHIFT)
+
+/* Compile-time conversion of a float constant, rounded to nearest */
+#define Q16_CONST(x) ((q16_t)((x) * Q16_ONE + ((x) < 0 ? -0.5 : 0.5)))
+
+static inline q16_t q16_from_int(int32_t x)
+{
+	return (q16_t)(x * Q16_ONE);
+}
+
+/* Saturates, so that out-of-range sensor readings still produce a usable error term */
+static inline q16_t q16_from_float(float x)
+{
+	if (x >= INT16_MAX) {
+		return q16_from_int(INT16_MAX);
+	} else if (x <= INT16_MIN) {
+		return q16_from_int(INT16_MIN);
+	}
+
+	return (q16_t)(x * Q16_ONE + (x < 0 ? -0.5F : 0.5F));
+}
+
+static inline float q16_to_float(q16_t x)
+{
+	return (float)x / Q16_ONE;
+}
+
+/* Rounds towards negative infinity */
+static inline int32_t q16_to_int(q16_t x)
+{
+	return x >> Q16_SHIFT;
+}
+
+/* Rounds to nearest, truncating would bias integrators such as the AICLK arbiters downwards */
+static inline q16_t q16_mul(q16_t a, q16_t b)
+{
+	return (q16_t)(((int64_t)a * b + (1 << (Q16_SHIFT - 1))) >> Q16_SHIFT);
+}
+
+/* As q16_mul, but saturates instead of wrapping when the product is out of range */
+static inline q16_t q16_mul_sat(q16_t a, q16_t b)
+{
+	int64_t product = ((int64_t)a * b + (1 << (Q16_SHIFT - 1))) >> Q16_SHIFT;
+
+	return (q16_t)CLAMP(product, INT32_MIN, INT32_MAX);
+}
+
+#endif
@@ -33,9 +33,10 @@ static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash
 static const struct device *const arc_dma_dev = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma0));
 static const struct device *dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 
+#define WIPE_TIMEOUT_MS 50
+
 /* This is the noc2axi instance we want to run the MRISC FW on */
 #define MRISC_FW_NOC2AXI_PORT 0
-#define MRISC_SETUP_TLB       13
 #define MRISC_L1_ADDR         (1ULL << 37)
 #define MRISC_REG_ADDR        (1ULL << 40)
 #define MRISC_FW_CFG_OFFSET   0x3C00
@@ -43,6 +44,9 @@ static const struct device *dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 #define ARC_NOC0_Y            0
 #define MRISC_L1_SIZE         (128 * 1024)
 
+/* ARC DMA channel used for batched GDDR telemetry reads, kept apart from the channel 0 users */
+#define GDDR_TELEMETRY_DMA_CHANNEL 1
+
 #define MRISC_FW_TAG     "memfw"
 #define MRISC_FW_CFG_TAG "memfwcfg"
 
@@ -57,63 +61,87 @@ static uint32_t GetGddrSpeedFromCfg(uint8_t *fw_cfg_image)
 	return fw_cfg_dw[1];
 }
 
-static volatile void *SetupMriscL1Tlb(uint8_t gddr_inst)
+static uint8_t AcquireMriscTlb(uint8_t gddr_inst, uint64_t addr)
 {
 	uint8_t x, y;
 
 	GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x, &y);
-	NOC2AXITlbSetup(0, MRISC_SETUP_TLB, x, y, MRISC_L1_ADDR);
-	return GetTlbWindowAddr(0, MRISC_SETUP_TLB, MRISC_L1_ADDR);
+	return NOC2AXITlbAcquire(0, x, y, addr);
+}
+
+/* Map the same address on every instance in gddr_mask at once, into tlb[gddr_inst] */
+static void AcquireMriscTlbs(uint8_t gddr_mask, uint64_t addr, uint8_t tlb[NUM_GDDR])
+{
+	uint8_t x[NUM_GDDR], y[NUM_GDDR], set_tlb[NUM_GDDR];
+	uint8_t count = 0;
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(gddr_mask, gddr_inst)) {
+			GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x[count], &y[count]);
+			count++;
+		}
+	}
+
+	NOC2AXITlbAcquireSet(0, count, x, y, addr, set_tlb);
+
+	count = 0;
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(gddr_mask, gddr_inst)) {
+			tlb[gddr_inst] = set_tlb[count++];
+		}
+	}
 }
 
 static uint32_t MriscL1Read32(uint8_t gddr_inst, uint32_t addr)
 {
-	uint8_t x, y;
+	uint8_t tlb = AcquireMriscTlb(gddr_inst, MRISC_L1_ADDR);
+	uint32_t val = NOC2AXIRead32(0, tlb, MRISC_L1_ADDR + addr);
 
-	GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x, &y);
-	NOC2AXITlbSetup(0, MRISC_SETUP_TLB, x, y, MRISC_L1_ADDR);
-	return NOC2AXIRead32(0, MRISC_SETUP_TLB, MRISC_L1_ADDR + addr);
+	NOC2AXITlbRelease(0, tlb);
+	return val;
 }
 
 static void MriscL1Write32(uint8_t gddr_inst, uint32_t addr, uint32_t val)
 {
-	uint8_t x, y;
+	uint8_t tlb = AcquireMriscTlb(gddr_inst, MRISC_L1_ADDR);
 
-	GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x, &y);
-	NOC2AXITlbSetup(0, MRISC_SETUP_TLB, x, y, MRISC_L1_ADDR);
-	NOC2AXIWrite32(0, MRISC_SETUP_TLB, MRISC_L1_ADDR + addr, val);
+	NOC2AXIWrite32(0, tlb, MRISC_L1_ADDR + addr, val);
+	NOC2AXITlbRelease(0, tlb);
 }
 
 static uint32_t MriscRegRead32(uint8_t gddr_inst, uint32_t addr)
 {
-	uint8_t x, y;
+	uint8_t tlb = AcquireMriscTlb(gddr_inst, MRISC_REG_ADDR + addr);
+	uint32_t val = NOC2AXIRead32(0, tlb, MRISC_REG_ADDR + addr);
 
-	GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x, &y);
-	NOC2AXITlbSetup(0, MRISC_SETUP_TLB, x, y, MRISC_REG_ADDR + addr);
-	return NOC2AXIRead32(0, MRISC_SETUP_TLB, MRISC_REG_ADDR + addr);
+	NOC2AXITlbRelease(0, tlb);
+	return val;
 }
 
 static void MriscRegWrite32(uint8_t gddr_inst, uint32_t addr, uint32_t val)
 {
-	uint8_t x, y;
+	uint8_t tlb = AcquireMriscTlb(gddr_inst, MRISC_REG_ADDR + addr);
 
-	GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x, &y);
-	NOC2AXITlbSetup(0, MRISC_SETUP_TLB, x, y, MRISC_REG_ADDR + addr);
-	NOC2AXIWrite32(0, MRISC_SETUP_TLB, MRISC_REG_ADDR + addr, val);
+	NOC2AXIWrite32(0, tlb, MRISC_REG_ADDR + addr, val);
+	NOC2AXITlbRelease(0, tlb);
 }
 
 int read_gddr_telemetry_table(uint8_t gddr_inst, gddr_telemetry_table_t *gddr_telemetry)
 {
-	volatile uint8_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
+	uint8_t tlb = AcquireMriscTlb(gddr_inst, MRISC_L1_ADDR);
+	volatile uint8_t *mrisc_l1 = GetTlbWindowAddr(0, tlb, MRISC_L1_ADDR);
+
 	if (dma_arc_hs_transfer(arc_dma_dev, 0,
 				(const void *)(mrisc_l1 + GDDR_TELEMETRY_TABLE_ADDR),
 				gddr_telemetry, sizeof(*gddr_telemetry), K_MSEC(500)) < 0) {
 		/* If DMA failed, can read 32b at a time via NOC2AXI */
 		for (int i = 0; i < sizeof(*gddr_telemetry) / 4; i++) {
-			((uint32_t *)gddr_telemetry)[i] =
-				MriscL1Read32(gddr_inst, GDDR_TELEMETRY_TABLE_ADDR + i * 4);
+			((uint32_t *)gddr_telemetry)[i] = NOC2AXIRead32(
+				0, tlb, MRISC_L1_ADDR + GDDR_TELEMETRY_TABLE_ADDR + i * 4);
 		}
 	}
+	NOC2AXITlbRelease(0, tlb);
+
 	/* Check that version matches expectation. */
 	if (gddr_telemetry->telemetry_table_version != GDDR_TELEMETRY_TABLE_T_VERSION) {
 		LOG_WRN_ONCE("GDDR telemetry table version mismatch: %d (expected %d)",
@@ -124,29 +152,118 @@ int read_gddr_telemetry_table(uint8_t gddr_inst, gddr_telemetry_table_t *gddr_te
 	return 0;
 }
 
+static int ReadGddrTelemetryDma(struct dma_block_config *blocks, uint32_t num_blocks)
+{
+#ifdef CONFIG_DMA_ARC_HS
+	return dma_arc_hs_transfer_blocks(arc_dma_dev, GDDR_TELEMETRY_DMA_CHANNEL, blocks,
+					  num_blocks, K_MSEC(500));
+#else
+	return -ENOTSUP;
+#endif
+}
+
+/**
+ * @brief Read the telemetry tables of several GDDR instances in one ARC DMA transfer
+ *
+ * @param gddr_mask Bitmask of the GDDR instances to read
+ * @param gddr_telemetry Array of NUM_GDDR tables, indexed by GDDR instance. Only the entries
+ *                       selected by @p gddr_mask are written.
+ *
+ * @return Bitmask of the instances in @p gddr_mask whose table was read and has the expected
+ *         version
+ */
+uint8_t read_gddr_telemetry_tables(uint8_t gddr_mask, gddr_telemetry_table_t *gddr_telemetry)
+{
+	struct dma_block_config blocks[NUM_GDDR] = {0};
+	uint8_t tlb[NUM_GDDR];
+	uint32_t num_blocks = 0;
+	uint8_t valid_mask = 0;
+
+	/* Every MRISC L1 is mapped at the same time. Each instance keeps its entry between calls
+	 * unless something else evicts it, so the TLBs are only programmed once.
+	 */
+	AcquireMriscTlbs(gddr_mask, MRISC_L1_ADDR, tlb);
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (!IS_BIT_SET(gddr_mask, gddr_inst)) {
+			continue;
+		}
+
+		volatile uint8_t *mrisc_l1 = GetTlbWindowAddr(0, tlb[gddr_inst], MRISC_L1_ADDR);
+
+		blocks[num_blocks].source_address =
+			(uintptr_t)(mrisc_l1 + GDDR_TELEMETRY_TABLE_ADDR);
+		blocks[num_blocks].dest_address = (uintptr_t)&gddr_telemetry[gddr_inst];
+		blocks[num_blocks].block_size = sizeof(gddr_telemetry[gddr_inst]);
+		if (num_blocks > 0) {
+			blocks[num_blocks - 1].next_block = &blocks[num_blocks];
+		}
+		num_blocks++;
+	}
+
+	if (num_blocks == 0) {
+		return 0;
+	}
+
+	if (ReadGddrTelemetryDma(blocks, num_blocks) < 0) {
+		/* If DMA failed, can read 32b at a time via NOC2AXI */
+		for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+			if (!IS_BIT_SET(gddr_mask, gddr_inst)) {
+				continue;
+			}
+
+			for (int i = 0; i < sizeof(gddr_telemetry[gddr_inst]) / 4; i++) {
+				((uint32_t *)&gddr_telemetry[gddr_inst])[i] = NOC2AXIRead32(
+					0, tlb[gddr_inst],
+					MRISC_L1_ADDR + GDDR_TELEMETRY_TABLE_ADDR + i * 4);
+			}
+		}
+	}
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (!IS_BIT_SET(gddr_mask, gddr_inst)) {
+			continue;
+		}
+
+		NOC2AXITlbRelease(0, tlb[gddr_inst]);
+
+		/* Check that version matches expectation. */
+		if (gddr_telemetry[gddr_inst].telemetry_table_version !=
+		    GDDR_TELEMETRY_TABLE_T_VERSION) {
+			LOG_WRN_ONCE("GDDR telemetry table version mismatch: %d (expected %d)",
+				     gddr_telemetry[gddr_inst].telemetry_table_version,
+				     GDDR_TELEMETRY_TABLE_T_VERSION);
+			continue;
+		}
+
+		WRITE_BIT(valid_mask, gddr_inst, 1);
+	}
+
+	return valid_mask;
+}
+
 static void ReleaseMriscReset(uint8_t gddr_inst)
 {
 	const uint32_t kSoftReset0Addr = 0xFFB121B0;
-	uint8_t x, y;
-
-	GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &x, &y);
-	NOC2AXITlbSetup(0, MRISC_SETUP_TLB, x, y, kSoftReset0Addr);
+	uint8_t tlb = AcquireMriscTlb(gddr_inst, kSoftReset0Addr);
 
-	volatile uint32_t *soft_reset_0 = GetTlbWindowAddr(0, MRISC_SETUP_TLB, kSoftReset0Addr);
+	volatile uint32_t *soft_reset_0 = GetTlbWindowAddr(0, tlb, kSoftReset0Addr);
 	*soft_reset_0 &= ~(1 << 11); /* Clear bit corresponding to MRISC reset */
+	NOC2AXITlbRelease(0, tlb);
 }
 
 static void SetAxiEnable(uint8_t gddr_inst, uint8_t noc2axi_port, bool axi_enable)
 {
 	const uint32_t kNiuCfg0Addr[NUM_NOCS] = {0xFFB20100, 0xFFB30100};
 	uint8_t x, y;
+	uint8_t tlb[NUM_NOCS];
 	volatile uint32_t *niu_cfg_0[NUM_NOCS];
 
 	for (uint8_t i = 0; i < NUM_NOCS; i++) {
 		GetGddrNocCoords(gddr_inst, noc2axi_port, i, &x, &y);
 		/* Note this actually sets up two TLBs (one for each NOC) */
-		NOC2AXITlbSetup(i, MRISC_SETUP_TLB, x, y, kNiuCfg0Addr[i]);
-		niu_cfg_0[i] = GetTlbWindowAddr(i, MRISC_SETUP_TLB, kNiuCfg0Addr[i]);
+		tlb[i] = NOC2AXITlbAcquire(i, x, y, kNiuCfg0Addr[i]);
+		niu_cfg_0[i] = GetTlbWindowAddr(i, tlb[i], kNiuCfg0Addr[i]);
 	}
 
 	if (axi_enable) {
@@ -158,24 +275,65 @@ static void SetAxiEnable(uint8_t gddr_inst, uint8_t noc2axi_port, bool axi_enabl
 			*niu_cfg_0[i] &= ~(1 << NIU_CFG_0_AXI_SLAVE_ENABLE);
 		}
 	}
+
+	for (uint8_t i = 0; i < NUM_NOCS; i++) {
+		NOC2AXITlbRelease(i, tlb[i]);
+	}
 }
 
-static int LoadMriscFw(uint8_t gddr_inst, uint8_t *buf, size_t buf_size, size_t spi_address,
+/*
+ * Read an image from SPI once and copy each chunk to the MRISC L1 of every GDDR instance in
+ * dram_mask, so harvested instances are skipped and SPI time does not grow with instance count.
+ */
+static int LoadMriscFw(uint8_t dram_mask, uint8_t *buf, size_t buf_size, size_t spi_address,
 		       size_t image_size)
 {
-	volatile uint32_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
-	int rc = spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
-					      (uint8_t *)mrisc_l1);
+	uint8_t tlb[NUM_GDDR];
+	uint8_t *mrisc_l1[NUM_GDDR];
+	size_t num_gddr = 0;
+
+	AcquireMriscTlbs(dram_mask, MRISC_L1_ADDR, tlb);
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(dram_mask, gddr_inst)) {
+			mrisc_l1[num_gddr++] =
+				(uint8_t *)GetTlbWindowAddr(0, tlb[gddr_inst], MRISC_L1_ADDR);
+		}
+	}
+
+	int rc = spi_arc_dma_transfer_to_tiles(flash, spi_address, image_size, buf, buf_size,
+					       mrisc_l1, num_gddr);
 
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(dram_mask, gddr_inst)) {
+			NOC2AXITlbRelease(0, tlb[gddr_inst]);
+		}
+	}
 	return rc;
 }
-static int LoadMriscFwCfg(uint8_t gddr_inst, uint8_t *buf, size_t buf_size, size_t spi_address,
-			  size_t image_size)
+
+/* Copy the MRISC FW config, already read from SPI into cfg, to every instance in dram_mask */
+static int LoadMriscFwCfg(uint8_t dram_mask, const uint8_t *cfg, size_t cfg_size)
 {
-	volatile uint32_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
-	int rc = spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
-					      (uint8_t *)mrisc_l1 + MRISC_FW_CFG_OFFSET);
+	uint8_t tlb[NUM_GDDR];
+	int rc = 0;
+
+	AcquireMriscTlbs(dram_mask, MRISC_L1_ADDR, tlb);
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (!IS_BIT_SET(dram_mask, gddr_inst)) {
+			continue;
+		}
+
+		uint8_t *mrisc_l1 = (uint8_t *)GetTlbWindowAddr(0, tlb[gddr_inst], MRISC_L1_ADDR);
 
+		if (rc == 0) {
+			rc = dma_arc_hs_transfer(arc_dma_dev, 0, cfg,
+						 mrisc_l1 + MRISC_FW_CFG_OFFSET, cfg_size,
+						 K_MSEC(500));
+		}
+		NOC2AXITlbRelease(0, tlb[gddr_inst]);
+	}
 	return rc;
 }
 
@@ -277,7 +435,7 @@ static int CheckHwMemtestResult(uint8_t gddr_inst, k_timepoint_t timeout)
 }
 
 /* This function assumes that tensix L1s have already been cleared */
-static void wipe_l1(void)
+static int wipe_l1(void)
 {
 	uint8_t noc_id = 0;
 	uint64_t addr = 0;
@@ -289,40 +447,53 @@ static void wipe_l1(void)
 	struct tt_bh_dma_noc_coords coords =
 		tt_bh_dma_noc_coords_init(tensix_x, tensix_y, 0, 0);
 
-	struct dma_block_config block = {
-		.source_address = addr,
-		.dest_address = addr,
-		.block_size = MRISC_L1_SIZE,
-	};
+	/* One block per MRISC port, all copied from the same Tensix L1 in a single chain */
+	static struct tt_bh_dma_noc_scatter_block blocks[NUM_GDDR * NUM_MRISC_NOC2AXI_PORT];
+	uint32_t block_count = 0;
+
+	for (uint32_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(dram_mask, gddr_inst)) {
+			for (uint32_t noc2axi_port = 0; noc2axi_port < NUM_MRISC_NOC2AXI_PORT;
+			     noc2axi_port++) {
+				struct tt_bh_dma_noc_scatter_block *block = &blocks[block_count++];
+
+				GetGddrNocCoords(gddr_inst, noc2axi_port, noc_id, &block->dest_x,
+						 &block->dest_y);
+				/* AXI enable must not be set, using MRISC address 0 */
+				block->block = (struct dma_block_config){
+					.source_address = addr,
+					.dest_address = addr,
+					.block_size = MRISC_L1_SIZE,
+				};
+			}
+		}
+	}
+
+	if (block_count == 0) {
+		return 0;
+	}
 
 	struct dma_config config = {
-		.channel_direction = PERIPHERAL_TO_MEMORY,
+		.channel_direction = TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER,
 		.source_data_size = 1,
 		.dest_data_size = 1,
 		.source_burst_length = 1,
 		.dest_burst_length = 1,
-		.block_count = 1,
-		.head_block = &block,
+		.block_count = block_count,
+		.head_block = tt_bh_dma_noc_scatter_link(blocks, block_count),
 		.user_data = &coords,
 	};
 
-	for (uint32_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
-		if (IS_BIT_SET(dram_mask, gddr_inst)) {
-			for (uint32_t noc2axi_port = 0; noc2axi_port < NUM_MRISC_NOC2AXI_PORT;
-			     noc2axi_port++) {
-				uint8_t x, y;
-
-				GetGddrNocCoords(gddr_inst, noc2axi_port, noc_id, &x, &y);
-
-				coords.dest_x = x;
-				coords.dest_y = y;
+	int ret = dma_config(dma_noc, 1, &config);
 
-				/* AXI enable must not be set, using MRISC address 0 */
-				dma_config(dma_noc, 1, &config);
-				dma_start(dma_noc, 1);
-			}
-		}
+	if (ret == 0) {
+		ret = dma_start(dma_noc, 1);
+	}
+	if (ret == 0) {
+		ret = tt_bh_dma_noc_wait(dma_noc, 1, K_MSEC(WIPE_TIMEOUT_MS));
 	}
+
+	return ret;
 }
 
 static int InitMrisc(void)
@@ -333,7 +504,12 @@ static int InitMrisc(void)
 		return 0;
 	}
 
-	wipe_l1();
+	int rc = wipe_l1();
+
+	if (rc != 0) {
+		LOG_ERR("%s() failed: %d", "wipe_l1", rc);
+		return rc;
+	}
 
 	/* Load MRISC (DRAM RISC) FW to all DRAMs in the middle NOC node */
 
@@ -345,7 +521,6 @@ static int InitMrisc(void)
 
 	uint32_t dram_mask = GetDramMask();
 
-	int rc;
 	tt_boot_fs_fd tag_fd;
 	size_t image_size;
 	size_t spi_address;
@@ -360,15 +535,16 @@ static int InitMrisc(void)
 	image_size = tag_fd.flags.f.image_size;
 	spi_address = tag_fd.spi_addr;
 
-	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
-		if (IS_BIT_SET(dram_mask, gddr_inst)) {
-			if (LoadMriscFw(gddr_inst, buf, SCRATCHPAD_SIZE, spi_address, image_size)) {
-				LOG_ERR("%s(%d) failed: %d", "LoadMriscFw", gddr_inst, -EIO);
-				return -EIO;
-			}
-		}
+	uint32_t load_start = k_cycle_get_32();
+
+	if (LoadMriscFw(dram_mask, buf, SCRATCHPAD_SIZE, spi_address, image_size)) {
+		LOG_ERR("%s() failed: %d", "LoadMriscFw", -EIO);
+		return -EIO;
 	}
 
+	LOG_INF("Loaded %zu byte MRISC FW to %u GDDR instances in %llu us", image_size,
+		POPCOUNT(dram_mask), k_cyc_to_us_floor64(k_cycle_get_32() - load_start));
+
 	rc = tt_boot_fs_find_fd_by_tag(flash, MRISC_FW_CFG_TAG, &tag_fd);
 	if (rc < 0) {
 		LOG_ERR("%s (%s) failed: %d", "tt_boot_fs_find_fd_by_tag", MRISC_FW_CFG_TAG, rc);
@@ -402,13 +578,14 @@ static int InitMrisc(void)
 		return -EIO;
 	}
 
+	/* buf still holds the whole config from the speed lookup above */
+	if (LoadMriscFwCfg(dram_mask, buf, image_size)) {
+		LOG_ERR("%s() failed: %d", "LoadMriscFwCfg", -EIO);
+		return -EIO;
+	}
+
 	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
 		if (IS_BIT_SET(dram_mask, gddr_inst)) {
-			if (LoadMriscFwCfg(gddr_inst, buf, SCRATCHPAD_SIZE, spi_address,
-					   image_size)) {
-				LOG_ERR("%s(%d) failed: %d", "LoadMriscFwCfg", gddr_inst, -EIO);
-				return -EIO;
-			}
 			MriscRegWrite32(gddr_inst, MRISC_INIT_STATUS, MRISC_INIT_BEFORE);
 			ReleaseMriscReset(gddr_inst);
 		}
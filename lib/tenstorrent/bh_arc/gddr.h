@@ -49,6 +49,7 @@
 #define MRISC_MSG_TYPE_RUN_MEMTEST   8
 
 int read_gddr_telemetry_table(uint8_t gddr_inst, gddr_telemetry_table_t *gddr_telemetry);
+uint8_t read_gddr_telemetry_tables(uint8_t gddr_mask, gddr_telemetry_table_t *gddr_telemetry);
 
 /** @brief Sets the MRISC power setting for all active MRISCs
  * @param [in] on `true` to send MRISCs the @ref MRISC_MSG_TYPE_PHY_WAKEUP command <br>
@@ -18,6 +18,8 @@
 #include "status_reg.h"
 #include "reg.h"
 #include "irqnum.h"
+#include "pcie.h"
+#include "timer.h"
 
 #define MSGHANDLER_COMPAT_MASK 0x1
 
@@ -69,6 +71,8 @@ typedef union {
 #define MSI_CATCHER_STATUS_REG_ADDR (MSI_CATCHER_BASE + MSI_CATCHER_STATUS_OFFSET)
 
 BUILD_ASSERT(sizeof(union request) <= (sizeof(uint32_t) * REQUEST_MSG_LEN));
+/* Both values are packed into a byte each of message_queue_info. */
+BUILD_ASSERT(MSG_QUEUE_SIZE <= 0xFF && NUM_MSG_QUEUES <= 0xFF);
 typedef struct {
 	uint32_t msi_ready: 1; /* [0:0] -- FIFO can accept a push. (Out of reset and not full.) */
 	uint32_t unused: 7;
@@ -94,6 +98,18 @@ static struct message_queue message_queues[NUM_MSG_QUEUES];
 /* All message handlers */
 static void *message_handlers[CONFIG_TT_BH_ARC_NUM_MSG_CODES];
 
+/* Queues whose current message is waiting for a deferred response. They are not serviced until
+ * the response has been posted, so responses stay in request order on every queue.
+ */
+static ATOMIC_DEFINE(deferred_queues, NUM_MSG_QUEUES);
+
+/* Queue whose message is currently being handled, or NUM_MSG_QUEUES outside of a handler. */
+static uint32_t dispatch_queue_id = NUM_MSG_QUEUES;
+/* Set when the message currently being handled defers its response. */
+static bool dispatch_deferred;
+
+static void msgqueue_work_submit(void);
+
 __attribute__((used)) static const uintptr_t message_queue_info[] = {
 	(uintptr_t)&message_queues, MSG_QUEUE_SIZE | (NUM_MSG_QUEUES << 8), 0, 0};
 
@@ -247,6 +263,115 @@ static void advance_serial(struct message_queue *queue, const union request *req
 	}
 }
 
+#ifdef CONFIG_TT_BH_ARC_MSG_STATS
+#define MSG_STATS_NUM_BUCKETS CONFIG_TT_BH_ARC_MSG_STATS_NUM_BUCKETS
+
+/* Number of histogram buckets returned in a single TT_SMC_MSG_GET_MSG_STATS response. */
+#define MSG_STATS_BUCKETS_PER_RESPONSE 8
+
+static struct msgqueue_msg_stats message_stats[CONFIG_TT_BH_ARC_NUM_MSG_CODES];
+static struct k_spinlock message_stats_lock;
+
+static void record_msg_stats(uint32_t msg_code, uint64_t start, uint64_t end)
+{
+	uint32_t elapsed_us = (uint32_t)MIN((end - start) / REFCLK_F_MHZ, UINT32_MAX);
+	/* Bucket 0 is < 1 us, bucket n is [2^(n-1), 2^n) us. */
+	uint32_t bucket = (elapsed_us == 0) ? 0 : 32 - __builtin_clz(elapsed_us);
+	struct msgqueue_msg_stats *stats = &message_stats[msg_code];
+
+	bucket = MIN(bucket, MSG_STATS_NUM_BUCKETS - 1);
+
+	k_spinlock_key_t key = k_spin_lock(&message_stats_lock);
+
+	stats->count++;
+	stats->max_us = MAX(stats->max_us, elapsed_us);
+	if (stats->hist[bucket] < UINT16_MAX) {
+		stats->hist[bucket]++;
+	}
+
+	k_spin_unlock(&message_stats_lock, key);
+}
+
+int msgqueue_get_msg_stats(uint32_t msg_code, struct msgqueue_msg_stats *stats)
+{
+	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES || stats == NULL) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&message_stats_lock);
+
+	*stats = message_stats[msg_code];
+	k_spin_unlock(&message_stats_lock, key);
+
+	return 0;
+}
+
+void msgqueue_clear_msg_stats(uint32_t msg_code)
+{
+	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&message_stats_lock);
+
+	memset(&message_stats[msg_code], 0, sizeof(message_stats[msg_code]));
+	k_spin_unlock(&message_stats_lock, key);
+}
+
+/**
+ * @brief Handler for @ref TT_SMC_MSG_GET_MSG_STATS messages
+ *
+ * @details Reports the call count, worst-case execution time and a window of the execution time
+ * histogram of a single message code handler.
+ *
+ * @param request Pointer to the host request message, use request->get_msg_stats for
+ *                structured access
+ * @param response Pointer to the response message to be sent back to host
+ *
+ * @retval 0 On success
+ * @retval EINVAL If the message code or the first bucket is out of range
+ */
+static uint8_t get_msg_stats_handler(const union request *request, struct response *response)
+{
+	const struct get_msg_stats_rqst *rqst = &request->get_msg_stats;
+	struct msgqueue_msg_stats stats;
+	uint16_t buckets[MSG_STATS_BUCKETS_PER_RESPONSE] = {0};
+
+	if (rqst->first_bucket >= MSG_STATS_NUM_BUCKETS ||
+	    msgqueue_get_msg_stats(rqst->msg_code, &stats) != 0) {
+		return EINVAL;
+	}
+
+	for (uint32_t i = 0; i < MSG_STATS_BUCKETS_PER_RESPONSE &&
+			     rqst->first_bucket + i < MSG_STATS_NUM_BUCKETS;
+	     i++) {
+		buckets[i] = stats.hist[rqst->first_bucket + i];
+	}
+
+	response->data[1] = stats.count;
+	response->data[2] = stats.max_us;
+	response->data[3] = MSG_STATS_NUM_BUCKETS;
+	memcpy(&response->data[4], buckets, sizeof(buckets));
+
+	if (rqst->clear) {
+		msgqueue_clear_msg_stats(rqst->msg_code);
+	}
+
+	return 0;
+}
+
+REGISTER_MESSAGE(TT_SMC_MSG_GET_MSG_STATS, get_msg_stats_handler);
+#else
+int msgqueue_get_msg_stats(uint32_t msg_code, struct msgqueue_msg_stats *stats)
+{
+	return -ENOTSUP;
+}
+
+void msgqueue_clear_msg_stats(uint32_t msg_code)
+{
+}
+#endif
+
 /* Forward to process_l2_message. Nearly every message takes this path. */
 static void process_l2_message_queue(const union request *request, struct response *response)
 {
@@ -258,8 +383,15 @@ static void process_l2_message_queue(const union request *request, struct respon
 	}
 
 	msgqueue_request_handler_t handler = message_handlers[msg_code];
+#ifdef CONFIG_TT_BH_ARC_MSG_STATS
+	uint64_t start = TimerTimestamp();
+#endif
 	uint8_t exit_code = handler(request, response);
 
+#ifdef CONFIG_TT_BH_ARC_MSG_STATS
+	record_msg_stats(msg_code, start, TimerTimestamp());
+#endif
+
 	response->data[0] |= exit_code;
 }
 
@@ -307,23 +439,84 @@ static void process_queued_message(struct message_queue *queue, const union requ
 	}
 }
 
-/* Run all the outstanding messages in a single queue. */
-static void process_message_queue(struct message_queue *queue)
+/* Run up to max_messages outstanding messages in a single queue. Returns the number run. */
+static unsigned int process_message_queue(struct message_queue *queue, unsigned int max_messages)
 {
-
+	uint32_t msgqueue_id = queue - message_queues;
 	uint32_t request_rptr;
 	uint32_t response_wptr;
+	unsigned int processed = 0;
 
-	while (start_next_message(queue, &request_rptr, &response_wptr)) {
+	while (processed < max_messages && !atomic_test_bit(deferred_queues, msgqueue_id) &&
+	       start_next_message(queue, &request_rptr, &response_wptr)) {
 		union request request = (union request){0};
 		struct response response = (struct response){0};
 
-		msgqueue_request_pop(queue - message_queues, &request);
+		msgqueue_request_pop(msgqueue_id, &request);
+		dispatch_queue_id = msgqueue_id;
+		dispatch_deferred = false;
 		process_queued_message(queue, &request, &response);
-		msgqueue_response_push(queue - message_queues, &response);
+		dispatch_queue_id = NUM_MSG_QUEUES;
+		processed++;
+
+		if (dispatch_deferred) {
+			/* The response is posted by msgqueue_complete_deferred_response. */
+			break;
+		}
 
+		msgqueue_response_push(msgqueue_id, &response);
 		advance_serial(queue, &request);
 	}
+
+	return processed;
+}
+
+int msgqueue_defer_response(struct msgqueue_deferred_response *deferred)
+{
+	if (deferred == NULL || dispatch_queue_id >= NUM_MSG_QUEUES) {
+		return -EINVAL;
+	}
+
+	deferred->msgqueue_id = dispatch_queue_id;
+	dispatch_deferred = true;
+	atomic_set_bit(deferred_queues, dispatch_queue_id);
+
+	return 0;
+}
+
+int msgqueue_complete_deferred_response(const struct msgqueue_deferred_response *deferred,
+					uint8_t exit_code, const struct response *response)
+{
+	struct response rsp = (struct response){0};
+
+	if (deferred == NULL || deferred->msgqueue_id >= NUM_MSG_QUEUES ||
+	    !atomic_test_bit(deferred_queues, deferred->msgqueue_id)) {
+		return -EINVAL;
+	}
+
+	if (response != NULL) {
+		rsp = *response;
+	}
+	rsp.data[0] |= exit_code;
+
+	/* The response slot was reserved when the request was started, so this cannot overflow.
+	 * Deferred requests never write the serial, so it always advances.
+	 */
+	msgqueue_response_push(deferred->msgqueue_id, &rsp);
+	message_queues[deferred->msgqueue_id].header.last_serial++;
+
+	atomic_clear_bit(deferred_queues, deferred->msgqueue_id);
+
+#if defined(CONFIG_TT_BH_ARC_MSGQUEUE_DEFERRED_MSI_VECTOR) &&                                      \
+	CONFIG_TT_BH_ARC_MSGQUEUE_DEFERRED_MSI_VECTOR >= 0
+	SendPcieMsi(CONFIG_TT_BH_ARC_MSGQUEUE_DEFERRED_MSI_PCIE_INST,
+		    CONFIG_TT_BH_ARC_MSGQUEUE_DEFERRED_MSI_VECTOR);
+#endif
+
+	/* Pick up any requests that queued up behind the deferred one. */
+	msgqueue_work_submit();
+
+	return 0;
 }
 
 void clear_msg_irq(void)
@@ -336,14 +529,29 @@ void clear_msg_irq(void)
 #endif
 }
 
-/* Run all messages in all queues. */
+/* Run all messages in all queues.
+ *
+ * Queues are serviced round-robin, CONFIG_TT_BH_ARC_MSG_QUEUE_WEIGHT messages at a time, until
+ * every queue is drained. The starting queue rotates on each call so that no queue is
+ * consistently favoured.
+ */
 void process_message_queues(void)
 {
+	static unsigned int first_queue;
+	unsigned int processed;
+
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARC_MSG_HANDLE_START);
-	for (unsigned int i = 0; i < NUM_MSG_QUEUES; i++) {
-		SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARG_MSG_QUEUE_START + i);
-		process_message_queue(&message_queues[i]);
-	}
+	do {
+		processed = 0;
+		for (unsigned int n = 0; n < NUM_MSG_QUEUES; n++) {
+			unsigned int i = (first_queue + n) % NUM_MSG_QUEUES;
+
+			SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARG_MSG_QUEUE(i));
+			processed += process_message_queue(&message_queues[i],
+							   CONFIG_TT_BH_ARC_MSG_QUEUE_WEIGHT);
+		}
+	} while (processed > 0);
+	first_queue = (first_queue + 1) % NUM_MSG_QUEUES;
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARC_MSG_HANDLE_DONE);
 }
 
@@ -387,11 +595,54 @@ static void msgqueue_work_handler(struct k_work *work)
 
 static K_WORK_DEFINE(msgqueue_work, msgqueue_work_handler);
 
+/* Host requests are serviced on their own work queue so that their latency does not depend on
+ * whatever else is queued on the system work queue.
+ */
+static K_THREAD_STACK_DEFINE(msgqueue_workq_stack, CONFIG_TT_BH_ARC_MSGQUEUE_WORKQUEUE_STACK_SIZE);
+static struct k_work_q msgqueue_workq;
+
+static void msgqueue_work_submit(void)
+{
+	k_work_submit_to_queue(&msgqueue_workq, &msgqueue_work);
+}
+#else
+static void msgqueue_work_submit(void)
+{
+	/* Without interrupts the queues are only processed on explicit request. */
+}
+#endif
+
+/* Long-running handlers finish their deferred work here, off the message queue work queue. */
+static K_THREAD_STACK_DEFINE(msgqueue_deferred_workq_stack,
+			     CONFIG_TT_BH_ARC_MSGQUEUE_DEFERRED_WORKQUEUE_STACK_SIZE);
+static struct k_work_q msgqueue_deferred_workq;
+
+int msgqueue_submit_deferred_work(struct k_work *work)
+{
+	return k_work_submit_to_queue(&msgqueue_deferred_workq, work);
+}
+
+static int msgqueue_deferred_workq_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "msgqueue_deferred_workq"};
+
+	k_work_queue_init(&msgqueue_deferred_workq);
+	k_work_queue_start(&msgqueue_deferred_workq, msgqueue_deferred_workq_stack,
+			   K_THREAD_STACK_SIZEOF(msgqueue_deferred_workq_stack),
+			   CONFIG_TT_BH_ARC_MSGQUEUE_DEFERRED_WORKQUEUE_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(msgqueue_deferred_workq_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#ifdef CONFIG_BOARD_TT_BLACKHOLE
+
 static void msgqueue_interrupt_handler(void *arg)
 {
 	(void)(arg);
 	clear_msg_irq();
-	k_work_submit(&msgqueue_work);
+	msgqueue_work_submit();
 }
 
 static bool msi_catcher_nonempty(void)
@@ -428,7 +679,7 @@ static void msgqueue_msi_interrupt_handler(void *arg)
 	}
 
 	if (msi_for_msgqueue) {
-		k_work_submit(&msgqueue_work);
+		msgqueue_work_submit();
 	}
 }
 
@@ -437,7 +688,7 @@ static void msgqueue_msi_overflow_handler(void *arg)
 	(void)(arg);
 
 	msi_catcher_flush();
-	k_work_submit(&msgqueue_work);
+	msgqueue_work_submit();
 }
 #endif
 
@@ -446,6 +697,13 @@ void init_msgqueue(void)
 	prepare_msg_queue();
 
 #ifdef CONFIG_BOARD_TT_BLACKHOLE
+	const struct k_work_queue_config workq_cfg = {.name = "msgqueue_workq"};
+
+	k_work_queue_init(&msgqueue_workq);
+	k_work_queue_start(&msgqueue_workq, msgqueue_workq_stack,
+			   K_THREAD_STACK_SIZEOF(msgqueue_workq_stack),
+			   CONFIG_TT_BH_ARC_MSGQUEUE_WORKQUEUE_PRIORITY, &workq_cfg);
+
 	IRQ_CONNECT(IRQNUM_ARC_MISC_CNTL_IRQ0, 0, msgqueue_interrupt_handler, NULL, 0);
 	irq_enable(IRQNUM_ARC_MISC_CNTL_IRQ0);
 
@@ -7,6 +7,19 @@
 #include "noc.h"
 #include "noc2axi.h"
 
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 typedef struct {
 	uint32_t passthrough_bits: 24;
 	uint32_t lower_addr_bits: 8;
@@ -57,10 +70,46 @@ typedef union {
 	NOC2AXITlb3RegT f;
 } NOC2AXITlb3RegU;
 
+typedef struct {
+	NOC2AXITlb0RegU tlb0;
+	NOC2AXITlb1RegU tlb1;
+	NOC2AXITlb2RegU tlb2;
+	NOC2AXITlb3RegU tlb3;
+} NOC2AXITlbRegs;
+
+/* One entry of the TLB allocator. Entries that have never been programmed have last_use 0, so
+ * they are picked before any mapping is evicted.
+ */
+typedef struct {
+	NOC2AXITlbRegs regs;
+	uint64_t last_use;
+	uint8_t refs;
+} NOC2AXITlbEntry;
+
 #define NOC2AXI_NUM_TLB_PER_RING 16
 #define RING0_TLB_REG_OFFSET     0x1000
 #define AXI2NOC_RING_SEL_BIT     15
 
+/* Entries handed out by NOC2AXITlbAcquire. The others keep fixed owners: entry 0 of both rings
+ * for NOC init, and entries 1-5 and 14 of ring 0 for PCIe.
+ */
+static const uint16_t tlb_pool[NUM_NOCS] = {
+	GENMASK(13, 6) | BIT(15),
+	GENMASK(15, 1),
+};
+
+/* The lock is a spinlock so that entries can be released from interrupt context. An acquire that
+ * finds too few free entries counts itself in tlb_waiters and sleeps on tlb_released. Each release
+ * of a last reference wakes all of them to look again, giving the semaphore once per waiter, so
+ * it never counts more than the threads that will take it.
+ */
+static struct k_spinlock tlb_lock;
+static K_SEM_DEFINE(tlb_released, 0, K_SEM_MAX_LIMIT);
+static uint32_t tlb_waiters;
+static NOC2AXITlbEntry tlb_entries[NUM_NOCS][NOC2AXI_NUM_TLB_PER_RING];
+static NOC2AXITlbStats tlb_stats[NUM_NOCS];
+static uint64_t tlb_clock;
+
 #ifdef CONFIG_BOARD_NATIVE_SIM
 #define NIU0_A_REG_SPACE_SIZE 0x10000
 /* Running within simulation. Fake out TLB register space */
@@ -78,62 +127,79 @@ static inline uint32_t volatile *GetTlbRegStartAddr(const uint8_t ring)
 	return tlb_addr;
 }
 
-static inline void WriteTlbSetup(const uint8_t ring, const uint8_t tlb_num, NOC2AXITlb0RegU tlb0,
-				 NOC2AXITlb1RegU tlb1, NOC2AXITlb2RegU tlb2, NOC2AXITlb3RegU tlb3)
+static inline void WriteTlbSetup(const uint8_t ring, const uint8_t tlb_num,
+				 const NOC2AXITlbRegs *regs)
 {
-	uint32_t volatile *noc2axi_tlb = GetTlbRegStartAddr(ring);
+	uint32_t noc2axi_tlb = (uint32_t)GetTlbRegStartAddr(ring);
 
-	noc2axi_tlb[tlb_num * 2] = tlb0.val;
-	noc2axi_tlb[tlb_num * 2 + 1] = tlb1.val;
-	noc2axi_tlb[tlb_num + NOC2AXI_NUM_TLB_PER_RING * 2] = tlb2.val;
-	noc2axi_tlb[tlb_num + NOC2AXI_NUM_TLB_PER_RING * 3] = tlb3.val;
+	WriteReg(noc2axi_tlb + (tlb_num * 2) * sizeof(uint32_t), regs->tlb0.val);
+	WriteReg(noc2axi_tlb + (tlb_num * 2 + 1) * sizeof(uint32_t), regs->tlb1.val);
+	WriteReg(noc2axi_tlb + (tlb_num + NOC2AXI_NUM_TLB_PER_RING * 2) * sizeof(uint32_t),
+		 regs->tlb2.val);
+	WriteReg(noc2axi_tlb + (tlb_num + NOC2AXI_NUM_TLB_PER_RING * 3) * sizeof(uint32_t),
+		 regs->tlb3.val);
 }
 
-void NOC2AXITlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint8_t x, const uint8_t y,
-		     const uint64_t addr)
+static NOC2AXITlbRegs MulticastTlbRegs(const uint8_t x_start, const uint8_t y_start,
+				       const uint8_t x_end, const uint8_t y_end,
+				       const uint64_t addr, Noc2AxiOrdering ordering)
 {
-	NOC2AXITlb0RegU tlb0;
+	NOC2AXITlbRegs regs = {0};
 
-	tlb0.f.passthrough_bits = 0;
-	tlb0.f.lower_addr_bits = addr >> 24;
-	NOC2AXITlb1RegU tlb1;
+	regs.tlb0.f.lower_addr_bits = addr >> 24;
+	regs.tlb1.f.middle_addr_bits = addr >> 32;
+	regs.tlb2.f.x_start = x_start;
+	regs.tlb2.f.y_start = y_start;
+	regs.tlb2.f.x_end = x_end;
+	regs.tlb2.f.y_end = y_end;
+	regs.tlb2.f.ordering_mode = ordering;
+	regs.tlb2.f.multicast_en = 1;
 
-	tlb1.f.middle_addr_bits = addr >> 32;
-	NOC2AXITlb2RegU tlb2;
+	return regs;
+}
+
+static NOC2AXITlbRegs UnicastTlbRegs(const uint8_t x, const uint8_t y, const uint64_t addr)
+{
+	NOC2AXITlbRegs regs = {0};
 
-	tlb2.val = 0;
-	tlb2.f.x_end = x;
-	tlb2.f.y_end = y;
-	tlb2.f.ordering_mode = kNoc2AxiOrderingStrict;
-	NOC2AXITlb3RegU tlb3 = {.val = 0};
+	regs.tlb0.f.lower_addr_bits = addr >> 24;
+	regs.tlb1.f.middle_addr_bits = addr >> 32;
+	regs.tlb2.f.x_end = x;
+	regs.tlb2.f.y_end = y;
+	regs.tlb2.f.ordering_mode = kNoc2AxiOrderingStrict;
 
-	WriteTlbSetup(ring, tlb_num, tlb0, tlb1, tlb2, tlb3);
+	return regs;
 }
 
-void NOC2AXIMulticastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint8_t x_start,
-			      const uint8_t y_start, const uint8_t x_end, const uint8_t y_end,
-			      const uint64_t addr, Noc2AxiOrdering ordering)
+/* Skip ARC on column x = 8 */
+#define TENSIX_BROADCAST_X_START 9
+#define TENSIX_BROADCAST_X_END   7
+
+static NOC2AXITlbRegs TensixBroadcastTlbRegs(const uint64_t addr, Noc2AxiOrdering ordering)
 {
+	return MulticastTlbRegs(TENSIX_BROADCAST_X_START, 0, TENSIX_BROADCAST_X_END,
+				NOC_Y_SIZE - 1, addr, ordering);
+}
 
-	NOC2AXITlb0RegU tlb0;
+void NOC2AXITlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint8_t x, const uint8_t y,
+		     const uint64_t addr)
+{
+	__ASSERT(!IS_BIT_SET(tlb_pool[ring], tlb_num), "TLB %u is owned by the allocator", tlb_num);
 
-	tlb0.f.passthrough_bits = 0;
-	tlb0.f.lower_addr_bits = addr >> 24;
-	NOC2AXITlb1RegU tlb1;
+	NOC2AXITlbRegs regs = UnicastTlbRegs(x, y, addr);
 
-	tlb1.f.middle_addr_bits = addr >> 32;
-	NOC2AXITlb2RegU tlb2;
+	WriteTlbSetup(ring, tlb_num, &regs);
+}
+
+void NOC2AXIMulticastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint8_t x_start,
+			      const uint8_t y_start, const uint8_t x_end, const uint8_t y_end,
+			      const uint64_t addr, Noc2AxiOrdering ordering)
+{
+	__ASSERT(!IS_BIT_SET(tlb_pool[ring], tlb_num), "TLB %u is owned by the allocator", tlb_num);
 
-	tlb2.val = 0;
-	tlb2.f.x_start = x_start;
-	tlb2.f.y_start = y_start;
-	tlb2.f.x_end = x_end;
-	tlb2.f.y_end = y_end;
-	tlb2.f.ordering_mode = ordering;
-	tlb2.f.multicast_en = 1;
-	NOC2AXITlb3RegU tlb3 = {.val = 0};
+	NOC2AXITlbRegs regs = MulticastTlbRegs(x_start, y_start, x_end, y_end, addr, ordering);
 
-	WriteTlbSetup(ring, tlb_num, tlb0, tlb1, tlb2, tlb3);
+	WriteTlbSetup(ring, tlb_num, &regs);
 }
 
 /* Broadcast to all unharvested Tensix. Requires NocInit to be called first to set up broadcast
@@ -145,9 +211,268 @@ void NOC2AXIMulticastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const u
 void NOC2AXITensixBroadcastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint64_t addr,
 				    Noc2AxiOrdering ordering)
 {
-	/* Skip ARC on column x = 8 */
-	const uint8_t kXStart = 9;
-	const uint8_t kXEnd = 7;
+	__ASSERT(!IS_BIT_SET(tlb_pool[ring], tlb_num), "TLB %u is owned by the allocator", tlb_num);
+
+	NOC2AXITlbRegs regs = TensixBroadcastTlbRegs(addr, ordering);
+
+	WriteTlbSetup(ring, tlb_num, &regs);
+}
+
+static bool TlbRegsEqual(const NOC2AXITlbRegs *a, const NOC2AXITlbRegs *b)
+{
+	return a->tlb0.val == b->tlb0.val && a->tlb1.val == b->tlb1.val &&
+	       a->tlb2.val == b->tlb2.val && a->tlb3.val == b->tlb3.val;
+}
+
+/* Find the entry already holding the mapping, or the least recently used free entry otherwise.
+ * Entries in exclude are skipped. Returns -ENOENT if neither exists. Must be called with tlb_lock
+ * held.
+ */
+static int FindTlb(const uint8_t ring, const NOC2AXITlbRegs *regs, uint16_t exclude)
+{
+	int victim = -ENOENT;
+
+	for (uint8_t tlb = 0; tlb < NOC2AXI_NUM_TLB_PER_RING; tlb++) {
+		NOC2AXITlbEntry *entry = &tlb_entries[ring][tlb];
+
+		if (!IS_BIT_SET(tlb_pool[ring], tlb) || IS_BIT_SET(exclude, tlb)) {
+			continue;
+		}
+
+		if (entry->last_use != 0 && TlbRegsEqual(&entry->regs, regs)) {
+			return tlb;
+		}
+
+		if (entry->refs == 0 &&
+		    (victim < 0 || entry->last_use < tlb_entries[ring][victim].last_use)) {
+			victim = tlb;
+		}
+	}
+
+	return victim;
+}
+
+/* Pick an entry for every mapping of a set without taking any. An entry picked for one mapping is
+ * not picked again for another, unless the mappings are the same. Returns false if there are not
+ * enough free entries. Must be called with tlb_lock held.
+ */
+static bool FindTlbs(const uint8_t ring, const NOC2AXITlbRegs *regs, uint8_t count, uint8_t *tlbs)
+{
+	uint16_t picked = 0;
+
+	for (uint8_t i = 0; i < count; i++) {
+		int tlb = -ENOENT;
+
+		for (uint8_t j = 0; j < i && tlb < 0; j++) {
+			if (TlbRegsEqual(&regs[j], &regs[i])) {
+				tlb = tlbs[j];
+			}
+		}
+
+		if (tlb < 0) {
+			tlb = FindTlb(ring, &regs[i], picked);
+		}
+
+		if (tlb < 0) {
+			return false;
+		}
+
+		tlbs[i] = tlb;
+		picked |= BIT(tlb);
+	}
+
+	return true;
+}
+
+/* Take entries for all mappings at once, so a caller never waits while holding part of a set */
+static void AcquireTlbs(const uint8_t ring, const NOC2AXITlbRegs *regs, uint8_t count,
+			uint8_t *tlbs)
+{
+	__ASSERT(count <= POPCOUNT(tlb_pool[ring]), "%u TLB entries can never be free at once",
+		 count);
+
+	k_spinlock_key_t key = k_spin_lock(&tlb_lock);
+
+	/* Not enough entries are free, wait for a release */
+	while (!FindTlbs(ring, regs, count, tlbs)) {
+		tlb_waiters++;
+		k_spin_unlock(&tlb_lock, key);
+		k_sem_take(&tlb_released, K_FOREVER);
+		key = k_spin_lock(&tlb_lock);
+	}
+
+	for (uint8_t i = 0; i < count; i++) {
+		NOC2AXITlbEntry *entry = &tlb_entries[ring][tlbs[i]];
+
+		/* Earlier mappings of the set may already have programmed this one */
+		if (entry->last_use != 0 && TlbRegsEqual(&entry->regs, &regs[i])) {
+			tlb_stats[ring].hits++;
+		} else {
+			tlb_stats[ring].misses++;
+			if (entry->last_use != 0) {
+				tlb_stats[ring].evictions++;
+			}
+
+			WriteTlbSetup(ring, tlbs[i], &regs[i]);
+			entry->regs = regs[i];
+		}
+
+		entry->refs++;
+		entry->last_use = ++tlb_clock;
+	}
+
+	k_spin_unlock(&tlb_lock, key);
+}
+
+static uint8_t AcquireTlb(const uint8_t ring, const NOC2AXITlbRegs *regs)
+{
+	uint8_t tlb;
+
+	AcquireTlbs(ring, regs, 1, &tlb);
+
+	return tlb;
+}
 
-	NOC2AXIMulticastTlbSetup(ring, tlb_num, kXStart, 0, kXEnd, NOC_Y_SIZE - 1, addr, ordering);
+/**
+ * @brief Get a TLB entry that maps the 16 MiB window of a tile containing an address
+ *
+ * An entry that already maps the window is shared, without reprogramming it. Otherwise the least
+ * recently used entry that is not held is reprogrammed. If every entry is held, this waits until
+ * one is released, so this must not be called from interrupt context. The window stays mapped
+ * until the entry is released with @ref NOC2AXITlbRelease.
+ *
+ * @param ring NOC ring to map the window on
+ * @param x Logical X coordinate of the tile
+ * @param y Logical Y coordinate of the tile
+ * @param addr Address within the tile
+ *
+ * @return The TLB entry, to pass to @ref GetTlbWindowAddr and the NOC2AXI accessors
+ */
+uint8_t NOC2AXITlbAcquire(const uint8_t ring, const uint8_t x, const uint8_t y,
+			  const uint64_t addr)
+{
+	NOC2AXITlbRegs regs = UnicastTlbRegs(x, y, addr);
+
+	return AcquireTlb(ring, &regs);
+}
+
+/**
+ * @brief Get TLB entries for the same address on several tiles, see @ref NOC2AXITlbAcquire
+ *
+ * The entries are taken all at once, waiting until enough of them are free, so callers that hold
+ * several entries cannot deadlock by each waiting with part of its set held. Each entry is
+ * released on its own with @ref NOC2AXITlbRelease.
+ *
+ * @param ring NOC ring to map the windows on
+ * @param count Number of tiles, at most the number of entries in the ring's pool
+ * @param x Logical X coordinates of the tiles
+ * @param y Logical Y coordinates of the tiles
+ * @param addr Address within each tile
+ * @param tlbs Returns the entry of each tile
+ */
+void NOC2AXITlbAcquireSet(const uint8_t ring, const uint8_t count, const uint8_t *x,
+			  const uint8_t *y, const uint64_t addr, uint8_t *tlbs)
+{
+	NOC2AXITlbRegs regs[NOC2AXI_NUM_TLB_PER_RING];
+
+	__ASSERT(count <= ARRAY_SIZE(regs), "Too many TLB entries requested: %u", count);
+
+	for (uint8_t i = 0; i < count; i++) {
+		regs[i] = UnicastTlbRegs(x[i], y[i], addr);
+	}
+
+	AcquireTlbs(ring, regs, count, tlbs);
+}
+
+/**
+ * @brief Get a TLB entry that multicasts to a rectangle of tiles, see @ref NOC2AXITlbAcquire
+ */
+uint8_t NOC2AXIMulticastTlbAcquire(const uint8_t ring, const uint8_t x_start, const uint8_t y_start,
+				   const uint8_t x_end, const uint8_t y_end, const uint64_t addr,
+				   Noc2AxiOrdering ordering)
+{
+	NOC2AXITlbRegs regs = MulticastTlbRegs(x_start, y_start, x_end, y_end, addr, ordering);
+
+	return AcquireTlb(ring, &regs);
+}
+
+/**
+ * @brief Get a TLB entry that broadcasts to all unharvested Tensix, see @ref NOC2AXITlbAcquire
+ */
+uint8_t NOC2AXITensixBroadcastTlbAcquire(const uint8_t ring, const uint64_t addr,
+					 Noc2AxiOrdering ordering)
+{
+	NOC2AXITlbRegs regs = TensixBroadcastTlbRegs(addr, ordering);
+
+	return AcquireTlb(ring, &regs);
+}
+
+/**
+ * @brief Release a TLB entry from @ref NOC2AXITlbAcquire
+ *
+ * The entry keeps its mapping, so a later acquire of the same window can reuse it until it is
+ * evicted. This can be called from interrupt context.
+ *
+ * @param ring NOC ring of the entry
+ * @param tlb The entry
+ */
+void NOC2AXITlbRelease(const uint8_t ring, const uint8_t tlb)
+{
+	k_spinlock_key_t key = k_spin_lock(&tlb_lock);
+
+	__ASSERT(tlb_entries[ring][tlb].refs > 0, "TLB %u released more often than acquired", tlb);
+	if (--tlb_entries[ring][tlb].refs == 0) {
+		for (; tlb_waiters > 0; tlb_waiters--) {
+			k_sem_give(&tlb_released);
+		}
+	}
+
+	k_spin_unlock(&tlb_lock, key);
+}
+
+/**
+ * @brief Find the TLB entry that currently maps the 16 MiB window of a tile
+ *
+ * The mapping can be evicted once the entry is released, so this is only meaningful while its
+ * user holds it.
+ *
+ * @return The TLB entry, or -ENOENT if the window is not mapped
+ */
+int NOC2AXITlbLookup(const uint8_t ring, const uint8_t x, const uint8_t y, const uint64_t addr)
+{
+	NOC2AXITlbRegs regs = UnicastTlbRegs(x, y, addr);
+	int ret = -ENOENT;
+	k_spinlock_key_t key = k_spin_lock(&tlb_lock);
+
+	for (uint8_t tlb = 0; tlb < NOC2AXI_NUM_TLB_PER_RING; tlb++) {
+		NOC2AXITlbEntry *entry = &tlb_entries[ring][tlb];
+
+		if (IS_BIT_SET(tlb_pool[ring], tlb) && entry->last_use != 0 &&
+		    TlbRegsEqual(&entry->regs, &regs)) {
+			ret = tlb;
+			break;
+		}
+	}
+	k_spin_unlock(&tlb_lock, key);
+
+	return ret;
+}
+
+void NOC2AXITlbGetStats(const uint8_t ring, NOC2AXITlbStats *stats)
+{
+	K_SPINLOCK(&tlb_lock) {
+		*stats = tlb_stats[ring];
+	}
+}
+
+/* Forget every mapping and the statistics. None of the entries may be held. */
+STATIC void NOC2AXITlbReset(void)
+{
+	K_SPINLOCK(&tlb_lock) {
+		memset(tlb_entries, 0, sizeof(tlb_entries));
+		memset(tlb_stats, 0, sizeof(tlb_stats));
+		tlb_clock = 0;
+		tlb_waiters = 0;
+	}
+	k_sem_reset(&tlb_released);
 }
@@ -23,6 +23,12 @@ typedef enum {
 	kNoc2AxiOrderingPostedStrict = 3,
 } Noc2AxiOrdering;
 
+typedef struct {
+	uint32_t hits;      /* Acquires served by an entry that already mapped the window */
+	uint32_t misses;    /* Acquires that had to program an entry */
+	uint32_t evictions; /* Misses that replaced another mapping */
+} NOC2AXITlbStats;
+
 void NOC2AXITlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint8_t x, const uint8_t y,
 		     const uint64_t addr);
 void NOC2AXIMulticastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint8_t x_start,
@@ -31,6 +37,19 @@ void NOC2AXIMulticastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const u
 void NOC2AXITensixBroadcastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint64_t addr,
 				    Noc2AxiOrdering ordering);
 
+uint8_t NOC2AXITlbAcquire(const uint8_t ring, const uint8_t x, const uint8_t y,
+			  const uint64_t addr);
+void NOC2AXITlbAcquireSet(const uint8_t ring, const uint8_t count, const uint8_t *x,
+			  const uint8_t *y, const uint64_t addr, uint8_t *tlbs);
+uint8_t NOC2AXIMulticastTlbAcquire(const uint8_t ring, const uint8_t x_start, const uint8_t y_start,
+				   const uint8_t x_end, const uint8_t y_end, const uint64_t addr,
+				   Noc2AxiOrdering ordering);
+uint8_t NOC2AXITensixBroadcastTlbAcquire(const uint8_t ring, const uint64_t addr,
+					 Noc2AxiOrdering ordering);
+void NOC2AXITlbRelease(const uint8_t ring, const uint8_t tlb);
+int NOC2AXITlbLookup(const uint8_t ring, const uint8_t x, const uint8_t y, const uint64_t addr);
+void NOC2AXITlbGetStats(const uint8_t ring, NOC2AXITlbStats *stats);
+
 static inline void volatile *GetTlbWindowAddr(const uint8_t noc_id, const uint8_t tlb_entry,
 					      const uint64_t addr)
 {
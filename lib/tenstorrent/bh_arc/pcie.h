@@ -39,4 +39,6 @@ static inline uint32_t ReadDbiReg(const uint32_t addr)
 
 	return NOC2AXIRead32(noc_id, PCIE_DBI_REG_TLB, addr);
 }
+
+void SendPcieMsi(uint8_t pcie_inst, uint32_t vector_id);
 #endif
@@ -12,6 +12,7 @@
 
 #include "util.h"
 #include "pcie.h"
+#include "pcie_dma.h"
 
 #define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_STATUS_OFF_WRCH_0_REG_ADDR 0x00380080
 #define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_WRCH_0_REG_ADDR        \
@@ -37,33 +38,30 @@
 	0x0038001C
 #define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_DOORBELL_OFF_WRCH_0_REG_ADDR         \
 	0x00380004
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_STATUS_OFF_RDCH_0_REG_ADDR 0x00380180
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_RDCH_0_REG_ADDR        \
-	0x00380188
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_MSI_STOP_LOW_OFF_RDCH_0_REG_ADDR     \
-	0x00380190
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_MSI_STOP_HIGH_OFF_RDCH_0_REG_ADDR    \
-	0x00380194
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_MSI_ABORT_LOW_OFF_RDCH_0_REG_ADDR    \
-	0x003801A0
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_MSI_ABORT_HIGH_OFF_RDCH_0_REG_ADDR   \
-	0x003801A4
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_MSI_MSGD_OFF_RDCH_0_REG_ADDR         \
-	0x003801A8
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_EN_OFF_RDCH_0_REG_ADDR      0x00380100
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_DAR_LOW_OFF_RDCH_0_REG_ADDR 0x00380128
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_DAR_HIGH_OFF_RDCH_0_REG_ADDR         \
-	0x0038012C
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_SAR_LOW_OFF_RDCH_0_REG_ADDR 0x00380120
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_SAR_HIGH_OFF_RDCH_0_REG_ADDR         \
-	0x00380124
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_DOORBELL_OFF_RDCH_0_REG_ADDR         \
-	0x00380104
-#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_XFERSIZE_OFF_RDCH_0_REG_ADDR         \
-	0x0038011C
+#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_LLP_LOW_OFF_WRCH_0_REG_ADDR 0x00380010
+#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_LLP_HIGH_OFF_WRCH_0_REG_ADDR         \
+	0x00380014
+#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_CYCLE_OFF_WRCH_0_REG_ADDR   0x00380018
+#define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_CONTROL1_OFF_WRCH_0_REG_ADDR         \
+	0x00380034
 
 #define HDMA_REG_ADDR(reg) (PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_##reg##_REG_ADDR)
 
+/* Every channel has a write and a read register block, each laid out like write channel 0 */
+#define HDMA_CHANNEL_STRIDE   0x200
+#define HDMA_DIRECTION_STRIDE 0x100
+#define HDMA_CH_REG_ADDR(reg, dir, ch)                                                             \
+	(HDMA_REG_ADDR(reg##_OFF_WRCH_0) + (dir) * HDMA_DIRECTION_STRIDE +                         \
+	 (ch) * HDMA_CHANNEL_STRIDE)
+
+#define HDMA_CONTROL1_LLEN      BIT(0)
+#define HDMA_CYCLE_CONSUMER_BIT BIT(0)
+#define HDMA_CYCLE_CONSUMER_SET BIT(1)
+
+#define PCIE_DMA_CHANNELS    CONFIG_TT_BH_ARC_PCIE_DMA_CHANNELS
+#define PCIE_DMA_QUEUE_DEPTH CONFIG_TT_BH_ARC_PCIE_DMA_QUEUE_DEPTH
+#define PCIE_DMA_POLL_US     20
+
 typedef struct {
 	uint32_t stop_mask: 1;
 	uint32_t watermark_mask: 1;
@@ -82,127 +80,259 @@ typedef union {
 
 #define BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_WRCH_0_REG_DEFAULT (0x00000007)
 
-typedef struct {
-	uint32_t stop_mask: 1;
-	uint32_t watermark_mask: 1;
-	uint32_t abort_mask: 1;
-	uint32_t rsie: 1;
-	uint32_t lsie: 1;
-	uint32_t raie: 1;
-	uint32_t laie: 1;
-	uint32_t reserved_7_31: 25;
-} BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_RDCH_0_reg_t;
-
-typedef union {
-	uint32_t val;
-	BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_RDCH_0_reg_t f;
-} BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_RDCH_0_reg_u;
-
-#define BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_RDCH_0_REG_DEFAULT (0x00000007)
-
 typedef enum {
 	DMARunning = 1,
 	DMAAborted = 2,
 	DMAStopped = 3
 } DMAStatus;
 
-/* write transfer from the prespective of the chip. i.e., from chip to host */
-bool PcieDmaWriteTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transfer_size_bytes,
-			  uint64_t msi_completion_addr, uint8_t completion_data)
-{
-	/* reject dma request if there is a pending transaction */
-	uint32_t status = ReadDbiReg(HDMA_REG_ADDR(STATUS_OFF_WRCH_0));
+typedef enum {
+	DMAWrite = 0, /* chip to host */
+	DMARead = 1,  /* host to chip */
+	DMANumDirections,
+} DMADirection;
 
-	if (status == DMARunning) {
-		return false;
-	}
+typedef struct {
+	uint64_t chip_addr;
+	uint64_t host_addr;
+	uint64_t msi_completion_addr;
+	uint32_t transfer_size_bytes;
+	uint8_t completion_data;
+	bool linked_list;
+	/* Given when the transfer finishes. If set, the host is not sent an MSI. */
+	struct k_sem *done;
+} PcieDmaTransfer;
+
+/* Transfers of each direction run on the first idle channel, or wait here in order for one */
+typedef struct {
+	PcieDmaTransfer pending[PCIE_DMA_QUEUE_DEPTH];
+	uint32_t head;
+	uint32_t count;
+	uint32_t busy_channels;
+	struct k_sem *done[PCIE_DMA_CHANNELS];
+} PcieDmaQueue;
+
+static struct k_spinlock dma_lock;
+static PcieDmaQueue dma_queues[DMANumDirections];
 
+static void PcieDmaPollTimerHandler(struct k_timer *timer);
+static K_TIMER_DEFINE(dma_poll_timer, PcieDmaPollTimerHandler, NULL);
+
+static K_MUTEX_DEFINE(dma_wait_lock);
+static K_SEM_DEFINE(dma_wait_done, 0, 1);
+
+static void PcieDmaStart(DMADirection dir, uint8_t ch, const PcieDmaTransfer *transfer)
+{
 	/* Setup completion interrupt */
 	BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_WRCH_0_reg_u int_setup;
 
 	int_setup.val = 0;
-	int_setup.f.rsie = 1;
-	int_setup.f.raie = 1;
-	WriteDbiReg(HDMA_REG_ADDR(INT_SETUP_OFF_WRCH_0), int_setup.val);
-	WriteDbiReg(HDMA_REG_ADDR(MSI_STOP_LOW_OFF_WRCH_0), low32(msi_completion_addr));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_STOP_HIGH_OFF_WRCH_0), high32(msi_completion_addr));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_ABORT_LOW_OFF_WRCH_0),
-		    low32(msi_completion_addr + sizeof(uint32_t)));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_ABORT_HIGH_OFF_WRCH_0),
-		    high32(msi_completion_addr + sizeof(uint32_t)));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_MSGD_OFF_WRCH_0), completion_data);
-
-	/* Enable write channel 0 */
-	WriteDbiReg(HDMA_REG_ADDR(EN_OFF_WRCH_0), 0x1);
-
-	WriteDbiReg(HDMA_REG_ADDR(SAR_LOW_OFF_WRCH_0), low32(chip_addr));
-	WriteDbiReg(HDMA_REG_ADDR(SAR_HIGH_OFF_WRCH_0), high32(chip_addr));
-	WriteDbiReg(HDMA_REG_ADDR(DAR_LOW_OFF_WRCH_0), low32(host_addr));
-	WriteDbiReg(HDMA_REG_ADDR(DAR_HIGH_OFF_WRCH_0), high32(host_addr));
-	WriteDbiReg(HDMA_REG_ADDR(XFERSIZE_OFF_WRCH_0), transfer_size_bytes);
-	WriteDbiReg(HDMA_REG_ADDR(DOORBELL_OFF_WRCH_0), 0x1);
-
-	return true;
+	if (transfer->done != NULL) {
+		/* Stop and abort stay masked, an on-chip waiter polls for completion */
+		int_setup.f.stop_mask = 1;
+		int_setup.f.abort_mask = 1;
+		WriteDbiReg(HDMA_CH_REG_ADDR(INT_SETUP, dir, ch), int_setup.val);
+	} else {
+		int_setup.f.rsie = 1;
+		int_setup.f.raie = 1;
+		WriteDbiReg(HDMA_CH_REG_ADDR(INT_SETUP, dir, ch), int_setup.val);
+		WriteDbiReg(HDMA_CH_REG_ADDR(MSI_STOP_LOW, dir, ch),
+			    low32(transfer->msi_completion_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(MSI_STOP_HIGH, dir, ch),
+			    high32(transfer->msi_completion_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(MSI_ABORT_LOW, dir, ch),
+			    low32(transfer->msi_completion_addr + sizeof(uint32_t)));
+		WriteDbiReg(HDMA_CH_REG_ADDR(MSI_ABORT_HIGH, dir, ch),
+			    high32(transfer->msi_completion_addr + sizeof(uint32_t)));
+		WriteDbiReg(HDMA_CH_REG_ADDR(MSI_MSGD, dir, ch), transfer->completion_data);
+	}
+
+	WriteDbiReg(HDMA_CH_REG_ADDR(EN, dir, ch), 0x1);
+
+	if (transfer->linked_list) {
+		/* The HDMA fetches the elements from chip memory, starting in consumer cycle 1 */
+		WriteDbiReg(HDMA_CH_REG_ADDR(CONTROL1, dir, ch), HDMA_CONTROL1_LLEN);
+		WriteDbiReg(HDMA_CH_REG_ADDR(LLP_LOW, dir, ch), low32(transfer->chip_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(LLP_HIGH, dir, ch), high32(transfer->chip_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(CYCLE, dir, ch),
+			    HDMA_CYCLE_CONSUMER_SET | HDMA_CYCLE_CONSUMER_BIT);
+	} else {
+		uint64_t src_addr = dir == DMAWrite ? transfer->chip_addr : transfer->host_addr;
+		uint64_t dst_addr = dir == DMAWrite ? transfer->host_addr : transfer->chip_addr;
+
+		WriteDbiReg(HDMA_CH_REG_ADDR(CONTROL1, dir, ch), 0);
+		WriteDbiReg(HDMA_CH_REG_ADDR(SAR_LOW, dir, ch), low32(src_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(SAR_HIGH, dir, ch), high32(src_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(DAR_LOW, dir, ch), low32(dst_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(DAR_HIGH, dir, ch), high32(dst_addr));
+		WriteDbiReg(HDMA_CH_REG_ADDR(XFERSIZE, dir, ch), transfer->transfer_size_bytes);
+	}
+
+	WriteDbiReg(HDMA_CH_REG_ADDR(DOORBELL, dir, ch), 0x1);
 }
 
-/* read transfer from the prespective of the chip. i.e., host to chip */
-bool PcieDmaReadTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transfer_size_bytes,
-			 uint64_t msi_completion_addr, uint8_t completion_data)
+/* Retire finished transfers and start queued ones on the channels they free up. The host learns
+ * of completion from the HDMA's MSI, this only recycles channels and wakes on-chip waiters.
+ * Returns true while any channel is busy.
+ */
+static bool PcieDmaServiceQueues(void)
 {
-	/* reject dma request if there is a pending transaction */
-	uint32_t status = ReadDbiReg(HDMA_REG_ADDR(STATUS_OFF_RDCH_0));
+	k_spinlock_key_t key = k_spin_lock(&dma_lock);
+	bool busy = false;
+
+	for (DMADirection dir = 0; dir < DMANumDirections; dir++) {
+		PcieDmaQueue *queue = &dma_queues[dir];
+
+		for (uint8_t ch = 0; ch < PCIE_DMA_CHANNELS; ch++) {
+			if (!(queue->busy_channels & BIT(ch)) ||
+			    ReadDbiReg(HDMA_CH_REG_ADDR(STATUS, dir, ch)) == DMARunning) {
+				continue;
+			}
 
-	if (status == DMARunning) {
-		return false;
+			if (queue->done[ch] != NULL) {
+				k_sem_give(queue->done[ch]);
+			}
+
+			if (queue->count > 0) {
+				PcieDmaStart(dir, ch, &queue->pending[queue->head]);
+				queue->done[ch] = queue->pending[queue->head].done;
+				queue->head = (queue->head + 1) % PCIE_DMA_QUEUE_DEPTH;
+				queue->count--;
+			} else {
+				queue->busy_channels &= ~BIT(ch);
+			}
+		}
+
+		busy |= queue->busy_channels != 0;
 	}
 
-	/* Setup completion interrupt */
-	BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_RDCH_0_reg_u int_setup;
+	k_spin_unlock(&dma_lock, key);
 
-	int_setup.val = 0;
-	int_setup.f.rsie = 1;
-	int_setup.f.raie = 1;
-	WriteDbiReg(HDMA_REG_ADDR(INT_SETUP_OFF_RDCH_0), int_setup.val);
-	WriteDbiReg(HDMA_REG_ADDR(MSI_STOP_LOW_OFF_RDCH_0), low32(msi_completion_addr));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_STOP_HIGH_OFF_RDCH_0), high32(msi_completion_addr));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_ABORT_LOW_OFF_RDCH_0),
-		    low32(msi_completion_addr + sizeof(uint32_t)));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_ABORT_HIGH_OFF_RDCH_0),
-		    high32(msi_completion_addr + sizeof(uint32_t)));
-	WriteDbiReg(HDMA_REG_ADDR(MSI_MSGD_OFF_RDCH_0), completion_data);
-
-	/* Enable read channel 0 */
-	WriteDbiReg(HDMA_REG_ADDR(EN_OFF_RDCH_0), 0x1);
-
-	WriteDbiReg(HDMA_REG_ADDR(SAR_LOW_OFF_RDCH_0), low32(host_addr));
-	WriteDbiReg(HDMA_REG_ADDR(SAR_HIGH_OFF_RDCH_0), high32(host_addr));
-	WriteDbiReg(HDMA_REG_ADDR(DAR_LOW_OFF_RDCH_0), low32(chip_addr));
-	WriteDbiReg(HDMA_REG_ADDR(DAR_HIGH_OFF_RDCH_0), high32(chip_addr));
-	WriteDbiReg(HDMA_REG_ADDR(XFERSIZE_OFF_RDCH_0), transfer_size_bytes);
-	WriteDbiReg(HDMA_REG_ADDR(DOORBELL_OFF_RDCH_0), 0x1);
-
-	return true;
+	return busy;
 }
 
-static uint8_t pcie_dma_transfer_handler(const union request *request, struct response *response)
+static void PcieDmaPollTimerHandler(struct k_timer *timer)
 {
-	uint8_t completion_data = (request->data[0] >> 8) & 0xff;
-	uint32_t transfer_size_bytes = request->data[1];
-	uint64_t chip_addr = ((uint64_t)request->data[3] << 32) | request->data[2];
-	uint64_t host_addr = ((uint64_t)request->data[5] << 32) | request->data[4];
-	uint64_t msi_completion_addr = ((uint64_t)request->data[7] << 32) | request->data[6];
+	if (!PcieDmaServiceQueues()) {
+		k_timer_stop(timer);
+	}
+}
 
-	bool accept;
+/* Start the transfer on an idle channel, or queue it behind the busy ones. Returns false if the
+ * queue is full, or if every channel is held by a transfer this queue did not start.
+ */
+static bool PcieDmaSubmit(DMADirection dir, const PcieDmaTransfer *transfer)
+{
+	k_spinlock_key_t key = k_spin_lock(&dma_lock);
+	PcieDmaQueue *queue = &dma_queues[dir];
+	bool was_idle = dma_queues[DMAWrite].busy_channels == 0 &&
+			dma_queues[DMARead].busy_channels == 0;
+	bool accept = true;
+	uint8_t ch;
 
-	if (request->command_code == TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER) {
-		accept = PcieDmaReadTransfer(chip_addr, host_addr, transfer_size_bytes,
-					     msi_completion_addr, completion_data);
+	/* Leave alone channels that something other than this queue has started */
+	for (ch = 0; ch < PCIE_DMA_CHANNELS; ch++) {
+		if (!(queue->busy_channels & BIT(ch)) &&
+		    ReadDbiReg(HDMA_CH_REG_ADDR(STATUS, dir, ch)) != DMARunning) {
+			break;
+		}
+	}
+
+	if (ch < PCIE_DMA_CHANNELS) {
+		PcieDmaStart(dir, ch, transfer);
+		queue->busy_channels |= BIT(ch);
+		queue->done[ch] = transfer->done;
+	} else if (queue->busy_channels != 0 && queue->count < PCIE_DMA_QUEUE_DEPTH) {
+		queue->pending[(queue->head + queue->count) % PCIE_DMA_QUEUE_DEPTH] = *transfer;
+		queue->count++;
 	} else {
-		accept = PcieDmaWriteTransfer(chip_addr, host_addr, transfer_size_bytes,
-					      msi_completion_addr, completion_data);
+		accept = false;
+	}
+
+	k_spin_unlock(&dma_lock, key);
+
+	if (accept && was_idle) {
+		k_timer_start(&dma_poll_timer, K_USEC(PCIE_DMA_POLL_US), K_USEC(PCIE_DMA_POLL_US));
+	}
+
+	return accept;
+}
+
+/* Stop a waiter from being woken by its transfer. A transfer still in the queue is dropped, one
+ * already running is left to finish without giving done.
+ */
+static void PcieDmaForgetWaiter(DMADirection dir, const struct k_sem *done)
+{
+	k_spinlock_key_t key = k_spin_lock(&dma_lock);
+	PcieDmaQueue *queue = &dma_queues[dir];
+	uint32_t kept = 0;
+
+	for (uint8_t ch = 0; ch < PCIE_DMA_CHANNELS; ch++) {
+		if (queue->done[ch] == done) {
+			queue->done[ch] = NULL;
+		}
+	}
+
+	for (uint32_t i = 0; i < queue->count; i++) {
+		PcieDmaTransfer *transfer =
+			&queue->pending[(queue->head + i) % PCIE_DMA_QUEUE_DEPTH];
+
+		if (transfer->done != done) {
+			queue->pending[(queue->head + kept) % PCIE_DMA_QUEUE_DEPTH] = *transfer;
+			kept++;
+		}
 	}
+	queue->count = kept;
+
+	k_spin_unlock(&dma_lock, key);
+}
+
+int PcieDmaTransferWait(bool chip_to_host, uint64_t chip_addr, uint64_t host_addr,
+			uint32_t transfer_size_bytes, k_timeout_t timeout)
+{
+	PcieDmaTransfer transfer = {
+		.chip_addr = chip_addr,
+		.host_addr = host_addr,
+		.transfer_size_bytes = transfer_size_bytes,
+		.done = &dma_wait_done,
+	};
+
+	DMADirection dir = chip_to_host ? DMAWrite : DMARead;
+	int ret = 0;
+
+	k_mutex_lock(&dma_wait_lock, K_FOREVER);
+	k_sem_reset(&dma_wait_done);
+
+	if (!PcieDmaSubmit(dir, &transfer)) {
+		ret = -EBUSY;
+	} else if (k_sem_take(&dma_wait_done, timeout) != 0) {
+		/* A late completion must not wake the next waiter before its transfer is done */
+		PcieDmaForgetWaiter(dir, &dma_wait_done);
+		ret = -ETIMEDOUT;
+	}
+
+	k_mutex_unlock(&dma_wait_lock);
+
+	return ret;
+}
+
+static uint8_t pcie_dma_transfer_handler(const union request *request, struct response *response)
+{
+	const struct pcie_dma_transfer_rqst *rqst = &request->pcie_dma_transfer;
+	DMADirection dir = request->command_code == TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER
+				   ? DMARead
+				   : DMAWrite;
+	PcieDmaTransfer transfer = {
+		.chip_addr = ((uint64_t)rqst->chip_addr_hi << 32) | rqst->chip_addr_lo,
+		.host_addr = ((uint64_t)rqst->host_addr_hi << 32) | rqst->host_addr_lo,
+		.msi_completion_addr = ((uint64_t)rqst->msi_completion_addr_hi << 32) |
+				       rqst->msi_completion_addr_lo,
+		.transfer_size_bytes = rqst->transfer_size_bytes,
+		.completion_data = rqst->completion_data,
+		.linked_list = rqst->linked_list,
+	};
 
-	return accept ? 0 : 1;
+	return PcieDmaSubmit(dir, &transfer) ? 0 : 1;
 }
 
 REGISTER_MESSAGE(TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER, pcie_dma_transfer_handler);
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PCIE_DMA_H
+#define PCIE_DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+/* Run a single-segment transfer through the host request queues without sending the host an MSI,
+ * and wait for it to finish. Returns -EBUSY if the queue is full and -ETIMEDOUT if the transfer
+ * has not finished after the timeout. A timed out transfer that was still queued is dropped, but
+ * one that had started keeps running, so its buffers may still be accessed for a while.
+ */
+int PcieDmaTransferWait(bool chip_to_host, uint64_t chip_addr, uint64_t host_addr,
+			uint32_t transfer_size_bytes, k_timeout_t timeout);
+
+#endif
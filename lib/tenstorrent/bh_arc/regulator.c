@@ -85,36 +85,82 @@ static float ConvertLinear11ToFloat(uint16_t value)
 	return ldexp(mantissa, exponent);
 }
 
-/* The function returns the core current in A. */
-float GetVcoreCurrent(void)
+/* Reads the core current in A. Returns the I2C error, *current_in_a is only set on success. */
+uint32_t GetVcoreCurrent(float *current_in_a)
 {
+	uint16_t iout = 0;
+
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, P0V8_VCORE_ADDR, I2CFastMode, PMBUS_MST_ID);
-	uint16_t iout;
+	uint32_t i2c_error = I2CReadBytes(PMBUS_MST_ID, READ_IOUT, PMBUS_CMD_BYTE_SIZE,
+					  (uint8_t *)&iout, READ_IOUT_DATA_BYTE_SIZE,
+					  PMBUS_FLIP_BYTES);
+	I2CUnlock(PMBUS_MST_ID);
 
-	I2CReadBytes(PMBUS_MST_ID, READ_IOUT, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&iout,
-		     READ_IOUT_DATA_BYTE_SIZE, PMBUS_FLIP_BYTES);
-	return ConvertLinear11ToFloat(iout);
+	if (i2c_error == 0) {
+		*current_in_a = ConvertLinear11ToFloat(iout);
+	}
+	return i2c_error;
 }
 
-/* The function returns the core power in W. */
-float GetVcorePower(void)
+/* Reads the core power in W. Returns the I2C error, *power_in_w is only set on success. */
+uint32_t GetVcorePower(float *power_in_w)
 {
+	uint16_t pout = 0;
+
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, P0V8_VCORE_ADDR, I2CFastMode, PMBUS_MST_ID);
-	uint16_t pout;
+	uint32_t i2c_error = I2CReadBytes(PMBUS_MST_ID, READ_POUT, PMBUS_CMD_BYTE_SIZE,
+					  (uint8_t *)&pout, READ_POUT_DATA_BYTE_SIZE,
+					  PMBUS_FLIP_BYTES);
+	I2CUnlock(PMBUS_MST_ID);
 
-	I2CReadBytes(PMBUS_MST_ID, READ_POUT, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&pout,
-		     READ_POUT_DATA_BYTE_SIZE, PMBUS_FLIP_BYTES);
-	return ConvertLinear11ToFloat(pout);
+	if (i2c_error == 0) {
+		*power_in_w = ConvertLinear11ToFloat(pout);
+	}
+	return i2c_error;
+}
+
+/* Reads the Vcore current, power and voltage in one batch of PMBus reads. Returns the I2C error,
+ * *telemetry is only set on success.
+ */
+uint32_t ReadVcoreTelemetry(VcoreTelemetry *telemetry)
+{
+	static const uint8_t commands[] = {READ_IOUT, READ_POUT, READ_VOUT};
+	uint16_t data[ARRAY_SIZE(commands)];
+
+	BUILD_ASSERT(READ_IOUT_DATA_BYTE_SIZE == sizeof(data[0]) &&
+		     READ_POUT_DATA_BYTE_SIZE == sizeof(data[0]) &&
+		     READ_VOUT_DATA_BYTE_SIZE == sizeof(data[0]));
+
+	I2CLock(PMBUS_MST_ID);
+	I2CInit(I2CMst, P0V8_VCORE_ADDR, I2CFastMode, PMBUS_MST_ID);
+	uint32_t i2c_error = I2CReadBytesBatch(PMBUS_MST_ID, commands, ARRAY_SIZE(commands),
+					       (uint8_t *)data, sizeof(data[0]));
+	I2CUnlock(PMBUS_MST_ID);
+
+	if (i2c_error) {
+		return i2c_error;
+	}
+
+	telemetry->current = ConvertLinear11ToFloat(data[0]);
+	telemetry->power = ConvertLinear11ToFloat(data[1]);
+	/* Same encoding as i2c_get_max20816 */
+	telemetry->voltage = data[2] * 0.5f;
+
+	return 0;
 }
 
 static void set_max20730(uint32_t slave_addr, uint32_t voltage_in_mv, float rfb1, float rfb2)
 {
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, slave_addr, I2CFastMode, PMBUS_MST_ID);
 	float vref = voltage_in_mv / (1 + rfb1 / rfb2);
 	uint16_t vout_cmd = vref * LINEAR_FORMAT_CONSTANT * 0.001f;
 
 	I2CWriteBytes(PMBUS_MST_ID, VOUT_COMMAND, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&vout_cmd,
 		      VOUT_COMMAND_DATA_BYTE_SIZE);
+	I2CUnlock(PMBUS_MST_ID);
 
 	/* delay to flush i2c transaction and voltage change */
 	WaitUs(250);
@@ -122,11 +168,13 @@ static void set_max20730(uint32_t slave_addr, uint32_t voltage_in_mv, float rfb1
 
 static void set_mpm3695(uint32_t slave_addr, uint32_t voltage_in_mv, float rfb1, float rfb2)
 {
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, slave_addr, I2CFastMode, PMBUS_MST_ID);
 	uint16_t vout_cmd = voltage_in_mv * 0.5f / SCALE_LOOP / (1 + rfb1 / rfb2);
 
 	I2CWriteBytes(PMBUS_MST_ID, VOUT_COMMAND, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&vout_cmd,
 		      VOUT_COMMAND_DATA_BYTE_SIZE);
+	I2CUnlock(PMBUS_MST_ID);
 
 	/* delay to flush i2c transaction and voltage change */
 	WaitUs(250);
@@ -135,11 +183,13 @@ static void set_mpm3695(uint32_t slave_addr, uint32_t voltage_in_mv, float rfb1,
 /* Set MAX20816 voltage using I2C, MAX20816 is used for Vcore and Vcorem */
 static void i2c_set_max20816(uint32_t slave_addr, uint32_t voltage_in_mv)
 {
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, slave_addr, I2CFastMode, PMBUS_MST_ID);
 	uint16_t vout_cmd = 2 * voltage_in_mv;
 
 	I2CWriteBytes(PMBUS_MST_ID, VOUT_COMMAND, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&vout_cmd,
 		      VOUT_COMMAND_DATA_BYTE_SIZE);
+	I2CUnlock(PMBUS_MST_ID);
 
 	/* 100us to flush the tx of i2c + 150us to cover voltage switch from 0.65V to 0.95V with
 	 * 50us of margin
@@ -150,11 +200,13 @@ static void i2c_set_max20816(uint32_t slave_addr, uint32_t voltage_in_mv)
 /* Returns MAX20816 output volage in mV. */
 static float i2c_get_max20816(uint32_t slave_addr)
 {
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, slave_addr, I2CFastMode, PMBUS_MST_ID);
 	uint16_t vout_cmd = 0;
 
 	I2CReadBytes(PMBUS_MST_ID, READ_VOUT, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&vout_cmd,
 		     READ_VOUT_DATA_BYTE_SIZE, PMBUS_FLIP_BYTES);
+	I2CUnlock(PMBUS_MST_ID);
 
 	return vout_cmd * 0.5f;
 }
@@ -168,6 +220,25 @@ void set_vcore(uint32_t voltage_in_mv)
 	}
 }
 
+/* Over AVSBus, only queue the VCORE change. wait_vcore_settled() waits for the rail to reach the
+ * new voltage.
+ */
+void set_vcore_async(uint32_t voltage_in_mv)
+{
+	if (vout_cmd_source == AVSVoutCommand &&
+	    AVSWriteVoltageAsync(voltage_in_mv, AVS_VCORE_RAIL, NULL, NULL) == 0) {
+		return;
+	}
+
+	set_vcore(voltage_in_mv);
+}
+
+/* Returns -EAGAIN if the rail did not settle within AVS_TIMEOUT_US */
+int wait_vcore_settled(void)
+{
+	return AVSWaitSlew(AVS_VCORE_RAIL, K_USEC(AVS_TIMEOUT_US));
+}
+
 uint32_t get_vcore(void)
 {
 	return i2c_get_max20816(P0V8_VCORE_ADDR);
@@ -198,6 +269,7 @@ void set_gddr_vddr(PcbType board_type, uint32_t voltage_in_mv)
 
 void SwitchVoutControl(VoltageCmdSource source)
 {
+	I2CLock(PMBUS_MST_ID);
 	I2CInit(I2CMst, P0V8_VCORE_ADDR, I2CFastMode, PMBUS_MST_ID);
 	OperationBits operation;
 
@@ -208,6 +280,7 @@ void SwitchVoutControl(VoltageCmdSource source)
 	operation.voltage_command_source = source;
 	I2CWriteBytes(PMBUS_MST_ID, OPERATION, PMBUS_CMD_BYTE_SIZE, (uint8_t *)&operation,
 		      OPERATION_DATA_BYTE_SIZE);
+	I2CUnlock(PMBUS_MST_ID);
 
 	/* 100us to flush the tx of i2c */
 	WaitUs(100);
@@ -240,6 +313,7 @@ uint32_t RegulatorInit(PcbType board_type)
 			const RegulatorConfig *regulator_config =
 				regulators_config->regulator_config + i;
 
+			I2CLock(PMBUS_MST_ID);
 			I2CInit(I2CMst, regulator_config->address, I2CFastMode, PMBUS_MST_ID);
 
 			for (uint32_t j = 0; j < regulator_config->count; j++) {
@@ -277,6 +351,7 @@ uint32_t RegulatorInit(PcbType board_type)
 					}
 				}
 			}
+			I2CUnlock(PMBUS_MST_ID);
 		}
 	}
 	return aggregate_i2c_errors;
@@ -30,12 +30,21 @@ typedef enum {
 	AVSVoutCommand = 3,
 } VoltageCmdSource;
 
+typedef struct {
+	float current; /* A */
+	float power;   /* W */
+	float voltage; /* mV */
+} VcoreTelemetry;
+
 uint32_t get_vcore(void);  /* returns voltage in mV. */
 uint32_t get_vcorem(void); /* returns voltage in mV. */
 void set_vcore(uint32_t voltage_in_mv);
+void set_vcore_async(uint32_t voltage_in_mv);
+int wait_vcore_settled(void);
 void set_vcorem(uint32_t voltage_in_mv);
 void set_gddr_vddr(PcbType board_type, uint32_t voltage_in_mv);
-float GetVcoreCurrent(void);
-float GetVcorePower(void);
+uint32_t GetVcoreCurrent(float *current_in_a);
+uint32_t GetVcorePower(float *power_in_w);
+uint32_t ReadVcoreTelemetry(VcoreTelemetry *telemetry);
 void SwitchVoutControl(VoltageCmdSource source);
 #endif
@@ -47,7 +47,6 @@ static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtab
 STATUS_ERROR_STATUS0_reg_u error_status0;
 
 static const uint8_t kNocRing;
-static const uint8_t kNocTlb;
 static const uint32_t kSoftReset0Addr = 0xFFB121B0; /* NOC address in each tile */
 static const uint32_t kAllRiscSoftReset = 0x47800;
 
@@ -55,8 +54,19 @@ void bh_soft_reset_all_tensix(void)
 {
 	/* Broadcast to SOFT_RESET_0 of all Tensixes */
 	/* Harvesting is handled by broadcast disables of NocInit */
-	NOC2AXITensixBroadcastTlbSetup(kNocRing, kNocTlb, kSoftReset0Addr, kNoc2AxiOrderingStrict);
-	NOC2AXIWrite32(kNocRing, kNocTlb, kSoftReset0Addr, kAllRiscSoftReset);
+	uint8_t tlb =
+		NOC2AXITensixBroadcastTlbAcquire(kNocRing, kSoftReset0Addr, kNoc2AxiOrderingStrict);
+
+	NOC2AXIWrite32(kNocRing, tlb, kSoftReset0Addr, kAllRiscSoftReset);
+	NOC2AXITlbRelease(kNocRing, tlb);
+}
+
+static void SoftResetTile(uint8_t x, uint8_t y)
+{
+	uint8_t tlb = NOC2AXITlbAcquire(kNocRing, x, y, kSoftReset0Addr);
+
+	NOC2AXIWrite32(kNocRing, tlb, kSoftReset0Addr, kAllRiscSoftReset);
+	NOC2AXITlbRelease(kNocRing, tlb);
 }
 
 /* Assert soft reset for all RISC-V cores */
@@ -78,8 +88,7 @@ static int AssertSoftResets(void)
 		/* Skip harvested ETH tiles */
 		if (tile_enable.eth_enabled & BIT(eth_inst)) {
 			GetEthNocCoords(eth_inst, kNocRing, &x, &y);
-			NOC2AXITlbSetup(kNocRing, kNocTlb, x, y, kSoftReset0Addr);
-			NOC2AXIWrite32(kNocRing, kNocTlb, kSoftReset0Addr, kAllRiscSoftReset);
+			SoftResetTile(x, y);
 		}
 	}
 
@@ -92,9 +101,7 @@ static int AssertSoftResets(void)
 				uint8_t x, y;
 
 				GetGddrNocCoords(gddr_inst, noc_node_inst, kNocRing, &x, &y);
-				NOC2AXITlbSetup(kNocRing, kNocTlb, x, y, kSoftReset0Addr);
-				NOC2AXIWrite32(kNocRing, kNocTlb, kSoftReset0Addr,
-					       kAllRiscSoftReset);
+				SoftResetTile(x, y);
 			}
 		}
 	}
@@ -15,18 +15,20 @@
 
 LOG_MODULE_REGISTER(eth_serdes, CONFIG_TT_APP_LOG_LEVEL);
 
-#define SERDES_ETH_SETUP_TLB 0
-
 static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
 
-static inline void SetupSerdesTlb(uint32_t serdes_inst, uint32_t ring, uint64_t addr)
+/* TLB entry mapping the SerDes registers while LoadSerdesEthRegs runs */
+static uint8_t serdes_reg_ring;
+static uint8_t serdes_reg_tlb;
+
+static inline uint8_t AcquireSerdesTlb(uint32_t serdes_inst, uint32_t ring, uint64_t addr)
 {
 	/* Logical X,Y coordinates */
 	uint8_t x, y;
 
 	GetSerdesNocCoords(serdes_inst, ring, &x, &y);
 
-	NOC2AXITlbSetup(ring, SERDES_ETH_SETUP_TLB, x, y, addr);
+	return NOC2AXITlbAcquire(ring, x, y, addr);
 }
 
 static int NOC2AxiWrite32SerdesReg(uint8_t *src, uint8_t *dst, size_t len)
@@ -35,7 +37,8 @@ static int NOC2AxiWrite32SerdesReg(uint8_t *src, uint8_t *dst, size_t len)
 	uint32_t reg_count = len / sizeof(SerdesRegData);
 
 	for (uint32_t i = 0; i < reg_count; i++) {
-		NOC2AXIWrite32(0, SERDES_ETH_SETUP_TLB, reg_table[i].addr, reg_table[i].data);
+		NOC2AXIWrite32(serdes_reg_ring, serdes_reg_tlb, reg_table[i].addr,
+			       reg_table[i].data);
 	}
 	return 0;
 }
@@ -43,9 +46,13 @@ static int NOC2AxiWrite32SerdesReg(uint8_t *src, uint8_t *dst, size_t len)
 void LoadSerdesEthRegs(uint32_t serdes_inst, uint32_t ring, uint8_t *buf, size_t buf_size,
 		       size_t spi_address, size_t image_size)
 {
-	SetupSerdesTlb(serdes_inst, ring, SERDES_INST_BASE_ADDR(serdes_inst) + CMN_OFFSET);
+	uint64_t cmn_addr = SERDES_INST_BASE_ADDR(serdes_inst) + CMN_OFFSET;
+
+	serdes_reg_ring = ring;
+	serdes_reg_tlb = AcquireSerdesTlb(serdes_inst, ring, cmn_addr);
 	spi_transfer_by_parts(flash, spi_address, image_size, buf, buf_size, NULL,
 			      NOC2AxiWrite32SerdesReg);
+	NOC2AXITlbRelease(ring, serdes_reg_tlb);
 }
 
 int LoadSerdesEthFw(uint32_t serdes_inst, uint32_t ring, uint8_t *buf, size_t buf_size,
@@ -53,11 +60,12 @@ int LoadSerdesEthFw(uint32_t serdes_inst, uint32_t ring, uint8_t *buf, size_t bu
 {
 	int rc;
 
-	SetupSerdesTlb(serdes_inst, 0, SERDES_INST_SRAM_ADDR(serdes_inst));
+	uint8_t tlb = AcquireSerdesTlb(serdes_inst, ring, SERDES_INST_SRAM_ADDR(serdes_inst));
 	volatile uint32_t *serdes_tlb =
-		GetTlbWindowAddr(ring, SERDES_ETH_SETUP_TLB, SERDES_INST_SRAM_ADDR(serdes_inst));
+		GetTlbWindowAddr(ring, tlb, SERDES_INST_SRAM_ADDR(serdes_inst));
 	rc = spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
 					  (uint8_t *)serdes_tlb);
+	NOC2AXITlbRelease(ring, tlb);
 
 	return rc;
 }
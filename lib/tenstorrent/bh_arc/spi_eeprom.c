@@ -41,6 +41,15 @@ static bool flash_locked = true;
 
 static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
 
+/* State of the SPI write whose response is deferred until the write completes. */
+static struct {
+	struct msgqueue_deferred_response deferred;
+	atomic_t busy;
+	uint32_t spi_address;
+	uint32_t num_bytes;
+	const uint8_t *data;
+} eeprom_write;
+
 static void EepromSetup(void)
 {
 	/* Setup SPI buffer address */
@@ -189,9 +198,26 @@ static uint8_t read_eeprom_handler(const union request *request, struct response
 		return 1;
 	}
 
+	if (atomic_get(&eeprom_write.busy)) {
+		/* A pending write is still using the scratch buffer and the flash */
+		return EBUSY;
+	}
+
 	return SpiBlockRead(spi_address, num_bytes, csm_addr);
 }
 
+static void eeprom_write_work_handler(struct k_work *work)
+{
+	int rc = SpiSmartWrite(eeprom_write.spi_address, eeprom_write.data, eeprom_write.num_bytes);
+	/* Once busy is clear a new write may take over eeprom_write, so respond via a copy */
+	struct msgqueue_deferred_response deferred = eeprom_write.deferred;
+
+	atomic_clear(&eeprom_write.busy);
+	msgqueue_complete_deferred_response(&deferred, rc, NULL);
+}
+
+static K_WORK_DEFINE(eeprom_write_work, eeprom_write_work_handler);
+
 static uint8_t write_eeprom_handler(const union request *request, struct response *response)
 {
 	uint8_t buffer_mem_type = BYTE_GET(request->data[0], 1);
@@ -218,7 +244,28 @@ static uint8_t write_eeprom_handler(const union request *request, struct respons
 		return 1;
 	}
 
-	return SpiSmartWrite(spi_address, csm_addr, num_bytes);
+	if (!atomic_cas(&eeprom_write.busy, 0, 1)) {
+		/* A write from another message queue is still in flight */
+		return EBUSY;
+	}
+
+	/* Writes can take seconds, so finish them off the message queue and respond later. */
+	eeprom_write.spi_address = spi_address;
+	eeprom_write.num_bytes = num_bytes;
+	eeprom_write.data = csm_addr;
+	if (msgqueue_defer_response(&eeprom_write.deferred) != 0) {
+		int rc = SpiSmartWrite(spi_address, csm_addr, num_bytes);
+
+		atomic_clear(&eeprom_write.busy);
+		return rc;
+	}
+
+	if (msgqueue_submit_deferred_work(&eeprom_write_work) < 0) {
+		/* No deferred work queue; complete in place. */
+		eeprom_write_work_handler(&eeprom_write_work);
+	}
+
+	return 0;
 }
 
 /* Challenge message issued from tt-flash to confirm a firmware update. */
@@ -230,12 +277,20 @@ static uint8_t confirm_flashed_spi_handler(const union request *request, struct
 
 static uint8_t flash_lock_handler(const union request *request, struct response *response)
 {
+	if (atomic_get(&eeprom_write.busy)) {
+		return EBUSY;
+	}
+
 	flash_locked = true;
 	return 0;
 }
 
 static uint8_t flash_unlock_handler(const union request *request, struct response *response)
 {
+	if (atomic_get(&eeprom_write.busy)) {
+		return EBUSY;
+	}
+
 	flash_locked = false;
 	return 0;
 }
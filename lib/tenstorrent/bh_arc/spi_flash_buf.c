@@ -49,18 +49,80 @@ int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t i
 	return rc;
 }
 
-static int arc_dma_transfer_wrapper(uint8_t *src, uint8_t *dst, size_t len)
+/*
+ * Stream an image to one or more tiles through two halves of buf: while one half is DMA-ing out,
+ * the next chunk is read from flash into the other, so the SPI bus and the DMA engine overlap.
+ * Each chunk is read once and copied to every destination.
+ */
+int spi_arc_dma_transfer_to_tiles(const struct device *dev, size_t spi_address, size_t image_size,
+				  uint8_t *buf, size_t buf_size, uint8_t *const *tlb_dsts,
+				  size_t num_dsts)
 {
-	if (dma_arc_hs_transfer(arc_dma_dev, 0, src, dst, len, K_MSEC(500)) < 0) {
-		LOG_ERR("%s() failed: %d", "dma_arc_hs_transfer", -EIO);
-		return -EIO;
+	/* Both halves must stay 4-byte aligned for the DMA */
+	size_t half = ROUND_DOWN(buf_size / 2, sizeof(uint32_t));
+
+	if ((buf == NULL) || (half == 0)) {
+		return -EINVAL;
+	}
+
+	if (image_size > (size_t)INT32_MAX) {
+		return -E2BIG;
+	}
+
+	if ((image_size == 0) || (num_dsts == 0)) {
+		return 0;
+	}
+
+	uint8_t *halves[2] = {buf, buf + half};
+	size_t offset = 0;
+	size_t len = MIN(half, image_size);
+	int rc = flash_read(dev, spi_address, halves[0], len);
+
+	if (rc < 0) {
+		LOG_ERR("%s() failed: %d", "flash_read", rc);
+		return rc;
 	}
+
+	for (int cur = 0; len > 0; cur ^= 1) {
+		size_t next_offset = offset + len;
+		size_t next_len = MIN(half, image_size - next_offset);
+		int read_rc = 0;
+
+		for (size_t i = 0; i < num_dsts && rc == 0; i++) {
+			rc = dma_arc_hs_transfer_start(arc_dma_dev, 0, halves[cur],
+						       tlb_dsts[i] + offset, len);
+			if (rc < 0) {
+				break;
+			}
+
+			/* The next read overlaps the first copy of this chunk */
+			if (i == 0 && next_len > 0) {
+				read_rc = flash_read(dev, spi_address + next_offset,
+						     halves[cur ^ 1], next_len);
+			}
+			rc = dma_arc_hs_transfer_wait(arc_dma_dev, 0, K_MSEC(500));
+		}
+
+		if (rc < 0) {
+			LOG_ERR("%s() failed: %d", "dma_arc_hs_transfer", rc);
+			return -EIO;
+		}
+
+		if (read_rc < 0) {
+			LOG_ERR("%s() failed: %d", "flash_read", read_rc);
+			return read_rc;
+		}
+
+		offset = next_offset;
+		len = next_len;
+	}
+
 	return 0;
 }
 
 int spi_arc_dma_transfer_to_tile(const struct device *dev, size_t spi_address, size_t image_size,
 				 uint8_t *buf, size_t buf_size, uint8_t *tlb_dst)
 {
-	return spi_transfer_by_parts(dev, spi_address, image_size, buf, buf_size, tlb_dst,
-				     arc_dma_transfer_wrapper);
+	return spi_arc_dma_transfer_to_tiles(dev, spi_address, image_size, buf, buf_size, &tlb_dst,
+					     1);
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "aiclk_ppm.h"
 #include "cat.h"
 #include "cm2dm_msg.h"
 #include "fan_ctrl.h"
@@ -14,6 +15,7 @@
 #include "status_reg.h"
 #include "telemetry.h"
 #include "telemetry_internal.h"
+#include "telemetry_history.h"
 #include "gddr.h"
 
 #include <float.h> /* for FLT_MAX */
@@ -28,6 +30,14 @@
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/clock_control/clock_control_tt_bh.h>
 #include <zephyr/drivers/clock_control.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/barrier.h>
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
 
 LOG_MODULE_REGISTER(telemetry, CONFIG_TT_APP_LOG_LEVEL);
 
@@ -162,6 +172,28 @@ static struct telemetry_table telemetry_table = {
 		[57] = {TAG_TDC_LIMIT_MAX, TELEM_OFFSET(TAG_TDC_LIMIT_MAX)},
 		[58] = {TAG_THM_LIMIT_THROTTLE, TELEM_OFFSET(TAG_THM_LIMIT_THROTTLE)},
 		[59] = {TAG_TDP_LIMIT_MAX, TELEM_OFFSET(TAG_TDP_LIMIT_MAX)},
+		[60] = {TAG_TELEM_GENERATION, TELEM_OFFSET(TAG_TELEM_GENERATION)},
+		[61] = {TAG_TELEM_HISTORY_WINDOW, TELEM_OFFSET(TAG_TELEM_HISTORY_WINDOW)},
+		[62] = {TAG_VCORE_WINDOW_MIN, TELEM_OFFSET(TAG_VCORE_WINDOW_MIN)},
+		[63] = {TAG_TDP_WINDOW_MAX, TELEM_OFFSET(TAG_TDP_WINDOW_MAX)},
+		[64] = {TAG_TDP_WINDOW_AVG, TELEM_OFFSET(TAG_TDP_WINDOW_AVG)},
+		[65] = {TAG_TDC_WINDOW_MAX, TELEM_OFFSET(TAG_TDC_WINDOW_MAX)},
+		[66] = {TAG_TDC_WINDOW_AVG, TELEM_OFFSET(TAG_TDC_WINDOW_AVG)},
+		[67] = {TAG_AICLK_WINDOW_MIN, TELEM_OFFSET(TAG_AICLK_WINDOW_MIN)},
+		[68] = {TAG_ASIC_TEMPERATURE_WINDOW_MAX,
+			TELEM_OFFSET(TAG_ASIC_TEMPERATURE_WINDOW_MAX)},
+		[69] = {TAG_AICLK_LIMITER, TELEM_OFFSET(TAG_AICLK_LIMITER)},
+		[70] = {TAG_TDP_THROTTLE_TIME, TELEM_OFFSET(TAG_TDP_THROTTLE_TIME)},
+		[71] = {TAG_FAST_TDC_THROTTLE_TIME, TELEM_OFFSET(TAG_FAST_TDC_THROTTLE_TIME)},
+		[72] = {TAG_TDC_THROTTLE_TIME, TELEM_OFFSET(TAG_TDC_THROTTLE_TIME)},
+		[73] = {TAG_THM_THROTTLE_TIME, TELEM_OFFSET(TAG_THM_THROTTLE_TIME)},
+		[74] = {TAG_BOARD_POWER_THROTTLE_TIME, TELEM_OFFSET(TAG_BOARD_POWER_THROTTLE_TIME)},
+		[75] = {TAG_VOLTAGE_THROTTLE_TIME, TELEM_OFFSET(TAG_VOLTAGE_THROTTLE_TIME)},
+		[76] = {TAG_GDDR_THM_THROTTLE_TIME, TELEM_OFFSET(TAG_GDDR_THM_THROTTLE_TIME)},
+		[77] = {TAG_DOPPLER_SLOW_THROTTLE_TIME,
+			TELEM_OFFSET(TAG_DOPPLER_SLOW_THROTTLE_TIME)},
+		[78] = {TAG_DOPPLER_CRITICAL_THROTTLE_TIME,
+			TELEM_OFFSET(TAG_DOPPLER_CRITICAL_THROTTLE_TIME)},
 	},
 };
 
@@ -173,11 +205,20 @@ static struct telemetry_table telemetry_table = {
  */
 static uint32_t *telemetry = &telemetry_table.telemetry[0];
 
+/**
+ * @brief Staging copy of the telemetry data.
+ *
+ * Telemetry is gathered here and then copied to @ref telemetry in one step by
+ * publish_telemetry(), so readers never see a partially updated table.
+ */
+static uint32_t telemetry_staging[TAG_COUNT];
+
 /** @} */ /* end of telemetry_table group */
 
+static struct k_spinlock telemetry_lock;
+
 static struct k_timer telem_update_timer;
 static struct k_work telem_update_worker;
-static int telem_update_interval = 100;
 
 uint32_t ConvertFloatToTelemetry(float value)
 {
@@ -211,24 +252,28 @@ float ConvertTelemetryToFloat(int32_t value)
 
 static void UpdateGddrTelemetry(void)
 {
+	static gddr_telemetry_table_t gddr_tables[NUM_GDDR] __aligned(4);
+
 	/* We pack multiple metrics into one field, so need to clear first. */
 	for (int i = 0; i < NUM_GDDR / 2; i++) {
-		telemetry[TAG_GDDR_0_1_TEMP + i] = 0;
-		telemetry[TAG_GDDR_0_1_CORR_ERRS + i] = 0;
+		telemetry_staging[TAG_GDDR_0_1_TEMP + i] = 0;
+		telemetry_staging[TAG_GDDR_0_1_CORR_ERRS + i] = 0;
 	}
 
-	telemetry[TAG_GDDR_UNCORR_ERRS] = 0;
-	telemetry[TAG_GDDR_STATUS] = 0;
+	telemetry_staging[TAG_GDDR_UNCORR_ERRS] = 0;
+	telemetry_staging[TAG_GDDR_STATUS] = 0;
+
+	/* All instances are gathered in one DMA transfer */
+	uint8_t valid_mask = read_gddr_telemetry_tables(tile_enable.gddr_enabled, gddr_tables);
+
+	if (valid_mask != tile_enable.gddr_enabled) {
+		LOG_WRN_ONCE("Failed to read GDDR telemetry table while updating telemetry");
+	}
 
 	for (int i = 0; i < NUM_GDDR; i++) {
-		gddr_telemetry_table_t gddr_telemetry;
+		const gddr_telemetry_table_t *gddr_telemetry = &gddr_tables[i];
 		/* Harvested instances should read 0b00 for status. */
-		if (IS_BIT_SET(tile_enable.gddr_enabled, i)) {
-			if (read_gddr_telemetry_table(i, &gddr_telemetry) < 0) {
-				LOG_WRN_ONCE("Failed to read GDDR telemetry table while "
-					     "updating telemetry");
-				continue;
-			}
+		if (IS_BIT_SET(valid_mask, i)) {
 			/* DDR Status:
 			 * [0] - Training complete GDDR 0
 			 * [1] - Error GDDR 0
@@ -238,9 +283,9 @@ static void UpdateGddrTelemetry(void)
 			 * [14] - Training Complete GDDR 7
 			 * [15] - Error GDDR 7
 			 */
-			telemetry[TAG_GDDR_STATUS] |=
-				(gddr_telemetry.training_complete << (i * 2)) |
-				(gddr_telemetry.gddr_error << (i * 2 + 1));
+			telemetry_staging[TAG_GDDR_STATUS] |=
+				(gddr_telemetry->training_complete << (i * 2)) |
+				(gddr_telemetry->gddr_error << (i * 2 + 1));
 
 			/* DDR_x_y_TEMP:
 			 * [31:24] GDDR y top
@@ -250,9 +295,9 @@ static void UpdateGddrTelemetry(void)
 			 */
 			int shift_val = (i % 2) * 16;
 
-			telemetry[TAG_GDDR_0_1_TEMP + i / 2] |=
-				((gddr_telemetry.dram_temperature_top & 0xff) << (8 + shift_val)) |
-				((gddr_telemetry.dram_temperature_bottom & 0xff) << shift_val);
+			telemetry_staging[TAG_GDDR_0_1_TEMP + i / 2] |=
+				((gddr_telemetry->dram_temperature_top & 0xff) << (8 + shift_val)) |
+				((gddr_telemetry->dram_temperature_bottom & 0xff) << shift_val);
 
 			/* GDDR_x_y_CORR_ERRS:
 			 * [31:24] GDDR y Corrected Write EDC errors
@@ -260,9 +305,9 @@ static void UpdateGddrTelemetry(void)
 			 * [15:8]  GDDR x Corrected Write EDC errors
 			 * [7:0]   GDDR y Corrected Read EDC Errors
 			 */
-			telemetry[TAG_GDDR_0_1_CORR_ERRS + i / 2] |=
-				((gddr_telemetry.corr_edc_wr_errors & 0xff) << (8 + shift_val)) |
-				((gddr_telemetry.corr_edc_rd_errors & 0xff) << shift_val);
+			telemetry_staging[TAG_GDDR_0_1_CORR_ERRS + i / 2] |=
+				((gddr_telemetry->corr_edc_wr_errors & 0xff) << (8 + shift_val)) |
+				((gddr_telemetry->corr_edc_rd_errors & 0xff) << shift_val);
 
 			/* GDDR_UNCORR_ERRS:
 			 * [0]  GDDR 0 Uncorrected Read EDC error
@@ -271,22 +316,22 @@ static void UpdateGddrTelemetry(void)
 			 * ...
 			 * [15] GDDR 7 Uncorrected Write EDC error
 			 */
-			telemetry[TAG_GDDR_UNCORR_ERRS] |=
-				(gddr_telemetry.uncorr_edc_rd_error << (i * 2)) |
-				(gddr_telemetry.uncorr_edc_wr_error << (i * 2 + 1));
+			telemetry_staging[TAG_GDDR_UNCORR_ERRS] |=
+				(gddr_telemetry->uncorr_edc_rd_error << (i * 2)) |
+				(gddr_telemetry->uncorr_edc_wr_error << (i * 2 + 1));
 			/* GDDR speed - in Mbps */
-			telemetry[TAG_GDDR_SPEED] = gddr_telemetry.dram_speed;
+			telemetry_staging[TAG_GDDR_SPEED] = gddr_telemetry->dram_speed;
 		}
 	}
 }
 
-int GetMaxGDDRTemp(void)
+static int max_gddr_temp(const uint32_t *table)
 {
 	int max_gddr_temp = 0;
 
 	for (int i = 0; i < NUM_GDDR; i++) {
 		int shift_val = (i % 2) * 16;
-		int gddr_temp = telemetry[TAG_GDDR_0_1_TEMP + i / 2];
+		int gddr_temp = table[TAG_GDDR_0_1_TEMP + i / 2];
 
 		max_gddr_temp = MAX(max_gddr_temp, (gddr_temp >> shift_val) & 0xFF);
 		max_gddr_temp = MAX(max_gddr_temp, (gddr_temp >> (shift_val + 8)) & 0xFF);
@@ -295,38 +340,75 @@ int GetMaxGDDRTemp(void)
 	return max_gddr_temp;
 }
 
+int GetMaxGDDRTemp(void)
+{
+	return max_gddr_temp(telemetry);
+}
+
+/* Copy the staging table to the published table.
+ *
+ * TAG_TELEM_GENERATION is odd while the copy is in progress and advances by two per update. A
+ * reader that sees the same even generation before and after reading the table has a consistent
+ * snapshot.
+ */
+static void publish_telemetry(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&telemetry_lock);
+	uint32_t generation = telemetry[TAG_TELEM_GENERATION] + 1;
+
+	telemetry[TAG_TELEM_GENERATION] = generation;
+	barrier_dmem_fence_full();
+
+	telemetry_staging[TAG_TELEM_GENERATION] = generation;
+	memcpy(telemetry, telemetry_staging, sizeof(telemetry_staging));
+
+	barrier_dmem_fence_full();
+	telemetry[TAG_TELEM_GENERATION] = generation + 1;
+	k_spin_unlock(&telemetry_lock, key);
+}
+
+/* Update a single tag outside of the periodic update. A single word needs no generation bump. */
+static void set_telemetry_tag(uint16_t tag, uint32_t value)
+{
+	k_spinlock_key_t key = k_spin_lock(&telemetry_lock);
+
+	telemetry_staging[tag] = value;
+	telemetry[tag] = value;
+	k_spin_unlock(&telemetry_lock, key);
+}
+
 static void write_static_telemetry(uint32_t app_version)
 {
 	telemetry_table.version = TELEMETRY_VERSION; /* v0.1.0 - Only update when redefining the
 						      * meaning of an existing tag
 						      */
 	telemetry_table.entry_count = TAG_COUNT;     /* Runtime count of telemetry entries */
-	telemetry[TAG_TELEM_ENUM_COUNT] = TAG_COUNT; /* Count of telemetry tags */
+	telemetry_staging[TAG_TELEM_ENUM_COUNT] = TAG_COUNT; /* Count of telemetry tags */
 
 	const FwTable *fw_table = tt_bh_fwtable_get_fw_table(fwtable_dev);
 
-	telemetry[TAG_AICLK_LIMIT_MAX] = fw_table->chip_limits.asic_fmax;
-	telemetry[TAG_VDD_LIMITS] =
+	telemetry_staging[TAG_AICLK_LIMIT_MAX] = fw_table->chip_limits.asic_fmax;
+	telemetry_staging[TAG_VDD_LIMITS] =
 		((fw_table->chip_limits.vdd_max & 0xFFFF) << 16) | fw_table->chip_limits.vdd_min;
-	telemetry[TAG_THM_LIMIT_SHUTDOWN] = T_J_SHUTDOWN;
-	telemetry[TAG_THM_LIMIT_THROTTLE] = fw_table->chip_limits.thm_limit;
-	telemetry[TAG_TDC_LIMIT_MAX] = fw_table->chip_limits.tdc_limit;
-	telemetry[TAG_TDP_LIMIT_MAX] = fw_table->chip_limits.tdp_limit;
+	telemetry_staging[TAG_THM_LIMIT_SHUTDOWN] = T_J_SHUTDOWN;
+	telemetry_staging[TAG_THM_LIMIT_THROTTLE] = fw_table->chip_limits.thm_limit;
+	telemetry_staging[TAG_TDC_LIMIT_MAX] = fw_table->chip_limits.tdc_limit;
+	telemetry_staging[TAG_TDP_LIMIT_MAX] = fw_table->chip_limits.tdp_limit;
 
 	/* Get the static values */
-	telemetry[TAG_BOARD_ID_HIGH] =
+	telemetry_staging[TAG_BOARD_ID_HIGH] =
 		tt_bh_fwtable_get_read_only_table(fwtable_dev)->board_id >> 32;
-	telemetry[TAG_BOARD_ID_LOW] =
+	telemetry_staging[TAG_BOARD_ID_LOW] =
 		tt_bh_fwtable_get_read_only_table(fwtable_dev)->board_id & 0xFFFFFFFF;
-	telemetry[TAG_ASIC_ID_HIGH] = READ_FUNCTIONAL_EFUSE(ASIC_ID_HIGH);
-	telemetry[TAG_ASIC_ID_LOW] = READ_FUNCTIONAL_EFUSE(ASIC_ID_LOW);
-	telemetry[TAG_HARVESTING_STATE] = 0x00000000;
-	telemetry[TAG_UPDATE_TELEM_SPEED] = telem_update_interval; /* Expected speed of
-								    * update in ms
-								    */
+	telemetry_staging[TAG_ASIC_ID_HIGH] = READ_FUNCTIONAL_EFUSE(ASIC_ID_HIGH);
+	telemetry_staging[TAG_ASIC_ID_LOW] = READ_FUNCTIONAL_EFUSE(ASIC_ID_LOW);
+	telemetry_staging[TAG_HARVESTING_STATE] = 0x00000000;
+	/* Expected speed of update in ms */
+	telemetry_staging[TAG_UPDATE_TELEM_SPEED] = CONFIG_TT_BH_ARC_TELEM_UPDATE_MS;
+	telemetry_staging[TAG_TELEM_HISTORY_WINDOW] = CONFIG_TT_BH_ARC_TELEM_HISTORY_WINDOW_MS;
 
 	/* TODO: Gather FW versions from FW themselves */
-	telemetry[TAG_ETH_FW_VERSION] = 0x00000000;
+	telemetry_staging[TAG_ETH_FW_VERSION] = 0x00000000;
 	if (tile_enable.gddr_enabled != 0) {
 		gddr_telemetry_table_t gddr_telemetry;
 		/* Use first available instance. */
@@ -336,7 +418,7 @@ static void write_static_telemetry(uint32_t app_version)
 			LOG_WRN_ONCE("Failed to read GDDR telemetry table while "
 				     "writing static telemetry");
 		} else {
-			telemetry[TAG_GDDR_FW_VERSION] =
+			telemetry_staging[TAG_GDDR_FW_VERSION] =
 				(gddr_telemetry.mrisc_fw_version_major << 16) |
 				gddr_telemetry.mrisc_fw_version_minor;
 		}
@@ -344,101 +426,229 @@ static void write_static_telemetry(uint32_t app_version)
 	/* DM_APP_FW_VERSION and DM_BL_FW_VERSION assumes zero-init, it might be
 	 * initialized by bh_chip_set_static_info in dmfw already, must not clear.
 	 */
-	telemetry[TAG_FLASH_BUNDLE_VERSION] =
+	telemetry_staging[TAG_FLASH_BUNDLE_VERSION] =
 		tt_bh_fwtable_get_fw_table(fwtable_dev)->fw_bundle_version;
-	telemetry[TAG_CM_FW_VERSION] = app_version;
-	telemetry[TAG_L2CPU_FW_VERSION] = 0x00000000;
+	telemetry_staging[TAG_CM_FW_VERSION] = app_version;
+	telemetry_staging[TAG_L2CPU_FW_VERSION] = 0x00000000;
 
 	/* Tile enablement / harvesting information */
-	telemetry[TAG_ENABLED_TENSIX_COL] = tile_enable.tensix_col_enabled;
-	telemetry[TAG_ENABLED_ETH] = tile_enable.eth_enabled;
-	telemetry[TAG_ENABLED_GDDR] = tile_enable.gddr_enabled;
-	telemetry[TAG_ENABLED_L2CPU] = tile_enable.l2cpu_enabled;
-	telemetry[TAG_PCIE_USAGE] =
+	telemetry_staging[TAG_ENABLED_TENSIX_COL] = tile_enable.tensix_col_enabled;
+	telemetry_staging[TAG_ENABLED_ETH] = tile_enable.eth_enabled;
+	telemetry_staging[TAG_ENABLED_GDDR] = tile_enable.gddr_enabled;
+	telemetry_staging[TAG_ENABLED_L2CPU] = tile_enable.l2cpu_enabled;
+	telemetry_staging[TAG_PCIE_USAGE] =
 		((tile_enable.pcie_usage[1] & 0x3) << 2) | (tile_enable.pcie_usage[0] & 0x3);
-	/* telemetry[TAG_NOC_TRANSLATION] assumes zero-init, see also
+	/* telemetry_staging[TAG_NOC_TRANSLATION] assumes zero-init, see also
 	 * UpdateTelemetryNocTranslation.
 	 */
 
-	telemetry[TAG_ASIC_LOCATION] = tt_bh_fwtable_get_asic_location(fwtable_dev);
+	telemetry_staging[TAG_ASIC_LOCATION] = tt_bh_fwtable_get_asic_location(fwtable_dev);
 }
 
-static void update_telemetry(void)
+BUILD_ASSERT(CONFIG_TT_BH_ARC_TELEM_HISTORY_WINDOW_MS % CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS == 0,
+	     "Telemetry history window must be a multiple of the fast period");
+BUILD_ASSERT(CONFIG_TT_BH_ARC_TELEM_HISTORY_WINDOW_MS / CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS <=
+		     CONFIG_TT_BH_ARC_TELEM_HISTORY_DEPTH,
+	     "Telemetry history window must fit in the history ring");
+
+#define TELEM_HISTORY_WINDOW_SAMPLES                                                               \
+	(CONFIG_TT_BH_ARC_TELEM_HISTORY_WINDOW_MS / CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS)
+
+/* Record a history sample from the electrical tags just gathered and refresh the window tags */
+static void update_telemetry_history(void)
 {
-	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_START);
-	TelemetryInternalData telemetry_internal_data;
+	int32_t sample[TELEM_HISTORY_CHANNEL_COUNT];
+	struct telemetry_history_summary window[TELEM_HISTORY_CHANNEL_COUNT];
+	uint32_t aiclk = 0;
 
-	ReadTelemetryInternal(telem_update_interval, &telemetry_internal_data);
-
-	/* Get all dynamically updated values */
-	telemetry[TAG_VCORE] =
-		telemetry_internal_data
-			.vcore_voltage; /* reported in mV, will be truncated to uint32_t */
-	telemetry[TAG_TDP] =
-		telemetry_internal_data
-			.vcore_power; /* reported in W, will be truncated to uint32_t */
-	telemetry[TAG_TDC] =
-		telemetry_internal_data
-			.vcore_current;         /* reported in A, will be truncated to uint32_t */
-	telemetry[TAG_ASIC_TEMPERATURE] = ConvertFloatToTelemetry(
-		telemetry_internal_data.asic_temperature); /* ASIC temperature - reported in
-							    * signed int 16.16 format
-							    */
-	telemetry[TAG_VREG_TEMPERATURE] = 0x000000;        /* VREG temperature - need I2C line */
-	telemetry[TAG_BOARD_TEMPERATURE] = 0x000000;       /* Board temperature - need I2C line */
 	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
-			       &telemetry[TAG_AICLK]);
+			       &aiclk);
+
+	sample[TELEM_HISTORY_VCORE] = telemetry_staging[TAG_VCORE];
+	sample[TELEM_HISTORY_TDP] = telemetry_staging[TAG_TDP];
+	sample[TELEM_HISTORY_TDC] = telemetry_staging[TAG_TDC];
+	sample[TELEM_HISTORY_AICLK] = aiclk;
+	sample[TELEM_HISTORY_ASIC_TEMPERATURE] = telemetry_staging[TAG_ASIC_TEMPERATURE];
+	telemetry_history_add(sample);
+
+	/* Cannot fail, the history holds at least the sample just added */
+	for (int i = 0; i < TELEM_HISTORY_CHANNEL_COUNT; i++) {
+		telemetry_history_summarize(i, TELEM_HISTORY_WINDOW_SAMPLES, &window[i]);
+	}
+
+	telemetry_staging[TAG_VCORE_WINDOW_MIN] = window[TELEM_HISTORY_VCORE].min;
+	telemetry_staging[TAG_TDP_WINDOW_MAX] = window[TELEM_HISTORY_TDP].max;
+	telemetry_staging[TAG_TDP_WINDOW_AVG] = window[TELEM_HISTORY_TDP].avg;
+	telemetry_staging[TAG_TDC_WINDOW_MAX] = window[TELEM_HISTORY_TDC].max;
+	telemetry_staging[TAG_TDC_WINDOW_AVG] = window[TELEM_HISTORY_TDC].avg;
+	telemetry_staging[TAG_AICLK_WINDOW_MIN] = window[TELEM_HISTORY_AICLK].min;
+	telemetry_staging[TAG_ASIC_TEMPERATURE_WINDOW_MAX] =
+		window[TELEM_HISTORY_ASIC_TEMPERATURE].max;
+}
+
+/* Fast-moving electrical signals */
+static void update_electrical_telemetry(void)
+{
+	TelemetryInternalData telemetry_internal_data;
+
+	ReadTelemetryInternal(CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS, &telemetry_internal_data);
+
+	/* reported in mV, will be truncated to uint32_t */
+	telemetry_staging[TAG_VCORE] = telemetry_internal_data.vcore_voltage;
+	/* reported in W, will be truncated to uint32_t */
+	telemetry_staging[TAG_TDP] = telemetry_internal_data.vcore_power;
+	/* reported in A, will be truncated to uint32_t */
+	telemetry_staging[TAG_TDC] = telemetry_internal_data.vcore_current;
+	/* ASIC temperature - reported in signed int 16.16 format */
+	telemetry_staging[TAG_ASIC_TEMPERATURE] =
+		ConvertFloatToTelemetry(telemetry_internal_data.asic_temperature);
+	telemetry_staging[TAG_INPUT_POWER] = GetInputPower(); /* Input power - reported in W */
+
+	update_telemetry_history();
+}
+
+/* Telemetry tag holding the throttle time of each AICLK max arbiter with a throttler */
+static const struct {
+	uint16_t tag;
+	AiclkArbMax arb_max;
+} throttle_time_tags[] = {
+	{TAG_TDP_THROTTLE_TIME, kAiclkArbMaxTDP},
+	{TAG_FAST_TDC_THROTTLE_TIME, kAiclkArbMaxFastTDC},
+	{TAG_TDC_THROTTLE_TIME, kAiclkArbMaxTDC},
+	{TAG_THM_THROTTLE_TIME, kAiclkArbMaxThm},
+	{TAG_BOARD_POWER_THROTTLE_TIME, kAiclkArbMaxBoardPower},
+	{TAG_VOLTAGE_THROTTLE_TIME, kAiclkArbMaxVoltage},
+	{TAG_GDDR_THM_THROTTLE_TIME, kAiclkArbMaxGDDRThm},
+	{TAG_DOPPLER_SLOW_THROTTLE_TIME, kAiclkArbMaxDopplerSlow},
+	{TAG_DOPPLER_CRITICAL_THROTTLE_TIME, kAiclkArbMaxDopplerCritical},
+};
+
+static void update_throttle_telemetry(void)
+{
+	AiclkArbMax limiter = GetAiclkLimiter();
+	AiclkArbStats stats;
+
+	telemetry_staging[TAG_AICLK_LIMITER] = limiter == kAiclkArbMaxCount ? UINT32_MAX : limiter;
+
+	for (size_t i = 0; i < ARRAY_SIZE(throttle_time_tags); i++) {
+		GetAiclkArbStats(throttle_time_tags[i].arb_max, &stats);
+		telemetry_staging[throttle_time_tags[i].tag] = stats.time_limited_ms;
+	}
+}
+
+/* Clock readbacks, throttling statistics, link status and heartbeat */
+static void update_clock_telemetry(void)
+{
+	/* VREG temperature - need I2C line */
+	telemetry_staging[TAG_VREG_TEMPERATURE] = 0x000000;
+	/* Board temperature - need I2C line */
+	telemetry_staging[TAG_BOARD_TEMPERATURE] = 0x000000;
 	/* first 16 bits - MAX ASIC FREQ (Not Available yet), lower 16 bits - current AICLK */
+	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
+			       &telemetry_staging[TAG_AICLK]);
+	/* first 16 bits - MAX AXI FREQ (Not Available yet), lower 16 bits - current AXICLK */
+	clock_control_get_rate(pll_dev_1, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AXICLK,
+			       &telemetry_staging[TAG_AXICLK]);
+	/* first 16 bits - MAX ARC FREQ (Not Available yet), lower 16 bits - current ARCCLK */
+	clock_control_get_rate(pll_dev_1, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_ARCCLK,
+			       &telemetry_staging[TAG_ARCCLK]);
+	/* first 16 bits - MAX L2CPUCLKn FREQ (Not Available yet), lower 16 bits - current
+	 * L2CPUCLKn
+	 */
+	clock_control_get_rate(pll_dev_4,
+			       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_0,
+			       &telemetry_staging[TAG_L2CPUCLK0]);
+	clock_control_get_rate(pll_dev_4,
+			       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_1,
+			       &telemetry_staging[TAG_L2CPUCLK1]);
+	clock_control_get_rate(pll_dev_4,
+			       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_2,
+			       &telemetry_staging[TAG_L2CPUCLK2]);
+	clock_control_get_rate(pll_dev_4,
+			       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_3,
+			       &telemetry_staging[TAG_L2CPUCLK3]);
+	update_throttle_telemetry();
+
+	/* ETH live status lower 16 bits: heartbeat status, upper 16 bits: retrain_status - Not
+	 * Available yet
+	 */
+	telemetry_staging[TAG_ETH_LIVE_STATUS] = 0x00000000;
+	telemetry_staging[TAG_TIMER_HEARTBEAT]++; /* Incremented every update period */
+}
 
-	clock_control_get_rate(
-		pll_dev_1, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AXICLK,
-		&telemetry[TAG_AXICLK]); /* first 16 bits - MAX AXI FREQ (Not Available yet),
-					  * lower 16 bits - current AXICLK
-					  */
-	clock_control_get_rate(
-		pll_dev_1, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_ARCCLK,
-		&telemetry[TAG_ARCCLK]); /* first 16 bits - MAX ARC FREQ (Not Available yet),
-					  * lower 16 bits - current ARCCLK
-					  */
-	clock_control_get_rate(
-		pll_dev_4, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_0,
-		&telemetry[TAG_L2CPUCLK0]); /* first 16 bits - MAX L2CPUCLK0 FREQ (Not Available
-					     * yet), lower 16 bits - current L2CPUCLK0
-					     */
-	clock_control_get_rate(
-		pll_dev_4, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_1,
-		&telemetry[TAG_L2CPUCLK1]); /* first 16 bits - MAX L2CPUCLK1 FREQ (Not Available
-					     * yet), lower 16 bits - current L2CPUCLK1
-					     */
-	clock_control_get_rate(
-		pll_dev_4, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_2,
-		&telemetry[TAG_L2CPUCLK2]); /* first 16 bits - MAX L2CPUCLK2 FREQ (Not Available
-					     * yet), lower 16 bits - current L2CPUCLK2
-					     */
-	clock_control_get_rate(
-		pll_dev_4, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_L2CPUCLK_3,
-		&telemetry[TAG_L2CPUCLK3]); /* first 16 bits - MAX L2CPUCLK3 FREQ (Not Available
-					     * yet), lower 16 bits - current L2CPUCLK3
-					     */
-
-	telemetry[TAG_ETH_LIVE_STATUS] =
-		0x00000000; /* ETH live status lower 16 bits: heartbeat status, upper 16 bits:
-			     * retrain_status - Not Available yet
-			     */
-	telemetry[TAG_FAN_SPEED] = GetFanSpeed(); /* Target fan speed - reported in percentage */
-	telemetry[TAG_FAN_RPM] = GetFanRPM();     /* Actual fan RPM */
+/* Slow-moving values: fans and GDDR, which needs an ARC DMA per instance */
+static void update_slow_telemetry(void)
+{
+	/* Target fan speed - reported in percentage */
+	telemetry_staging[TAG_FAN_SPEED] = GetFanSpeed();
+	telemetry_staging[TAG_FAN_RPM] = GetFanRPM(); /* Actual fan RPM */
 	UpdateGddrTelemetry();
-	telemetry[TAG_MAX_GDDR_TEMP] = GetMaxGDDRTemp();
-	telemetry[TAG_INPUT_POWER] = GetInputPower(); /* Input power - reported in W */
-	telemetry[TAG_TIMER_HEARTBEAT]++; /* Incremented every time the timer is called */
+	telemetry_staging[TAG_MAX_GDDR_TEMP] = max_gddr_temp(telemetry_staging);
+}
+
+BUILD_ASSERT(CONFIG_TT_BH_ARC_TELEM_UPDATE_MS % CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS == 0,
+	     "Telemetry update period must be a multiple of the fast period");
+BUILD_ASSERT(CONFIG_TT_BH_ARC_TELEM_SLOW_UPDATE_MS % CONFIG_TT_BH_ARC_TELEM_UPDATE_MS == 0,
+	     "Slow telemetry update period must be a multiple of the update period");
+
+struct telemetry_refresh {
+	uint32_t period_ms;
+	void (*update)(void);
+};
+
+/* Refresh period of each group of dynamic tags. Static tags are written once by
+ * write_static_telemetry. The first period is the timer period and each period must be a
+ * multiple of the one before it.
+ */
+static const struct telemetry_refresh telemetry_refresh_table[] = {
+	{CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS, update_electrical_telemetry},
+	{CONFIG_TT_BH_ARC_TELEM_UPDATE_MS, update_clock_telemetry},
+	{CONFIG_TT_BH_ARC_TELEM_SLOW_UPDATE_MS, update_slow_telemetry},
+};
+
+#define TELEM_FAST_UPDATE_MS  CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS
+#define TELEM_TICKS_PER_CYCLE (CONFIG_TT_BH_ARC_TELEM_SLOW_UPDATE_MS / TELEM_FAST_UPDATE_MS)
+
+static uint32_t telem_tick;
+
+/* Return a bitmask of the telemetry_refresh_table entries that are due on the given tick of the
+ * telemetry timer. Every entry is due on tick 0.
+ */
+STATIC uint32_t telemetry_refresh_due(uint32_t tick)
+{
+	uint32_t due = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(telemetry_refresh_table); i++) {
+		uint32_t ticks = telemetry_refresh_table[i].period_ms / TELEM_FAST_UPDATE_MS;
+
+		if (tick % ticks == 0) {
+			due |= BIT(i);
+		}
+	}
+
+	return due;
+}
+
+static void update_telemetry(uint32_t due)
+{
+	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_START);
+
+	for (int i = 0; i < ARRAY_SIZE(telemetry_refresh_table); i++) {
+		if (due & BIT(i)) {
+			telemetry_refresh_table[i].update();
+		}
+	}
+
+	publish_telemetry();
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_END);
 }
 
 /* Handler functions for zephyr timer and worker objects */
 static void telemetry_work_handler(struct k_work *work)
 {
-	/* Repeat fetching of dynamic telemetry values */
-	update_telemetry();
+	/* Repeat fetching of dynamic telemetry values that are due */
+	telem_tick = (telem_tick + 1) % TELEM_TICKS_PER_CYCLE;
+	update_telemetry(telemetry_refresh_due(telem_tick));
 }
 static void telemetry_timer_handler(struct k_timer *timer)
 {
@@ -457,8 +667,8 @@ static K_TIMER_DEFINE(telem_update_timer, telemetry_timer_handler, NULL);
 void init_telemetry(uint32_t app_version)
 {
 	write_static_telemetry(app_version);
-	/* fill the dynamic values once before starting timed updates */
-	update_telemetry();
+	/* fill all dynamic values once before starting timed updates */
+	update_telemetry(telemetry_refresh_due(0));
 
 	/* Publish the telemetry data pointer for readers in Scratch RAM */
 	WriteReg(TELEMETRY_DATA_REG_ADDR, (uint32_t)&telemetry[0]);
@@ -470,32 +680,32 @@ void StartTelemetryTimer(void)
 	/* Start the timer to update the dynamic telemetry values
 	 * Duration (time interval before the timer expires for the first time) and
 	 * Period (time interval between all timer expirations after the first one)
-	 * are both set to telem_update_interval
+	 * are both set to the fast refresh period; slower tags are refreshed on a multiple of it
 	 */
-	k_timer_start(&telem_update_timer, K_MSEC(telem_update_interval),
-		      K_MSEC(telem_update_interval));
+	k_timer_start(&telem_update_timer, K_MSEC(CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS),
+		      K_MSEC(CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS));
 }
 
 void UpdateDmFwVersion(uint32_t bl_version, uint32_t app_version)
 {
-	telemetry[TAG_DM_BL_FW_VERSION] = bl_version;
-	telemetry[TAG_DM_APP_FW_VERSION] = app_version;
+	set_telemetry_tag(TAG_DM_BL_FW_VERSION, bl_version);
+	set_telemetry_tag(TAG_DM_APP_FW_VERSION, app_version);
 }
 
 void UpdateTelemetryNocTranslation(bool translation_enabled)
 {
 	/* Note that this may be called before init_telemetry. */
-	telemetry[TAG_NOC_TRANSLATION] = translation_enabled;
+	set_telemetry_tag(TAG_NOC_TRANSLATION, translation_enabled);
 }
 
 void UpdateTelemetryBoardPowerLimit(uint32_t power_limit)
 {
-	telemetry[TAG_BOARD_POWER_LIMIT] = power_limit;
+	set_telemetry_tag(TAG_BOARD_POWER_LIMIT, power_limit);
 }
 
 void UpdateTelemetryThermTripCount(uint16_t therm_trip_count)
 {
-	telemetry[TAG_THERM_TRIP_COUNT] = therm_trip_count;
+	set_telemetry_tag(TAG_THERM_TRIP_COUNT, therm_trip_count);
 }
 
 bool GetTelemetryTagValid(uint16_t tag)
@@ -224,12 +224,75 @@
 /** @brief Maximum TDP limit in watts. */
 #define TAG_TDP_LIMIT_MAX 64
 
+/** @brief Telemetry table generation. Odd while the table is being updated, advances by two on
+ * every update.
+ */
+#define TAG_TELEM_GENERATION 65
+
+/** @brief Length in milliseconds of the window the WINDOW tags are computed over. */
+#define TAG_TELEM_HISTORY_WINDOW 66
+
+/** @brief Minimum VCORE in mV over the history window. */
+#define TAG_VCORE_WINDOW_MIN 67
+
+/** @brief Maximum TDP in watts over the history window. */
+#define TAG_TDP_WINDOW_MAX 68
+
+/** @brief Average TDP in watts over the history window. */
+#define TAG_TDP_WINDOW_AVG 69
+
+/** @brief Maximum TDC in amperes over the history window. */
+#define TAG_TDC_WINDOW_MAX 70
+
+/** @brief Average TDC in amperes over the history window. */
+#define TAG_TDC_WINDOW_AVG 71
+
+/** @brief Minimum AI clock frequency in MHz over the history window. */
+#define TAG_AICLK_WINDOW_MIN 72
+
+/** @brief Maximum ASIC temperature over the history window, in the same format as
+ * @ref TAG_ASIC_TEMPERATURE.
+ */
+#define TAG_ASIC_TEMPERATURE_WINDOW_MAX 73
+
+/** @brief AICLK arbiter currently holding AICLK below the busy/idle target, 0xFFFFFFFF if none.
+ * Uses the arbiter numbering of @ref get_aiclk_limit_stats_rqst.
+ */
+#define TAG_AICLK_LIMITER 74
+
+/** @brief Total time in milliseconds the TDP throttler has limited AICLK. */
+#define TAG_TDP_THROTTLE_TIME 75
+
+/** @brief Total time in milliseconds the fast TDC throttler has limited AICLK. */
+#define TAG_FAST_TDC_THROTTLE_TIME 76
+
+/** @brief Total time in milliseconds the TDC throttler has limited AICLK. */
+#define TAG_TDC_THROTTLE_TIME 77
+
+/** @brief Total time in milliseconds the thermal throttler has limited AICLK. */
+#define TAG_THM_THROTTLE_TIME 78
+
+/** @brief Total time in milliseconds the board power throttler has limited AICLK. */
+#define TAG_BOARD_POWER_THROTTLE_TIME 79
+
+/** @brief Total time in milliseconds the maximum voltage throttler has limited AICLK. */
+#define TAG_VOLTAGE_THROTTLE_TIME 80
+
+/** @brief Total time in milliseconds the GDDR thermal throttler has limited AICLK. */
+#define TAG_GDDR_THM_THROTTLE_TIME 81
+
+/** @brief Total time in milliseconds the slow Doppler throttler has limited AICLK. */
+#define TAG_DOPPLER_SLOW_THROTTLE_TIME 82
+
+/** @brief Total time in milliseconds the critical Doppler throttler has limited AICLK. */
+#define TAG_DOPPLER_CRITICAL_THROTTLE_TIME 83
+
 /** @} */ /* end of telemetry_tag group */
 
 /* Not a real tag, signifies the last tag in the list.
  * MUST be incremented if new tags are defined.
  */
-#define TAG_COUNT 65
+#define TAG_COUNT 84
 
 /* Telemetry tags are at offset `tag` in the telemetry buffer */
 #define TELEM_OFFSET(tag) (tag)
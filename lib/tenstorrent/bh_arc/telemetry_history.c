@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "telemetry_history.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <tenstorrent/msgqueue.h>
+#include <tenstorrent/smc_msg.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+
+#define HISTORY_DEPTH CONFIG_TT_BH_ARC_TELEM_HISTORY_DEPTH
+
+/* Samples summarized per hold of history_lock */
+#define SUMMARIZE_CHUNK 64
+
+/* Ring of the most recent samples. The layout is part of the host interface: the address is
+ * returned by TT_SMC_MSG_GET_TELEM_HISTORY so the host can read the raw samples in bulk. The next
+ * sample is written to samples[head], so the newest sample is samples[head - 1] and the oldest of
+ * a full ring is samples[head].
+ */
+static struct {
+	uint32_t depth;
+	uint32_t num_channels;
+	uint32_t sample_period_ms;
+	uint32_t head;
+	uint32_t count; /* Total samples recorded, wraps at 2^32 */
+	int32_t samples[HISTORY_DEPTH][TELEM_HISTORY_CHANNEL_COUNT];
+} history = {
+	.depth = HISTORY_DEPTH,
+	.num_channels = TELEM_HISTORY_CHANNEL_COUNT,
+	.sample_period_ms = CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS,
+};
+
+static bool history_full;
+static struct k_spinlock history_lock;
+
+void telemetry_history_add(const int32_t sample[TELEM_HISTORY_CHANNEL_COUNT])
+{
+	k_spinlock_key_t key = k_spin_lock(&history_lock);
+
+	memcpy(history.samples[history.head], sample, sizeof(history.samples[0]));
+	history.head = (history.head + 1) % HISTORY_DEPTH;
+	history.count++;
+	if (history.head == 0) {
+		history_full = true;
+	}
+	k_spin_unlock(&history_lock, key);
+}
+
+/**
+ * @brief Summarize the most recent samples of one history channel
+ *
+ * @param channel The channel to summarize
+ * @param num_samples Number of most recent samples to include, 0 for the whole ring. Clamped to
+ *                    the number of samples available.
+ * @param summary Filled with the minimum, maximum and average of the samples. If new samples
+ *                overwrite the oldest ones of the window while it is summarized, the summary
+ *                covers fewer samples than asked for.
+ *
+ * @retval 0 On success
+ * @retval -EINVAL If the channel is out of range
+ * @retval -ENODATA If no samples have been recorded yet
+ */
+int telemetry_history_summarize(enum telemetry_history_channel channel, uint32_t num_samples,
+				struct telemetry_history_summary *summary)
+{
+	if (channel >= TELEM_HISTORY_CHANNEL_COUNT) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&history_lock);
+	uint32_t available = history_full ? HISTORY_DEPTH : history.head;
+
+	if (available == 0) {
+		k_spin_unlock(&history_lock, key);
+		return -ENODATA;
+	}
+
+	if (num_samples == 0 || num_samples > available) {
+		num_samples = available;
+	}
+
+	uint32_t head = history.head;
+	uint32_t start_count = history.count;
+	uint32_t done = 0;
+	int32_t min = INT32_MAX;
+	int32_t max = INT32_MIN;
+	int64_t sum = 0;
+
+	/* Copy the window out a chunk at a time so the lock is only held for short copies. The
+	 * oldest samples of the window may be overwritten in between, the summary then stops at the
+	 * last sample that was not.
+	 */
+	while (true) {
+		int32_t values[SUMMARIZE_CHUNK];
+		uint32_t overwritten = history.count - start_count;
+		uint32_t n = 0;
+
+		if (overwritten + done < HISTORY_DEPTH) {
+			n = MIN(MIN(SUMMARIZE_CHUNK, num_samples - done),
+				HISTORY_DEPTH - overwritten - done);
+		}
+
+		for (uint32_t i = 0; i < n; i++) {
+			uint32_t index = (head + HISTORY_DEPTH - 1 - done - i) % HISTORY_DEPTH;
+
+			values[i] = history.samples[index][channel];
+		}
+		k_spin_unlock(&history_lock, key);
+
+		for (uint32_t i = 0; i < n; i++) {
+			min = MIN(min, values[i]);
+			max = MAX(max, values[i]);
+			sum += values[i];
+		}
+		done += n;
+
+		if (n == 0 || done == num_samples) {
+			break;
+		}
+		key = k_spin_lock(&history_lock);
+	}
+
+	/* Only if the history was reset in the meantime */
+	if (done == 0) {
+		return -ENODATA;
+	}
+
+	summary->min = min;
+	summary->max = max;
+	summary->avg = sum / done;
+	summary->count = done;
+
+	return 0;
+}
+
+void telemetry_history_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&history_lock);
+
+	history.head = 0;
+	history.count = 0;
+	history_full = false;
+	memset(history.samples, 0, sizeof(history.samples));
+	k_spin_unlock(&history_lock, key);
+}
+
+/**
+ * @brief Handler for @ref TT_SMC_MSG_GET_TELEM_HISTORY messages
+ *
+ * @details Reports the minimum, maximum and average of the most recent samples of one history
+ * channel, along with the address of the history ring for bulk reads.
+ *
+ * @param request Pointer to the host request message, use request->get_telem_history for
+ *                structured access
+ * @param response Pointer to the response message to be sent back to host
+ *
+ * @retval 0 On success
+ * @retval EINVAL If the channel is out of range
+ * @retval ENODATA If no samples have been recorded yet
+ */
+static uint8_t get_telem_history_handler(const union request *request, struct response *response)
+{
+	const struct get_telem_history_rqst *rqst = &request->get_telem_history;
+	struct telemetry_history_summary summary;
+	int ret = telemetry_history_summarize(rqst->channel, rqst->num_samples, &summary);
+
+	if (ret != 0) {
+		return -ret;
+	}
+
+	response->data[1] = summary.min;
+	response->data[2] = summary.max;
+	response->data[3] = summary.avg;
+	response->data[4] = summary.count;
+	response->data[5] = (uint32_t)&history;
+	response->data[6] = history.count;
+
+	return 0;
+}
+
+REGISTER_MESSAGE(TT_SMC_MSG_GET_TELEM_HISTORY, get_telem_history_handler);
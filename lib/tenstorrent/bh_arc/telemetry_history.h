@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <stdint.h>
+
+/* Channels recorded in the telemetry history, in the order they are stored in each sample.
+ * Values use the same units as the corresponding telemetry tags.
+ */
+enum telemetry_history_channel {
+	TELEM_HISTORY_VCORE,            /* mV */
+	TELEM_HISTORY_TDP,              /* W */
+	TELEM_HISTORY_TDC,              /* A */
+	TELEM_HISTORY_AICLK,            /* MHz */
+	TELEM_HISTORY_ASIC_TEMPERATURE, /* signed 16.16 degC */
+	TELEM_HISTORY_CHANNEL_COUNT,
+};
+
+struct telemetry_history_summary {
+	int32_t min;
+	int32_t max;
+	int32_t avg;
+	uint32_t count; /* Number of samples summarized */
+};
+
+void telemetry_history_add(const int32_t sample[TELEM_HISTORY_CHANNEL_COUNT]);
+int telemetry_history_summarize(enum telemetry_history_channel channel, uint32_t num_samples,
+				struct telemetry_history_summary *summary);
+void telemetry_history_reset(void);
+
+#endif
@@ -25,6 +25,42 @@ RTIO_DEFINE(ts_avg_ctx, 1, 1);
 static uint8_t ts_avg_buf[sizeof(struct sensor_value)];
 #endif
 
+/* Serializes refreshes of internal_data between the fan control, telemetry and throttler
+ * callers.
+ */
+static K_MUTEX_DEFINE(internal_data_lock);
+
+struct avs_current_read {
+	struct k_sem done;
+	AVSStatus status;
+	uint16_t response;
+};
+
+static void AVSCurrentReadDone(AVSStatus status, uint16_t response, void *user_data)
+{
+	struct avs_current_read *read = user_data;
+
+	read->status = status;
+	read->response = response;
+	k_sem_give(&read->done);
+}
+
+/* Returns false if the read failed or took longer than AVS_TIMEOUT_US */
+static bool AVSCurrentReadWait(struct avs_current_read *read)
+{
+	if (k_sem_take(&read->done, K_USEC(AVS_TIMEOUT_US)) != 0) {
+		if (AVSCancel(AVSCurrentReadDone, read) == 0) {
+			return false;
+		}
+		/* The readback arrived as the wait timed out and AVSCurrentReadDone is already
+		 * running, it must finish with read before it goes out of scope.
+		 */
+		k_sem_take(&read->done, K_FOREVER);
+	}
+
+	return read->status == AVSOk;
+}
+
 /**
  * @brief Read telemetry values that are shared by multiple components
  *
@@ -36,9 +72,18 @@ static uint8_t ts_avg_buf[sizeof(struct sensor_value)];
  */
 void ReadTelemetryInternal(int64_t max_staleness, TelemetryInternalData *data)
 {
+	k_mutex_lock(&internal_data_lock, K_FOREVER);
+
 	int64_t reftime = last_update_time;
 
 	if (k_uptime_delta(&reftime) >= max_staleness) {
+		struct avs_current_read avs_current;
+
+		/* The AVSBus current read runs while the PVT sensor and PMBus are read */
+		k_sem_init(&avs_current.done, 0, 1);
+		bool avs_queued = AVSReadCurrentAsync(AVS_VCORE_RAIL, AVSCurrentReadDone,
+						      &avs_current) == 0;
+
 #ifdef CONFIG_DT_HAS_TENSTORRENT_BH_PVT_ENABLED
 		struct sensor_value avg_tmp;
 		const struct sensor_decoder_api *decoder;
@@ -51,9 +96,20 @@ void ReadTelemetryInternal(int64_t max_staleness, TelemetryInternalData *data)
 				&avg_tmp);
 #endif
 
-		/* Get all dynamically updated values */
-		internal_data.vcore_voltage = get_vcore();
-		AVSReadCurrent(AVS_VCORE_RAIL, &internal_data.vcore_current);
+		/* Get all dynamically updated values. The regulator values are batched into one
+		 * PMBus transfer and the previous values are kept if it fails.
+		 */
+		VcoreTelemetry vcore;
+		bool vcore_valid = ReadVcoreTelemetry(&vcore) == 0;
+
+		if (vcore_valid) {
+			internal_data.vcore_voltage = vcore.voltage;
+		}
+		if (avs_queued && AVSCurrentReadWait(&avs_current)) {
+			internal_data.vcore_current = avs_current.response * AVS_CURRENT_A_PER_LSB;
+		} else if (vcore_valid) {
+			internal_data.vcore_current = vcore.current;
+		}
 		internal_data.vcore_power =
 			internal_data.vcore_current * internal_data.vcore_voltage * 0.001f;
 #ifdef CONFIG_DT_HAS_TENSTORRENT_BH_PVT_ENABLED
@@ -65,4 +121,6 @@ void ReadTelemetryInternal(int64_t max_staleness, TelemetryInternalData *data)
 	}
 
 	*data = internal_data;
+
+	k_mutex_unlock(&internal_data_lock);
 }
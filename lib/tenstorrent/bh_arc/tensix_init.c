@@ -15,6 +15,7 @@
 #include <zephyr/drivers/dma.h>
 #include <zephyr/drivers/dma/dma_tt_bh_noc.h>
 #include <zephyr/init.h>
+#include <zephyr/logging/log.h>
 
 #define ARC_NOC0_X 8
 #define ARC_NOC0_Y 0
@@ -24,6 +25,10 @@
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
 static const struct device *const dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 
+#define WIPE_TIMEOUT_MS 50
+
+LOG_MODULE_REGISTER(tensix_init, CONFIG_TT_APP_LOG_LEVEL);
+
 /* Enable CG_CTRL_EN in each non-harvested Tensix node and set CG hystersis to 2. */
 /* This requires NOC init so that broadcast is set up properly. */
 
@@ -49,7 +54,6 @@ static const struct device *const dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 static void EnableTensixCG(void)
 {
 	uint8_t ring = 0;
-	uint8_t noc_tlb = 0;
 
 	/* CG hysteresis for the blocks. (Some share a field.) */
 	/* Set them all to 2. */
@@ -63,13 +67,15 @@ static void EnableTensixCG(void)
 	uint32_t cg_ctrl_en = 0xFFB12244;
 	uint32_t enable_all_tensix_cg = 0xFFFFFFFF; /* Only bits 0-16 are used. */
 
-	NOC2AXITensixBroadcastTlbSetup(ring, noc_tlb, cg_ctrl_en, kNoc2AxiOrderingStrict);
+	uint8_t noc_tlb =
+		NOC2AXITensixBroadcastTlbAcquire(ring, cg_ctrl_en, kNoc2AxiOrderingStrict);
 
 	NOC2AXIWrite32(ring, noc_tlb, cg_ctrl_hyst0, all_blocks_hyst_2);
 	NOC2AXIWrite32(ring, noc_tlb, cg_ctrl_hyst1, all_blocks_hyst_2);
 	NOC2AXIWrite32(ring, noc_tlb, cg_ctrl_hyst2, all_blocks_hyst_2);
 
 	NOC2AXIWrite32(ring, noc_tlb, cg_ctrl_en, enable_all_tensix_cg);
+	NOC2AXITlbRelease(ring, noc_tlb);
 }
 
 /**
@@ -79,7 +85,22 @@ static void EnableTensixCG(void)
  * all other non-harvested tensix cores. This approach is faster than iterating over all tensix
  * cores sequentially to clear each l1.
  */
-static void wipe_l1(void)
+/* Run one step of the wipe on channel 1 and wait for it to land */
+static int wipe_step(struct dma_config *config)
+{
+	int ret = dma_config(dma_noc, 1, config);
+
+	if (ret == 0) {
+		ret = dma_start(dma_noc, 1);
+	}
+	if (ret == 0) {
+		ret = tt_bh_dma_noc_wait(dma_noc, 1, K_MSEC(WIPE_TIMEOUT_MS));
+	}
+
+	return ret;
+}
+
+static int wipe_l1(void)
 {
 	uint64_t addr = 0;
 	uint8_t tensix_x, tensix_y;
@@ -111,8 +132,12 @@ static void wipe_l1(void)
 		.user_data = &coords,
 	};
 
-	dma_config(dma_noc, 1, &config);
-	dma_start(dma_noc, 1);
+	/* Each step copies what the previous one cleared, so wait for it to land */
+	int ret = wipe_step(&config);
+
+	if (ret != 0) {
+		return ret;
+	}
 
 	/* wipe entire L1 of the chosen tensix */
 	uint32_t offset = sizeof(sram_buffer);
@@ -126,8 +151,10 @@ static void wipe_l1(void)
 		block.dest_address = offset;
 		block.block_size = size;
 
-		dma_config(dma_noc, 1, &config);
-		dma_start(dma_noc, 1);
+		ret = wipe_step(&config);
+		if (ret != 0) {
+			return ret;
+		}
 
 		offset += offset;
 	}
@@ -138,8 +165,7 @@ static void wipe_l1(void)
 	block.dest_address = addr;
 	block.block_size = TENSIX_L1_SIZE;
 
-	dma_config(dma_noc, 1, &config);
-	dma_start(dma_noc, 1);
+	return wipe_step(&config);
 }
 
 void TensixInit(void)
@@ -161,8 +187,12 @@ static int tensix_init(void)
 
 	TensixInit();
 
-	wipe_l1();
+	int ret = wipe_l1();
+
+	if (ret != 0) {
+		LOG_ERR("%s() failed: %d", "wipe_l1", ret);
+	}
 
-	return 0;
+	return ret;
 }
 SYS_INIT_APP(tensix_init);
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/sys/util.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/byteorder.h>
@@ -25,6 +27,18 @@ static bool doppler_t2;
 static bool doppler_t3;
 static const bool thermal_throttling = true;
 
+static uint16_t board_power_history[1000];
+static uint16_t *board_power_history_cursor = board_power_history;
+static uint32_t board_power_sum;
+static bool kernel_nops_enabled;
+
+static uint8_t t2_count;
+static uint8_t t3_count;
+
+/* Time since the previous update, in units of the nominal 1 ms DVFS period */
+static float throttler_dt = 1.0F;
+static q16_t throttler_dt_fixed = Q16_ONE;
+
 #define kThrottlerAiclkScaleFactor 500.0F
 #define DEFAULT_BOARD_POWER_LIMIT  150
 
@@ -62,21 +76,13 @@ static const ThrottlerLimitRange throttler_limit_ranges[kThrottlerCount] = {
 };
 /* clang-format on */
 
-typedef struct {
-	float alpha_filter;
-	float p_gain;
-	float d_gain;
-} ThrottlerParams;
-
 typedef struct {
 	const AiclkArbMax arb_max; /* The arbiter associated with this throttler */
 
 	const ThrottlerParams params;
-	float limit;
-	float value;
-	float error;
-	float prev_error;
-	float output;
+	ThrottlerParamsFixed params_fixed; /* Converted from params by InitThrottlers */
+	ThrottlerState state;
+	ThrottlerStateFixed state_fixed;
 } Throttler;
 
 /* clang-format off */
@@ -146,7 +152,8 @@ static void SetThrottlerLimit(ThrottlerId id, float limit)
 		CLAMP(limit, throttler_limit_ranges[id].min, throttler_limit_ranges[id].max);
 
 	LOG_INF("Throttler %d limit set to %d", id, (uint32_t)clamped_limit);
-	throttler[id].limit = clamped_limit;
+	throttler[id].state.limit = clamped_limit;
+	throttler[id].state_fixed.limit = q16_from_float(clamped_limit);
 }
 
 static uint32_t throttle_counter;
@@ -156,12 +163,13 @@ static bool tensixes_enabled = true;
 static void BroadcastKernelThrottleState(void)
 {
 	const uint8_t kNocRing = 0;
-	const uint8_t kNocTlb = 1;
 
 	if (tensixes_enabled) {
-		NOC2AXITensixBroadcastTlbSetup(kNocRing, kNocTlb, kKernelThrottleAddress,
-					       kNoc2AxiOrderingStrict);
-		NOC2AXIWrite32(kNocRing, kNocTlb, kKernelThrottleAddress, throttle_counter);
+		uint8_t tlb = NOC2AXITensixBroadcastTlbAcquire(kNocRing, kKernelThrottleAddress,
+							       kNoc2AxiOrderingStrict);
+
+		NOC2AXIWrite32(kNocRing, tlb, kKernelThrottleAddress, throttle_counter);
+		NOC2AXITlbRelease(kNocRing, tlb);
 	}
 }
 
@@ -206,6 +214,20 @@ void InitThrottlers(void)
 	doppler_t2 = doppler;
 	doppler_t3 = doppler;
 
+	/* Start from a clean state, so the DVFS replay can run several traces back to back */
+	for (ThrottlerId i = 0; i < kThrottlerCount; i++) {
+		ThrottlerParamsToFixed(&throttler[i].params, &throttler[i].params_fixed);
+		throttler[i].state = (ThrottlerState){0};
+		throttler[i].state_fixed = (ThrottlerStateFixed){0};
+	}
+
+	memset(board_power_history, 0, sizeof(board_power_history));
+	board_power_history_cursor = board_power_history;
+	board_power_sum = 0;
+	kernel_nops_enabled = false;
+	t2_count = 0;
+	t3_count = 0;
+
 	SetThrottlerLimit(kThrottlerTDP,
 			  tt_bh_fwtable_get_fw_table(fwtable_dev)->chip_limits.tdp_limit);
 	SetThrottlerLimit(kThrottlerFastTDC,
@@ -236,34 +258,93 @@ void InitThrottlers(void)
 	EnableArbMax(kAiclkArbMaxDopplerCritical, false); /* enabled when limit triggered */
 }
 
+void ThrottlerParamsToFixed(const ThrottlerParams *params, ThrottlerParamsFixed *params_fixed)
+{
+	params_fixed->alpha_filter = q16_from_float(params->alpha_filter);
+	params_fixed->p_gain = q16_from_float(params->p_gain);
+	params_fixed->d_gain = q16_from_float(params->d_gain);
+}
+
+/* Filter the input and run one step of the P/D controller. This is the float reference for
+ * ThrottlerStepFixed.
+ *
+ * The gains are tuned for the nominal 1 ms DVFS period. dt is the time since the previous step in
+ * units of that period: the filter and the proportional term scale with it, so the controller
+ * tracks at the same rate whatever the period. The derivative term needs no scaling.
+ */
+void ThrottlerStep(const ThrottlerParams *params, ThrottlerState *state, float value, float dt)
+{
+	float alpha = MIN(params->alpha_filter * dt, 1.0F);
+
+	state->value = alpha * value + (1 - alpha) * state->value;
+	state->error = (state->limit - state->value) / state->limit;
+	state->output = params->p_gain * state->error * dt +
+			params->d_gain * (state->error - state->prev_error);
+	state->prev_error = state->error;
+}
+
+void ThrottlerStepFixed(const ThrottlerParamsFixed *params, ThrottlerStateFixed *state,
+			q16_t value, q16_t dt)
+{
+	/* The limit is only zero before InitThrottlers has run */
+	if (state->limit == 0) {
+		return;
+	}
+
+	q16_t alpha = MIN(q16_mul(params->alpha_filter, dt), Q16_ONE);
+
+	state->value = q16_mul(alpha, value) + q16_mul(Q16_ONE - alpha, state->value);
+	/* Widened, the difference overflows q16_t for a saturated negative input */
+	int64_t error = ((int64_t)state->limit - state->value) << Q16_SHIFT;
+
+	state->error = (q16_t)(error / state->limit);
+	state->output = q16_mul_sat(q16_mul(params->p_gain, state->error), dt) +
+			q16_mul(params->d_gain, state->error - state->prev_error);
+	state->prev_error = state->error;
+}
+
+/**
+ * @brief Set the time between throttler updates
+ *
+ * @param period_us The DVFS period the next updates run at
+ */
+void SetThrottlerPeriod(uint32_t period_us)
+{
+	throttler_dt = period_us / 1000.0F;
+	throttler_dt_fixed = (q16_t)(((uint64_t)period_us << Q16_SHIFT) / 1000);
+}
+
 static void UpdateThrottler(ThrottlerId id, float value)
 {
 	Throttler *t = &throttler[id];
 
-	t->value = t->params.alpha_filter * value + (1 - t->params.alpha_filter) * t->value;
-	t->error = (t->limit - t->value) / t->limit;
-	t->output = t->params.p_gain * t->error + t->params.d_gain * (t->error - t->prev_error);
-	t->prev_error = t->error;
+	if (IS_ENABLED(CONFIG_TT_BH_ARC_DVFS_FIXED_POINT)) {
+		ThrottlerStepFixed(&t->params_fixed, &t->state_fixed, q16_from_float(value),
+				   throttler_dt_fixed);
+	} else {
+		ThrottlerStep(&t->params, &t->state, value, throttler_dt);
+	}
 }
 
 static void UpdateThrottlerArb(ThrottlerId id)
 {
 	Throttler *t = &throttler[id];
 
-	float arb_val = GetThrottlerArbMax(t->arb_max);
+	if (IS_ENABLED(CONFIG_TT_BH_ARC_DVFS_FIXED_POINT)) {
+		/* Widen before scaling, a saturated error term would overflow q16_t */
+		int64_t arb_val = GetThrottlerArbMaxFixed(t->arb_max);
 
-	arb_val += t->output * kThrottlerAiclkScaleFactor;
+		arb_val += (int64_t)t->state_fixed.output * (int32_t)kThrottlerAiclkScaleFactor;
 
-	SetAiclkArbMax(t->arb_max, arb_val);
-}
+		SetAiclkArbMaxFixed(t->arb_max, CLAMP(arb_val, INT32_MIN, INT32_MAX));
+	} else {
+		float arb_val = GetThrottlerArbMax(t->arb_max);
 
-static uint16_t board_power_history[1000];
-static uint16_t *board_power_history_cursor = board_power_history;
-static uint32_t board_power_sum;
-static bool kernel_nops_enabled;
+		arb_val += t->state.output * kThrottlerAiclkScaleFactor;
 
-static uint8_t t2_count;
-static uint8_t t3_count;
+		SetAiclkArbMax(t->arb_max, arb_val);
+	}
+}
 
 #define ADVANCE_CIRCULAR_POINTER(pointer, array)                                                   \
 	do {                                                                                       \
@@ -281,14 +362,14 @@ static uint16_t UpdateMovingAveragePower(uint16_t current_power)
 	return board_power_sum / ARRAY_SIZE(board_power_history);
 }
 
-static bool DopplerActive(void)
+/* Doppler counts samples in its moving average and T2/T3 triggers, so it needs a steady period */
+bool DopplerActive(void)
 {
 	return doppler && power_limit > 0;
 }
 
-static void UpdateDoppler(const TelemetryInternalData *telemetry)
+static void UpdateDoppler(uint16_t current_power)
 {
-	uint16_t current_power = GetInputPower();
 	uint16_t average_power = UpdateMovingAveragePower(current_power);
 
 	UpdateThrottler(kThrottlerDopplerSlow, average_power);
@@ -336,29 +417,51 @@ static void UpdateDoppler(const TelemetryInternalData *telemetry)
 	EnableArbMax(kAiclkArbMaxDopplerCritical, critical_throttling);
 }
 
-void CalculateThrottlers(void)
+/**
+ * @brief Run one step of every throttler and update their AICLK arbiters
+ *
+ * @param inputs The measurements to throttle on
+ */
+void UpdateThrottlers(const ThrottlerInputs *inputs)
 {
-	TelemetryInternalData telemetry_internal_data;
-
-	ReadTelemetryInternal(1, &telemetry_internal_data);
-
 	if (DopplerActive()) {
-		UpdateDoppler(&telemetry_internal_data);
+		UpdateDoppler(inputs->input_power);
 	} else {
-		UpdateThrottler(kThrottlerTDP, telemetry_internal_data.vcore_power);
-		UpdateThrottler(kThrottlerFastTDC, telemetry_internal_data.vcore_current);
-		UpdateThrottler(kThrottlerTDC, telemetry_internal_data.vcore_current);
-		UpdateThrottler(kThrottlerBoardPower, GetInputPower());
+		UpdateThrottler(kThrottlerTDP, inputs->vcore_power);
+		UpdateThrottler(kThrottlerFastTDC, inputs->vcore_current);
+		UpdateThrottler(kThrottlerTDC, inputs->vcore_current);
+		UpdateThrottler(kThrottlerBoardPower, inputs->input_power);
 	}
 
-	UpdateThrottler(kThrottlerThm, telemetry_internal_data.asic_temperature);
-	UpdateThrottler(kThrottlerGDDRThm, GetMaxGDDRTemp());
+	UpdateThrottler(kThrottlerThm, inputs->asic_temperature);
+	UpdateThrottler(kThrottlerGDDRThm, inputs->gddr_temperature);
 
 	for (ThrottlerId i = 0; i < kThrottlerCount; i++) {
 		UpdateThrottlerArb(i);
 	}
 }
 
+/**
+ * @brief Read the measurements the throttlers act on
+ *
+ * @param max_staleness Maximum age in milliseconds of the telemetry the inputs are taken from
+ * @param inputs Filled with the measurements
+ */
+void ReadThrottlerInputs(int64_t max_staleness, ThrottlerInputs *inputs)
+{
+	TelemetryInternalData telemetry_internal_data;
+
+	ReadTelemetryInternal(max_staleness, &telemetry_internal_data);
+
+	*inputs = (ThrottlerInputs){
+		.vcore_power = telemetry_internal_data.vcore_power,
+		.vcore_current = telemetry_internal_data.vcore_current,
+		.asic_temperature = telemetry_internal_data.asic_temperature,
+		.input_power = GetInputPower(),
+		.gddr_temperature = GetMaxGDDRTemp(),
+	};
+}
+
 int32_t Dm2CmSetBoardPowerLimit(const uint8_t *data, uint8_t size)
 {
 	if (size != 2) {
@@ -6,8 +6,58 @@
 #ifndef THROTTLER_H
 #define THROTTLER_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+typedef struct {
+	float alpha_filter;
+	float p_gain;
+	float d_gain;
+} ThrottlerParams;
+
+typedef struct {
+	q16_t alpha_filter;
+	q16_t p_gain;
+	q16_t d_gain;
+} ThrottlerParamsFixed;
+
+typedef struct {
+	float limit;
+	float value;
+	float error;
+	float prev_error;
+	float output;
+} ThrottlerState;
+
+typedef struct {
+	q16_t limit;
+	q16_t value;
+	q16_t error;
+	q16_t prev_error;
+	q16_t output;
+} ThrottlerStateFixed;
+
+/* Measurements driving one throttler update */
+typedef struct {
+	float vcore_power;      /* W */
+	float vcore_current;    /* A */
+	float asic_temperature; /* degC */
+	uint16_t input_power;   /* W */
+	int gddr_temperature;   /* degC */
+} ThrottlerInputs;
+
+void ThrottlerParamsToFixed(const ThrottlerParams *params, ThrottlerParamsFixed *params_fixed);
+void ThrottlerStep(const ThrottlerParams *params, ThrottlerState *state, float value, float dt);
+void ThrottlerStepFixed(const ThrottlerParamsFixed *params, ThrottlerStateFixed *state,
+			q16_t value, q16_t dt);
+
 void InitThrottlers(void);
-void CalculateThrottlers(void);
+void ReadThrottlerInputs(int64_t max_staleness, ThrottlerInputs *inputs);
+void UpdateThrottlers(const ThrottlerInputs *inputs);
+void SetThrottlerPeriod(uint32_t period_us);
+bool DopplerActive(void);
 int32_t Dm2CmSetBoardPowerLimit(const uint8_t *data, uint8_t size);
 
 #endif
@@ -9,12 +9,16 @@
 #include <stdlib.h>
 
 #include <tenstorrent/bh_power.h>
+#include <tenstorrent/msgqueue.h>
 
 #include "telemetry.h"
 #include "smbus_target.h"
 #include "gddr.h"
 #include "asic_state.h"
 #include "noc_init.h"
+#include "noc.h"
+#include "noc2axi.h"
+#include "dma_bench.h"
 LOG_MODULE_REGISTER(tt_shell, CONFIG_LOG_DEFAULT_LEVEL);
 
 static int l2cpu_enable_handler(const struct shell *sh, size_t argc, char **argv)
@@ -148,12 +152,108 @@ static int telem_handler(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int msg_stats_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	struct msgqueue_msg_stats stats;
+
+	if (argc == 1) {
+		for (uint32_t code = 0; code < CONFIG_TT_BH_ARC_NUM_MSG_CODES; code++) {
+			if (msgqueue_get_msg_stats(code, &stats) == 0 && stats.count != 0) {
+				shell_print(sh, "0x%02X: count %u max %u us", code, stats.count,
+					    stats.max_us);
+			}
+		}
+		return 0;
+	}
+
+	uint32_t code = strtoul(argv[1], NULL, 0);
+	int ret = msgqueue_get_msg_stats(code, &stats);
+
+	if (ret != 0) {
+		shell_error(sh, "Failure to get statistics for message code 0x%02X", code);
+		return ret;
+	}
+
+	shell_print(sh, "0x%02X: count %u max %u us", code, stats.count, stats.max_us);
+	shell_print(sh, "  < 1 us: %u", stats.hist[0]);
+	for (uint32_t i = 1; i < ARRAY_SIZE(stats.hist); i++) {
+		if (i == ARRAY_SIZE(stats.hist) - 1) {
+			shell_print(sh, "  >= %lu us: %u", BIT(i - 1), stats.hist[i]);
+		} else {
+			shell_print(sh, "  %lu-%lu us: %u", BIT(i - 1), BIT(i) - 1, stats.hist[i]);
+		}
+	}
+
+	return 0;
+}
+
+static int tlb_stats_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	NOC2AXITlbStats stats;
+
+	for (uint8_t ring = 0; ring < NUM_NOCS; ring++) {
+		NOC2AXITlbGetStats(ring, &stats);
+		shell_print(sh, "NOC%u: hits %u misses %u evictions %u", ring, stats.hits,
+			    stats.misses, stats.evictions);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_TT_BH_ARC_DMA_BENCH
+static int dma_bench_handler(const struct shell *sh, size_t argc, char **argv)
+{
+	static const char *const engines[DmaBenchNumEngines] = {
+		[DmaBenchArc] = "arc",
+		[DmaBenchNoc] = "noc",
+		[DmaBenchPcieHostToChip] = "pcie_h2c",
+		[DmaBenchPcieChipToHost] = "pcie_c2h",
+	};
+	DmaBenchParams params = {
+		.engine = DmaBenchNumEngines,
+		.transfer_size = strtoul(argv[2], NULL, 0),
+		.iterations = strtoul(argv[3], NULL, 0),
+		.chip_addr = argc > 4 ? strtoull(argv[4], NULL, 0) : 0,
+		.host_addr = argc > 5 ? strtoull(argv[5], NULL, 0) : 0,
+	};
+	DmaBenchResult result;
+
+	for (int i = 0; i < DmaBenchNumEngines; i++) {
+		if (strcmp(argv[1], engines[i]) == 0) {
+			params.engine = i;
+		}
+	}
+
+	int ret = DmaBenchRun(&params, &result);
+
+	if (ret != 0) {
+		shell_error(sh, "Failure to run DMA benchmark: %d", ret);
+		return ret;
+	}
+
+	shell_print(sh, "%s: %u x %u bytes, %u MB/s", argv[1], params.iterations,
+		    params.transfer_size, result.mb_per_s);
+	shell_print(sh, "latency p50 %u ns p90 %u ns p99 %u ns max %u ns", result.p50_ns,
+		    result.p90_ns, result.p99_ns, result.max_ns);
+	shell_print(sh, "run %u us cpu %u us", result.wall_us, result.cpu_us);
+
+	return 0;
+}
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	sub_tt_commands, SHELL_CMD_ARG(mrisc_power, NULL, "[off|on]", mrisc_power_handler, 2, 0),
 	SHELL_CMD_ARG(tensix_power, NULL, "[off|on]", tensix_enable_handler, 2, 0),
 	SHELL_CMD_ARG(l2cpu_power, NULL, "[off|on]", l2cpu_enable_handler, 2, 0),
 	SHELL_CMD_ARG(asic_state, NULL, "[|0|3]", asic_state_handler, 1, 1),
 	SHELL_CMD_ARG(telem, NULL, "<Telemetry Index> [|x|f|d]", telem_handler, 2, 1),
+	SHELL_CMD_ARG(msg_stats, NULL, "[<Message Code>]", msg_stats_handler, 1, 1),
+	SHELL_CMD_ARG(tlb_stats, NULL, "", tlb_stats_handler, 1, 0),
+	IF_ENABLED(CONFIG_TT_BH_ARC_DMA_BENCH,
+		   (SHELL_CMD_ARG(dma_bench, NULL,
+				  "<arc|noc|pcie_h2c|pcie_c2h> <Size> <Iterations> "
+				  "[<Chip Address>] [<Host Address>]",
+				  dma_bench_handler, 4, 2),))
 	SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(tt, &sub_tt_commands, "Tensorrent commands", NULL);
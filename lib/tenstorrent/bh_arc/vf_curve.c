@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdbool.h>
 #include <zephyr/sys/util.h>
 #include "aiclk_ppm.h"
+#include "fixed_point.h"
 #include "vf_curve.h"
 #include <zephyr/drivers/misc/bh_fwtable.h>
 #include <tenstorrent/msgqueue.h>
@@ -17,15 +19,137 @@
 #define VOLTAGE_MARGIN_MAX 150.0F
 #define VOLTAGE_MARGIN_MIN -150.0F
 
-static const float vf_quadratic_coeff = 0.00031395F;
-static const float vf_linear_coeff = -0.43953F;
-static const float vf_constant = 828.83F;
+#define VF_QUADRATIC_COEFF 0.00031395
+#define VF_LINEAR_COEFF    -0.43953
+#define VF_CONSTANT        828.83
+
+static const float vf_quadratic_coeff = VF_QUADRATIC_COEFF;
+static const float vf_linear_coeff = VF_LINEAR_COEFF;
+static const float vf_constant = VF_CONSTANT;
+
+/* The fixed-point curve keeps 32 fractional bits in the coefficients so that the quadratic term
+ * stays accurate, and evaluates the polynomial in 64-bit integer arithmetic.
+ */
+#define VF_COEFF_SHIFT    32
+#define VF_COEFF_Q32(x)                                                                            \
+	((int64_t)((x) * (double)(1ULL << VF_COEFF_SHIFT) + ((x) < 0 ? -0.5 : 0.5)))
+/* Keeps the result within q16_t, far above any real operating point */
+#define VF_FIXED_FREQ_MAX 10000
+
+static const int64_t vf_quadratic_coeff_q32 = VF_COEFF_Q32(VF_QUADRATIC_COEFF);
+static const int64_t vf_linear_coeff_q32 = VF_COEFF_Q32(VF_LINEAR_COEFF);
+static const int64_t vf_constant_q32 = VF_COEFF_Q32(VF_CONSTANT);
 
 static float freq_margin_mhz = FREQ_MARGIN_MAX;
 static float voltage_margin_mv = VOLTAGE_MARGIN_MAX;
+static int32_t freq_margin_mhz_fixed = (int32_t)FREQ_MARGIN_MAX;
+static q16_t voltage_margin_mv_fixed = Q16_CONST(VOLTAGE_MARGIN_MAX);
+
+/* Frequency to voltage table, one entry every VF_LUT_FREQ_STEP MHz up to AICLK_FMAX_MAX. The
+ * curve is convex, so interpolating between entries and rounding up never drops below it.
+ */
+#define VF_LUT_FREQ_MAX     1400
+#define VF_LUT_FREQ_STEP    16
+#define VF_LUT_FREQ_ENTRIES (DIV_ROUND_UP(VF_LUT_FREQ_MAX, VF_LUT_FREQ_STEP) + 1)
+#define VF_LUT_FREQ_END     ((VF_LUT_FREQ_ENTRIES - 1) * VF_LUT_FREQ_STEP)
+
+/* Voltage to frequency table, holding the highest frequency up to VF_LUT_FREQ_MAX whose voltage
+ * is at most each VF_LUT_VOLTAGE_STEP mV point. Above the minimum of the curve this inverse is
+ * concave, so interpolating between entries and rounding down never exceeds it. The range
+ * covers the curve for any margin allowed by the FW table.
+ */
+#define VF_LUT_VOLTAGE_MIN  500
+#define VF_LUT_VOLTAGE_MAX  1200
+#define VF_LUT_VOLTAGE_STEP 2
+#define VF_LUT_VOLTAGE_ENTRIES                                                                     \
+	((VF_LUT_VOLTAGE_MAX - VF_LUT_VOLTAGE_MIN) / VF_LUT_VOLTAGE_STEP + 1)
+
+static q16_t vf_freq_lut[VF_LUT_FREQ_ENTRIES];
+static int16_t vf_voltage_lut[VF_LUT_VOLTAGE_ENTRIES];
+static q16_t vf_min_voltage_mv;    /* Lowest voltage on the curve up to VF_LUT_FREQ_MAX */
+static int32_t vf_min_voltage_freq; /* Highest frequency at vf_min_voltage_mv */
 
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
 
+/**
+ * @brief Calculate the voltage based on the frequency
+ *
+ * @param freq_mhz The frequency in MHz
+ * @return The voltage in mV
+ */
+float VFCurve(float freq_mhz)
+{
+	float freq_with_margin_mhz = freq_mhz + freq_margin_mhz;
+	float voltage_mv = vf_quadratic_coeff * freq_with_margin_mhz * freq_with_margin_mhz +
+			   vf_linear_coeff * freq_with_margin_mhz + vf_constant;
+
+	return voltage_mv + voltage_margin_mv;
+}
+
+/**
+ * @brief Fixed-point equivalent of VFCurve
+ *
+ * @param freq_mhz The frequency in MHz, clamped to VF_FIXED_FREQ_MAX
+ * @return The voltage in mV, in 16.16 fixed point
+ */
+q16_t VFCurveFixed(uint32_t freq_mhz)
+{
+	int64_t freq_with_margin_mhz = (int64_t)MIN(freq_mhz, VF_FIXED_FREQ_MAX) +
+				       freq_margin_mhz_fixed;
+	int64_t voltage_mv_q32 = vf_quadratic_coeff_q32 * freq_with_margin_mhz *
+					 freq_with_margin_mhz +
+				 vf_linear_coeff_q32 * freq_with_margin_mhz + vf_constant_q32;
+
+	return (q16_t)(voltage_mv_q32 >> (VF_COEFF_SHIFT - Q16_SHIFT)) + voltage_margin_mv_fixed;
+}
+
+static q16_t EvaluateVFCurve(uint32_t freq_mhz)
+{
+	if (IS_ENABLED(CONFIG_TT_BH_ARC_DVFS_FIXED_POINT)) {
+		return VFCurveFixed(freq_mhz);
+	} else {
+		return q16_from_float(VFCurve(freq_mhz));
+	}
+}
+
+static void BuildVFCurveTables(void)
+{
+	for (uint32_t i = 0; i < VF_LUT_FREQ_ENTRIES; i++) {
+		vf_freq_lut[i] = EvaluateVFCurve(i * VF_LUT_FREQ_STEP);
+	}
+
+	vf_min_voltage_mv = EvaluateVFCurve(0);
+	vf_min_voltage_freq = 0;
+	for (uint32_t freq_mhz = 1; freq_mhz <= VF_LUT_FREQ_MAX; freq_mhz++) {
+		q16_t voltage_mv = EvaluateVFCurve(freq_mhz);
+
+		if (voltage_mv <= vf_min_voltage_mv) {
+			vf_min_voltage_mv = voltage_mv;
+			vf_min_voltage_freq = freq_mhz;
+		}
+	}
+
+	/* Walk up the rising side of the curve, one voltage step at a time */
+	int32_t freq_mhz = vf_min_voltage_freq;
+
+	for (uint32_t i = 0; i < VF_LUT_VOLTAGE_ENTRIES; i++) {
+		q16_t voltage_mv = q16_from_int(VF_LUT_VOLTAGE_MIN + i * VF_LUT_VOLTAGE_STEP);
+
+		if (voltage_mv < vf_min_voltage_mv) {
+			vf_voltage_lut[i] = VF_CURVE_NO_FREQ;
+			continue;
+		}
+
+		while (freq_mhz < VF_LUT_FREQ_MAX && EvaluateVFCurve(freq_mhz + 1) <= voltage_mv) {
+			freq_mhz++;
+		}
+		vf_voltage_lut[i] = freq_mhz;
+	}
+}
+
+/* Builds the lookup tables, so it must run before the first lookup and never concurrently with
+ * one.
+ */
 void InitVFCurve(void)
 {
 	freq_margin_mhz =
@@ -34,34 +158,78 @@ void InitVFCurve(void)
 	voltage_margin_mv =
 		CLAMP(tt_bh_fwtable_get_fw_table(fwtable_dev)->chip_limits.voltage_margin,
 		      VOLTAGE_MARGIN_MIN, VOLTAGE_MARGIN_MAX);
+
+	/* The margins are whole MHz and mV in the FW table */
+	freq_margin_mhz_fixed = (int32_t)freq_margin_mhz;
+	voltage_margin_mv_fixed = q16_from_int((int32_t)voltage_margin_mv);
+
+	BuildVFCurveTables();
 }
 
 /**
- * @brief Calculate the voltage based on the frequency
+ * @brief Look up the voltage for a frequency in the precomputed VF curve table
  *
  * @param freq_mhz The frequency in MHz
- * @return The voltage in mV
+ * @return The voltage in mV, in 16.16 fixed point. Never below the analytic curve.
  */
-float VFCurve(float freq_mhz)
+q16_t VFCurveLookup(uint32_t freq_mhz)
 {
-	float freq_with_margin_mhz = freq_mhz + freq_margin_mhz;
-	float voltage_mv = vf_quadratic_coeff * freq_with_margin_mhz * freq_with_margin_mhz +
-			   vf_linear_coeff * freq_with_margin_mhz + vf_constant;
+	if (freq_mhz >= VF_LUT_FREQ_END) {
+		return EvaluateVFCurve(freq_mhz);
+	}
 
-	return voltage_mv + voltage_margin_mv;
+	uint32_t i = freq_mhz / VF_LUT_FREQ_STEP;
+	int64_t delta = (int64_t)(vf_freq_lut[i + 1] - vf_freq_lut[i]) *
+			(freq_mhz % VF_LUT_FREQ_STEP);
+
+	/* Round towards the upper entry; division already rounds a falling delta up */
+	if (delta > 0) {
+		delta += VF_LUT_FREQ_STEP - 1;
+	}
+
+	return vf_freq_lut[i] + (q16_t)(delta / VF_LUT_FREQ_STEP);
+}
+
+/**
+ * @brief Look up the highest frequency that runs at or below a voltage
+ *
+ * @param voltage_mv The voltage in mV
+ * @return The frequency in MHz, at most VF_LUT_FREQ_MAX and never above the analytic inverse of
+ *         the curve, or VF_CURVE_NO_FREQ if no frequency fits.
+ */
+int32_t VFCurveMaxFreq(uint32_t voltage_mv)
+{
+	if (voltage_mv < VF_LUT_VOLTAGE_MIN) {
+		return VF_CURVE_NO_FREQ;
+	} else if (voltage_mv >= VF_LUT_VOLTAGE_MAX) {
+		return vf_voltage_lut[VF_LUT_VOLTAGE_ENTRIES - 1];
+	}
+
+	uint32_t i = (voltage_mv - VF_LUT_VOLTAGE_MIN) / VF_LUT_VOLTAGE_STEP;
+	q16_t low_mv = q16_from_int(VF_LUT_VOLTAGE_MIN + i * VF_LUT_VOLTAGE_STEP);
+	q16_t high_mv = low_mv + q16_from_int(VF_LUT_VOLTAGE_STEP);
+	int32_t low_freq = vf_voltage_lut[i];
+	int32_t high_freq = vf_voltage_lut[i + 1];
+
+	if (low_freq == VF_CURVE_NO_FREQ) {
+		/* The step containing the bottom of the curve, interpolate from the minimum */
+		if (q16_from_int(voltage_mv) < vf_min_voltage_mv) {
+			return VF_CURVE_NO_FREQ;
+		}
+		low_mv = vf_min_voltage_mv;
+		low_freq = vf_min_voltage_freq;
+	}
+
+	return low_freq + (int32_t)((int64_t)(high_freq - low_freq) *
+				    (q16_from_int(voltage_mv) - low_mv) / (high_mv - low_mv));
 }
 
 static uint8_t get_voltage_curve_from_freq_handler(const union request *request,
 						   struct response *response)
 {
-	float input_freq_mhz = (float)request->get_voltage_curve_from_freq.input_freq_mhz;
-	float voltage_mv = VFCurve(input_freq_mhz);
+	q16_t voltage_mv = VFCurveLookup(request->get_voltage_curve_from_freq.input_freq_mhz);
 
-	if (voltage_mv < 0.0F) {
-		response->data[1] = 0U;
-	} else {
-		response->data[1] = (uint32_t)(voltage_mv);
-	}
+	response->data[1] = voltage_mv < 0 ? 0U : q16_to_int(voltage_mv);
 
 	return 0;
 }
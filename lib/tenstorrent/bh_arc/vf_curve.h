@@ -6,6 +6,16 @@
 #ifndef VF_CURVE_H
 #define VF_CURVE_H
 
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+/* Returned by VFCurveMaxFreq when no frequency fits under the voltage */
+#define VF_CURVE_NO_FREQ -1
+
 void InitVFCurve(void);
 float VFCurve(float freq_mhz);
+q16_t VFCurveFixed(uint32_t freq_mhz);
+q16_t VFCurveLookup(uint32_t freq_mhz);
+int32_t VFCurveMaxFreq(uint32_t voltage_mv);
 #endif
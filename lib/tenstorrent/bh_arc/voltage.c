@@ -19,14 +19,22 @@
 
 VoltageArbiter voltage_arbiter;
 
+/* Returns once the change is queued, so that the rail slews while the next DVFS tick runs.
+ * Anything that needs the new voltage must call VoltageWaitSettled first.
+ */
 void VoltageChange(void)
 {
 	if (voltage_arbiter.targ_voltage != voltage_arbiter.curr_voltage) {
-		set_vcore(voltage_arbiter.targ_voltage);
+		set_vcore_async(voltage_arbiter.targ_voltage);
 		voltage_arbiter.curr_voltage = voltage_arbiter.targ_voltage;
 	}
 }
 
+int VoltageWaitSettled(void)
+{
+	return wait_vcore_settled();
+}
+
 void VoltageArbRequest(VoltageRequestor req, uint32_t voltage)
 {
 	voltage_arbiter.req_voltage[req] =
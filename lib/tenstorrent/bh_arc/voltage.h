@@ -26,6 +26,7 @@ typedef struct {
 extern VoltageArbiter voltage_arbiter;
 
 void VoltageChange(void);
+int VoltageWaitSettled(void);
 void VoltageArbRequest(VoltageRequestor req, uint32_t voltage);
 void CalculateTargVoltage(void);
 int InitVoltagePPM(void);
@@ -51,6 +51,14 @@ ZTEST(clock_control_rate, test_set_rate_gddr)
 	}
 }
 
+static K_SEM_DEFINE(aiclk_settled, 0, 1);
+
+static void aiclk_settled_cb(const struct device *dev, clock_control_subsys_t subsys,
+			     void *user_data)
+{
+	k_sem_give(&aiclk_settled);
+}
+
 ZTEST(clock_control_rate, test_set_rate_aiclk)
 {
 	const struct device *pll = DEVICE_DT_GET(DT_NODELABEL(pll0));
@@ -67,6 +75,12 @@ ZTEST(clock_control_rate, test_set_rate_aiclk)
 					     (clock_control_subsys_rate_t)target_rate);
 		zassert_ok(ret, "set_rate for AICLK failed with %d", ret);
 
+		/* AICLK slews to the new rate in the background */
+		ret = clock_control_async_on(pll, aiclk_subsys, aiclk_settled_cb, NULL);
+		zassert_ok(ret, "async_on for AICLK failed with %d", ret);
+		zassert_ok(k_sem_take(&aiclk_settled, K_MSEC(10)), "AICLK did not settle");
+		zassert_equal(clock_control_get_status(pll, aiclk_subsys), CLOCK_CONTROL_STATUS_ON);
+
 		ret = clock_control_get_rate(pll, aiclk_subsys, &new_rate);
 		zassert_ok(ret, "get_rate for AICLK failed with %d", ret);
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measures how long small ARC HS DMA transfers take to be reported complete, both through the
+ * blocking dma_arc_hs_transfer() and through the DMA callback.
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/dma_arc_hs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define DMA_CHANNEL 0
+#define ITERATIONS  100
+#define MAX_SIZE    16384
+
+/* Completions used to be found by a work item polling every 1 ms, small transfers beat that now */
+#define MAX_CALLBACK_LATENCY_US 1000
+
+static const struct device *const arc_dma = DEVICE_DT_GET(DT_NODELABEL(dma0));
+
+static uint8_t src[MAX_SIZE] __aligned(4);
+static uint8_t dst[MAX_SIZE] __aligned(4);
+
+static const size_t sizes[] = {64, 1024, MAX_SIZE};
+
+static K_SEM_DEFINE(callback_sem, 0, 1);
+static uint32_t callback_cycles;
+
+static void dma_callback(const struct device *dev, void *user_data, uint32_t channel, int status)
+{
+	callback_cycles = k_cycle_get_32();
+	k_sem_give(&callback_sem);
+}
+
+static void fill(size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		src[i] = seed + i;
+	}
+	memset(dst, 0, len);
+}
+
+ZTEST(arc_hs_dma, test_transfer_latency)
+{
+	for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+		uint64_t total_cycles = 0;
+
+		for (int i = 0; i < ITERATIONS; i++) {
+			fill(sizes[s], i);
+
+			uint32_t start = k_cycle_get_32();
+
+			zassert_ok(dma_arc_hs_transfer(arc_dma, DMA_CHANNEL, src, dst, sizes[s],
+						       K_MSEC(100)));
+			total_cycles += k_cycle_get_32() - start;
+			zassert_mem_equal(dst, src, sizes[s]);
+		}
+
+		TC_PRINT("dma_arc_hs_transfer %5zu bytes: %llu us\n", sizes[s],
+			 k_cyc_to_us_floor64(total_cycles / ITERATIONS));
+	}
+}
+
+ZTEST(arc_hs_dma, test_callback_latency)
+{
+	for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+		struct dma_block_config block = {
+			.source_address = (uintptr_t)src,
+			.dest_address = (uintptr_t)dst,
+			.block_size = sizes[s],
+		};
+		struct dma_config config = {
+			.channel_direction = MEMORY_TO_MEMORY,
+			.block_count = 1,
+			.head_block = &block,
+			.dma_callback = dma_callback,
+		};
+		uint64_t total_cycles = 0;
+
+		for (int i = 0; i < ITERATIONS; i++) {
+			fill(sizes[s], i);
+			k_sem_reset(&callback_sem);
+
+			zassert_ok(dma_config(arc_dma, DMA_CHANNEL, &config));
+
+			uint32_t start = k_cycle_get_32();
+
+			zassert_ok(dma_start(arc_dma, DMA_CHANNEL));
+			zassert_ok(k_sem_take(&callback_sem, K_MSEC(100)));
+			total_cycles += callback_cycles - start;
+			zassert_mem_equal(dst, src, sizes[s]);
+		}
+
+		uint64_t latency_us = k_cyc_to_us_floor64(total_cycles / ITERATIONS);
+
+		TC_PRINT("dma_start to callback %5zu bytes: %llu us\n", sizes[s], latency_us);
+		if (sizes[s] <= 1024) {
+			zassert_true(latency_us < MAX_CALLBACK_LATENCY_US,
+				     "small transfer took %llu us to complete", latency_us);
+		}
+	}
+}
+
+static void *arc_hs_dma_setup(void)
+{
+	zassert_true(device_is_ready(arc_dma));
+	return NULL;
+}
+
+ZTEST_SUITE(arc_hs_dma, NULL, arc_hs_dma_setup, NULL, NULL, NULL);
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Slews an emulated AICLK the way the Blackhole PLL driver does, one feedback divider step at a
+ * time from a timer, and compares how long the caller of clock_control_set_rate() is blocked
+ * with how long the ramp takes.
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/clock_control.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define SLEW_STEP    DT_PROP(DT_NODELABEL(slewed_clk), slew_step)
+#define SLEW_STEP_NS DT_PROP(DT_NODELABEL(slewed_clk), slew_step_ns)
+#define BOOT_RATE    DT_PROP(DT_NODELABEL(slewed_clk), default_rate)
+
+#define AICLK ((clock_control_subsys_t)0)
+
+static const struct device *const slewed = DEVICE_DT_GET(DT_NODELABEL(slewed_clk));
+static const struct device *const instant = DEVICE_DT_GET(DT_NODELABEL(instant_clk));
+
+static K_SEM_DEFINE(settled, 0, 1);
+static uint32_t settled_cycles;
+
+static void on_settled(const struct device *dev, clock_control_subsys_t subsys, void *user_data)
+{
+	settled_cycles = k_cycle_get_32();
+	k_sem_give(&settled);
+}
+
+static uint32_t get_rate(const struct device *dev)
+{
+	uint32_t rate;
+
+	zassert_ok(clock_control_get_rate(dev, AICLK, &rate));
+	return rate;
+}
+
+static void wait_settled(const struct device *dev)
+{
+	zassert_ok(clock_control_async_on(dev, AICLK, on_settled, NULL));
+	zassert_ok(k_sem_take(&settled, K_SECONDS(1)), "clock did not settle");
+	zassert_equal(clock_control_get_status(dev, AICLK), CLOCK_CONTROL_STATUS_ON);
+}
+
+ZTEST(clock_control_emul, test_ramp_does_not_block)
+{
+	const uint32_t target = 1400;
+	const uint32_t steps = DIV_ROUND_UP(target - BOOT_RATE, SLEW_STEP);
+	uint32_t start = k_cycle_get_32();
+
+	zassert_ok(clock_control_set_rate(slewed, AICLK, (clock_control_subsys_rate_t)target));
+
+	uint32_t returned = k_cycle_get_32();
+
+	zassert_equal(clock_control_get_status(slewed, AICLK), CLOCK_CONTROL_STATUS_STARTING);
+	zassert_true(get_rate(slewed) < target);
+
+	wait_settled(slewed);
+	zassert_equal(get_rate(slewed), target);
+
+	uint64_t blocking_ns = k_cyc_to_ns_floor64(returned - start);
+	uint64_t ramp_ns = k_cyc_to_ns_floor64(settled_cycles - start);
+
+	TC_PRINT("%u steps: caller blocked for %llu ns, ramp took %llu ns\n", steps, blocking_ns,
+		 ramp_ns);
+
+	/* The ramp keeps to the configured step rate, without the caller paying for it */
+	zassert_true(ramp_ns >= (uint64_t)steps * SLEW_STEP_NS, "stepped faster than configured");
+	zassert_true(blocking_ns * 10 < ramp_ns, "caller blocked for %llu ns", blocking_ns);
+}
+
+ZTEST(clock_control_emul, test_retarget)
+{
+	/* A new rate before the ramp has started */
+	zassert_ok(clock_control_set_rate(slewed, AICLK, (clock_control_subsys_rate_t)1400));
+	zassert_ok(clock_control_set_rate(slewed, AICLK, (clock_control_subsys_rate_t)600));
+	wait_settled(slewed);
+	zassert_equal(get_rate(slewed), 600);
+
+	/* A new rate half way up the ramp turns it around */
+	zassert_ok(clock_control_set_rate(slewed, AICLK, (clock_control_subsys_rate_t)1400));
+	k_sleep(K_TICKS(2));
+	zassert_true(get_rate(slewed) > 600 && get_rate(slewed) < 1400);
+	zassert_ok(clock_control_set_rate(slewed, AICLK, (clock_control_subsys_rate_t)700));
+
+	/* Only one completion callback can be pending */
+	zassert_ok(clock_control_async_on(slewed, AICLK, on_settled, NULL));
+	zassert_equal(clock_control_async_on(slewed, AICLK, on_settled, NULL), -EBUSY);
+	zassert_ok(k_sem_take(&settled, K_SECONDS(1)), "clock did not settle");
+	zassert_equal(get_rate(slewed), 700);
+}
+
+ZTEST(clock_control_emul, test_instant)
+{
+	zassert_ok(clock_control_set_rate(instant, AICLK, (clock_control_subsys_rate_t)1400));
+	zassert_equal(get_rate(instant), 1400);
+	zassert_equal(clock_control_get_status(instant, AICLK), CLOCK_CONTROL_STATUS_ON);
+
+	/* Nothing to wait for, so the callback runs before async_on returns */
+	zassert_ok(clock_control_async_on(instant, AICLK, on_settled, NULL));
+	zassert_ok(k_sem_take(&settled, K_NO_WAIT));
+}
+
+static void clock_control_emul_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(clock_control_set_rate(slewed, AICLK, (clock_control_subsys_rate_t)BOOT_RATE));
+	wait_settled(slewed);
+	k_sem_reset(&settled);
+}
+
+ZTEST_SUITE(clock_control_emul, NULL, NULL, clock_control_emul_before, NULL, NULL);
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Runs the NOC DMA driver against an emulated NOC. Each tile's NIU accepts commands at once and
+ * lands them after a fixed latency, one 16 KiB burst after another, counting each burst in its
+ * ack counters the way the hardware does. The benchmark compares waiting for every transfer
+ * before starting the next with keeping several channels in flight and waiting on callbacks.
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/dma_tt_bh_noc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "noc2axi.h"
+
+#define NUM_CHANNELS DT_PROP(DT_NODELABEL(dma1), dma_channels)
+
+/* Emulated NOC timing */
+#define NOC_LATENCY_NS 2000
+#define NOC_BURST_NS   256
+#define NOC_BURST_SIZE 16384
+
+/* Low 24 bits of the NIU registers, as seen through a TLB window */
+#define NIU_REG_MASK             NOC_TLB_WINDOW_ADDR_MASK
+#define NIU_RET_ADDR_HI          0xB20014
+#define NIU_CMD_BRCST            0xB2001C
+#define NIU_AT_LEN               0xB20020
+#define NIU_CMD_CTRL             0xB20040
+#define NIU_MST_WR_ACK_RECEIVED  0xB20204
+#define NIU_MST_RD_RESP_RECEIVED 0xB20208
+#define NOC_CMD_WR               BIT(1)
+
+#define NUM_TLB         16
+#define NOC_WINDOWS_END (ARC_NOC0_BASE_ADDR + (NUM_TLB << NOC_TLB_LOG_SIZE))
+#define NIU_MAX_CMD     64
+
+#define BLOCK_SIZE      (4 * NOC_BURST_SIZE)
+#define BLOCKS_PER_CHAN 4
+#define NUM_TRANSFERS   (NUM_CHANNELS * BLOCKS_PER_CHAN)
+#define MAX_CHAIN       32
+
+void NOC2AXITlbReset(void);
+
+struct emul_cmd {
+	int64_t start_ns;
+	uint32_t bursts;
+};
+
+struct emul_counter {
+	uint32_t retired;
+	int64_t tail_ns;
+	struct emul_cmd cmds[NIU_MAX_CMD];
+	uint8_t head;
+	uint8_t count;
+};
+
+/* Each TLB of the DMA driver maps the registers of one tile, so the NIUs are kept per TLB */
+struct emul_niu {
+	uint32_t ret_addr_hi;
+	uint32_t cmd_brcst;
+	uint32_t at_len;
+	struct emul_counter wr_acks;
+	struct emul_counter rd_resps;
+};
+
+static const struct device *const dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
+
+static struct k_spinlock emul_lock;
+static struct emul_niu nius[NUM_TLB];
+static bool emul_stalled;
+
+/* Return coordinates of the commands issued, in order, which is the destination of a write */
+static uint32_t emul_ret_coords[MAX_CHAIN];
+static uint32_t emul_num_cmds;
+
+static int64_t emul_now_ns(void)
+{
+	return k_cyc_to_ns_floor64(k_cycle_get_64());
+}
+
+static uint32_t emul_counter_read(struct emul_counter *c, int64_t now)
+{
+	uint32_t value;
+
+	while (c->count > 0) {
+		struct emul_cmd *cmd = &c->cmds[c->head];
+
+		if (now < cmd->start_ns + cmd->bursts * NOC_BURST_NS) {
+			break;
+		}
+		c->retired += cmd->bursts;
+		c->head = (c->head + 1) % NIU_MAX_CMD;
+		c->count--;
+	}
+
+	value = c->retired;
+	for (uint8_t i = 0; i < c->count; i++) {
+		struct emul_cmd *cmd = &c->cmds[(c->head + i) % NIU_MAX_CMD];
+
+		if (now > cmd->start_ns) {
+			value += MIN(cmd->bursts, (now - cmd->start_ns) / NOC_BURST_NS);
+		}
+	}
+
+	return value;
+}
+
+/* Commands queue behind each other on the NIU, but their latencies overlap */
+static void emul_counter_issue(struct emul_counter *c, int64_t now, uint32_t bursts)
+{
+	emul_counter_read(c, now);
+	__ASSERT(c->count < NIU_MAX_CMD, "emulated NIU queue overflow");
+
+	struct emul_cmd *cmd = &c->cmds[(c->head + c->count++) % NIU_MAX_CMD];
+
+	cmd->start_ns = MAX(now + NOC_LATENCY_NS, c->tail_ns);
+	cmd->bursts = bursts;
+	c->tail_ns = cmd->start_ns + bursts * NOC_BURST_NS;
+}
+
+static struct emul_niu *emul_niu_get(uint32_t addr)
+{
+	if (addr < ARC_NOC0_BASE_ADDR || addr >= NOC_WINDOWS_END) {
+		return NULL;
+	}
+
+	return &nius[(addr - ARC_NOC0_BASE_ADDR) >> NOC_TLB_LOG_SIZE];
+}
+
+uint32_t ReadReg(uint32_t addr)
+{
+	struct emul_niu *niu = emul_niu_get(addr);
+	uint32_t value = 0;
+
+	if (niu == NULL) {
+		return 0;
+	}
+
+	K_SPINLOCK(&emul_lock) {
+		switch (addr & NIU_REG_MASK) {
+		case NIU_MST_WR_ACK_RECEIVED:
+			value = emul_counter_read(&niu->wr_acks, emul_now_ns());
+			break;
+		case NIU_MST_RD_RESP_RECEIVED:
+			value = emul_counter_read(&niu->rd_resps, emul_now_ns());
+			break;
+		default:
+			/* CMD_CTRL reads as ready, the NIU queues every command */
+			break;
+		}
+	}
+
+	return value;
+}
+
+void WriteReg(uint32_t addr, uint32_t val)
+{
+	struct emul_niu *niu = emul_niu_get(addr);
+
+	/* TLB programming lands outside the windows and needs no emulation */
+	if (niu == NULL) {
+		return;
+	}
+
+	K_SPINLOCK(&emul_lock) {
+		switch (addr & NIU_REG_MASK) {
+		case NIU_RET_ADDR_HI:
+			niu->ret_addr_hi = val;
+			break;
+		case NIU_CMD_BRCST:
+			niu->cmd_brcst = val;
+			break;
+		case NIU_AT_LEN:
+			niu->at_len = val;
+			break;
+		case NIU_CMD_CTRL:
+			if (emul_num_cmds < ARRAY_SIZE(emul_ret_coords)) {
+				emul_ret_coords[emul_num_cmds] = niu->ret_addr_hi;
+			}
+			emul_num_cmds++;
+			if (emul_stalled) {
+				break;
+			}
+			emul_counter_issue((niu->cmd_brcst & NOC_CMD_WR) ? &niu->wr_acks
+									: &niu->rd_resps,
+					   emul_now_ns(),
+					   DIV_ROUND_UP(niu->at_len, NOC_BURST_SIZE));
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void GetEnabledTensix(uint8_t *x, uint8_t *y)
+{
+	*x = 1;
+	*y = 2;
+}
+
+static K_SEM_DEFINE(transfer_done, 0, NUM_CHANNELS);
+static int callback_status[NUM_CHANNELS][MAX_CHAIN];
+static uint8_t callback_count[NUM_CHANNELS];
+
+static void dma_callback(const struct device *dev, void *user_data, uint32_t channel, int status)
+{
+	if (callback_count[channel] < ARRAY_SIZE(callback_status[channel])) {
+		callback_status[channel][callback_count[channel]++] = status;
+	}
+
+	if (status != DMA_STATUS_BLOCK) {
+		k_sem_give(&transfer_done);
+	}
+}
+
+static struct dma_block_config blocks[NUM_CHANNELS][MAX_CHAIN];
+static struct tt_bh_dma_noc_coords coords[NUM_CHANNELS];
+
+/* Write a number of blocks from tile (x, 2) to the ARC on a channel */
+static int config_channel(uint32_t channel, uint8_t x, uint32_t block_count, bool block_callbacks)
+{
+	coords[channel] = tt_bh_dma_noc_coords_init(x, 2, 8, 0);
+
+	for (uint32_t i = 0; i < block_count; i++) {
+		blocks[channel][i] = (struct dma_block_config){
+			.source_address = i * BLOCK_SIZE,
+			.dest_address = i * BLOCK_SIZE,
+			.block_size = BLOCK_SIZE,
+			.next_block = (i + 1 < block_count) ? &blocks[channel][i + 1] : NULL,
+		};
+	}
+
+	struct dma_config config = {
+		.channel_direction = PERIPHERAL_TO_MEMORY,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.block_count = block_count,
+		.head_block = &blocks[channel][0],
+		.user_data = &coords[channel],
+		.dma_callback = dma_callback,
+		.complete_callback_en = block_callbacks,
+	};
+
+	return dma_config(dma_noc, channel, &config);
+}
+
+ZTEST(dma_noc_emul, test_callbacks)
+{
+	zassert_ok(config_channel(0, 1, 3, true));
+	zassert_ok(dma_start(dma_noc, 0));
+
+	zassert_ok(k_sem_take(&transfer_done, K_MSEC(10)));
+	zassert_equal(callback_count[0], 3);
+	zassert_equal(callback_status[0][0], DMA_STATUS_BLOCK);
+	zassert_equal(callback_status[0][1], DMA_STATUS_BLOCK);
+	zassert_equal(callback_status[0][2], DMA_STATUS_COMPLETE);
+}
+
+ZTEST(dma_noc_emul, test_long_chain)
+{
+	struct dma_status status;
+
+	/* Longer than the NIU can land at once, so the chain completes over several polls */
+	zassert_ok(config_channel(0, 1, MAX_CHAIN, true));
+	zassert_ok(dma_start(dma_noc, 0));
+	zassert_equal(emul_num_cmds, MAX_CHAIN, "start did not issue the whole chain");
+
+	zassert_ok(dma_get_status(dma_noc, 0, &status));
+	zassert_true(status.busy);
+	zassert_equal(status.pending_length, MAX_CHAIN * BLOCK_SIZE);
+
+	zassert_ok(k_sem_take(&transfer_done, K_MSEC(10)));
+	zassert_equal(callback_count[0], MAX_CHAIN);
+	for (uint32_t i = 0; i + 1 < MAX_CHAIN; i++) {
+		zassert_equal(callback_status[0][i], DMA_STATUS_BLOCK);
+	}
+	zassert_equal(callback_status[0][MAX_CHAIN - 1], DMA_STATUS_COMPLETE);
+}
+
+ZTEST(dma_noc_emul, test_scatter)
+{
+	struct tt_bh_dma_noc_scatter_block scatter[8];
+
+	coords[0] = tt_bh_dma_noc_coords_init(1, 2, 0, 0);
+	for (uint8_t i = 0; i < ARRAY_SIZE(scatter); i++) {
+		scatter[i] = (struct tt_bh_dma_noc_scatter_block){
+			.block = {.block_size = BLOCK_SIZE},
+			.dest_x = 1 + i % 4,
+			.dest_y = 3 + i / 4,
+		};
+	}
+
+	struct dma_config config = {
+		.channel_direction = TT_BH_DMA_NOC_CHANNEL_DIRECTION_SCATTER,
+		.block_count = ARRAY_SIZE(scatter),
+		.head_block = tt_bh_dma_noc_scatter_link(scatter, ARRAY_SIZE(scatter)),
+		.user_data = &coords[0],
+		.dma_callback = dma_callback,
+	};
+
+	zassert_ok(dma_config(dma_noc, 0, &config));
+	zassert_ok(dma_start(dma_noc, 0));
+	zassert_ok(tt_bh_dma_noc_wait(dma_noc, 0, K_MSEC(10)));
+
+	/* One write per block, each to its own tile */
+	zassert_equal(emul_num_cmds, ARRAY_SIZE(scatter));
+	for (uint8_t i = 0; i < ARRAY_SIZE(scatter); i++) {
+		zassert_equal(emul_ret_coords[i], (scatter[i].dest_y << 6) | scatter[i].dest_x);
+	}
+	zassert_equal(callback_status[0][0], DMA_STATUS_COMPLETE);
+}
+
+ZTEST(dma_noc_emul, test_busy_channel)
+{
+	struct dma_status status;
+
+	zassert_ok(config_channel(0, 1, 2, false));
+	zassert_ok(dma_start(dma_noc, 0));
+
+	/* start() returns as soon as the blocks are issued */
+	zassert_ok(dma_get_status(dma_noc, 0, &status));
+	zassert_true(status.busy);
+	zassert_equal(status.pending_length, 2 * BLOCK_SIZE);
+	zassert_equal(config_channel(0, 1, 1, false), -EBUSY);
+	zassert_equal(dma_start(dma_noc, 0), -EBUSY);
+
+	zassert_ok(tt_bh_dma_noc_wait(dma_noc, 0, K_MSEC(10)));
+	zassert_ok(dma_get_status(dma_noc, 0, &status));
+	zassert_false(status.busy);
+	zassert_equal(status.pending_length, 0);
+	zassert_equal(callback_status[0][0], DMA_STATUS_COMPLETE);
+}
+
+ZTEST(dma_noc_emul, test_shared_niu)
+{
+	/* Both channels run from the same tile, so the second lands after the first */
+	zassert_ok(config_channel(0, 1, BLOCKS_PER_CHAN, false));
+	zassert_ok(config_channel(1, 1, 1, false));
+	zassert_ok(dma_start(dma_noc, 0));
+	zassert_ok(dma_start(dma_noc, 1));
+
+	struct dma_status status;
+
+	zassert_ok(tt_bh_dma_noc_wait(dma_noc, 1, K_MSEC(10)));
+	zassert_ok(dma_get_status(dma_noc, 0, &status));
+	zassert_false(status.busy, "channel 1 finished before the blocks ahead of it");
+	zassert_ok(k_sem_take(&transfer_done, K_NO_WAIT));
+	zassert_ok(k_sem_take(&transfer_done, K_NO_WAIT));
+}
+
+ZTEST(dma_noc_emul, test_timeout)
+{
+	struct dma_status status;
+
+	emul_stalled = true;
+	zassert_ok(config_channel(0, 1, 1, false));
+	zassert_ok(dma_start(dma_noc, 0));
+
+	zassert_ok(k_sem_take(&transfer_done, K_MSEC(100)));
+	zassert_equal(callback_status[0][0], -EIO);
+	zassert_ok(dma_get_status(dma_noc, 0, &status));
+	zassert_false(status.busy);
+}
+
+ZTEST(dma_noc_emul, test_throughput)
+{
+	uint64_t serial_ns = 0;
+	uint64_t serial_wait_ns = 0;
+	uint64_t pipelined_ns;
+	uint64_t pipelined_wait_ns;
+	uint64_t chained_ns;
+	uint64_t total_bytes = (uint64_t)NUM_TRANSFERS * BLOCK_SIZE;
+	int64_t start;
+	int64_t wait_start;
+
+	/* One block in flight at a time, spinning on the ack counter of each */
+	for (uint32_t i = 0; i < NUM_TRANSFERS; i++) {
+		start = emul_now_ns();
+		zassert_ok(config_channel(0, 1, 1, false));
+		zassert_ok(dma_start(dma_noc, 0));
+		wait_start = emul_now_ns();
+		zassert_ok(tt_bh_dma_noc_wait(dma_noc, 0, K_MSEC(10)));
+		serial_wait_ns += emul_now_ns() - wait_start;
+		serial_ns += emul_now_ns() - start;
+		k_sem_take(&transfer_done, K_NO_WAIT);
+	}
+
+	/* Every channel busy with a multi-block transfer, sleeping until the callbacks */
+	start = emul_now_ns();
+	for (uint32_t channel = 0; channel < NUM_CHANNELS; channel++) {
+		zassert_ok(config_channel(channel, channel + 1, BLOCKS_PER_CHAN, false));
+		zassert_ok(dma_start(dma_noc, channel));
+	}
+	pipelined_wait_ns = emul_now_ns() - start;
+	for (uint32_t channel = 0; channel < NUM_CHANNELS; channel++) {
+		zassert_ok(k_sem_take(&transfer_done, K_MSEC(10)));
+	}
+	pipelined_ns = emul_now_ns() - start;
+
+	for (uint32_t channel = 0; channel < NUM_CHANNELS; channel++) {
+		zassert_equal(callback_status[channel][0], DMA_STATUS_COMPLETE);
+	}
+
+	/* The same blocks as a single chain, issued back to back on one channel */
+	start = emul_now_ns();
+	zassert_ok(config_channel(0, 1, NUM_TRANSFERS, false));
+	zassert_ok(dma_start(dma_noc, 0));
+	zassert_ok(k_sem_take(&transfer_done, K_MSEC(10)));
+	chained_ns = emul_now_ns() - start;
+
+	TC_PRINT("serial:    %u KiB in %llu us, %llu MB/s, CPU waited %llu us\n",
+		 (uint32_t)(total_bytes / 1024), serial_ns / 1000, total_bytes * 1000 / serial_ns,
+		 serial_wait_ns / 1000);
+	TC_PRINT("pipelined: %u KiB in %llu us, %llu MB/s, CPU waited %llu us\n",
+		 (uint32_t)(total_bytes / 1024), pipelined_ns / 1000,
+		 total_bytes * 1000 / pipelined_ns, pipelined_wait_ns / 1000);
+	TC_PRINT("chained:   %u KiB in %llu us, %llu MB/s\n", (uint32_t)(total_bytes / 1024),
+		 chained_ns / 1000, total_bytes * 1000 / chained_ns);
+
+	zassert_true(pipelined_ns < serial_ns, "no throughput gain from overlapping transfers");
+	zassert_true(pipelined_wait_ns * 4 < serial_wait_ns, "CPU still waits on the transfers");
+	zassert_true(chained_ns < serial_ns, "no throughput gain from chaining the blocks");
+}
+
+static void dma_noc_emul_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start the counters close to wrapping, which the driver must handle */
+	memset(nius, 0, sizeof(nius));
+	for (uint8_t tlb = 0; tlb < NUM_TLB; tlb++) {
+		nius[tlb].wr_acks.retired = UINT32_MAX - 7;
+		nius[tlb].rd_resps.retired = UINT32_MAX - 7;
+	}
+	emul_stalled = false;
+	emul_num_cmds = 0;
+
+	memset(callback_status, 0, sizeof(callback_status));
+	memset(callback_count, 0, sizeof(callback_count));
+	k_sem_reset(&transfer_done);
+}
+
+static void dma_noc_emul_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (uint32_t channel = 0; channel < NUM_CHANNELS; channel++) {
+		dma_stop(dma_noc, channel);
+	}
+	NOC2AXITlbReset();
+}
+
+ZTEST_SUITE(dma_noc_emul, NULL, NULL, dma_noc_emul_before, dma_noc_emul_after, NULL);
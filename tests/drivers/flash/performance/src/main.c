@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/drivers/flash.h>
@@ -11,6 +13,10 @@
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/irq.h>
 
+#ifdef CONFIG_DMA_ARC_HS
+#include <zephyr/drivers/dma/dma_arc_hs.h>
+#endif
+
 #define TEST_AREA	storage_partition
 
 #define TEST_AREA_OFFSET	FIXED_PARTITION_OFFSET(TEST_AREA)
@@ -23,6 +29,63 @@ static const struct device *const flash_dev = TEST_AREA_DEVICE;
 static uint8_t buf[TEST_AREA_SIZE];
 static uint8_t check_buf[TEST_AREA_SIZE];
 
+#ifdef CONFIG_DMA_ARC_HS
+/* Firmware loads stream flash through a scratch buffer of this size */
+#define STREAM_CHUNK_SIZE 4096
+
+static const struct device *const arc_dma = DEVICE_DT_GET(DT_NODELABEL(dma0));
+static uint8_t stream_buf[2][STREAM_CHUNK_SIZE] __aligned(4);
+static uint8_t stream_dst[TEST_AREA_SIZE] __aligned(4);
+
+/* Read a chunk, DMA it out, then read the next one */
+static void stream_serial(void)
+{
+	for (size_t offset = 0; offset < TEST_AREA_SIZE; offset += STREAM_CHUNK_SIZE) {
+		zassert_ok(flash_read(flash_dev, TEST_AREA_OFFSET + offset, stream_buf[0],
+				      STREAM_CHUNK_SIZE));
+		zassert_ok(dma_arc_hs_transfer(arc_dma, 0, stream_buf[0], stream_dst + offset,
+					       STREAM_CHUNK_SIZE, K_MSEC(100)));
+	}
+}
+
+/* Read the next chunk into one buffer while the other is DMA-ing out */
+static void stream_pipelined(void)
+{
+	int cur = 0;
+
+	zassert_ok(flash_read(flash_dev, TEST_AREA_OFFSET, stream_buf[cur], STREAM_CHUNK_SIZE));
+
+	for (size_t offset = 0; offset < TEST_AREA_SIZE; offset += STREAM_CHUNK_SIZE, cur ^= 1) {
+		size_t next = offset + STREAM_CHUNK_SIZE;
+
+		zassert_ok(dma_arc_hs_transfer_start(arc_dma, 0, stream_buf[cur],
+						     stream_dst + offset, STREAM_CHUNK_SIZE));
+		if (next < TEST_AREA_SIZE) {
+			zassert_ok(flash_read(flash_dev, TEST_AREA_OFFSET + next,
+					      stream_buf[cur ^ 1], STREAM_CHUNK_SIZE));
+		}
+		zassert_ok(dma_arc_hs_transfer_wait(arc_dma, 0, K_MSEC(100)));
+	}
+}
+
+static uint64_t stream_time_us(void (*stream)(void))
+{
+	uint64_t total_cycles = 0;
+
+	for (int i = 0; i < TEST_ITERATIONS; i++) {
+		memset(stream_dst, 0, sizeof(stream_dst));
+
+		uint32_t start = k_cycle_get_32();
+
+		stream();
+		total_cycles += k_cycle_get_32() - start;
+		zassert_mem_equal(stream_dst, buf, TEST_AREA_SIZE);
+	}
+
+	return k_cyc_to_us_floor64(total_cycles / TEST_ITERATIONS);
+}
+#endif
+
 static int flash_program_wrap(const struct device *dev, off_t offset,
 			const void *data, size_t len)
 {
@@ -82,5 +145,19 @@ ZTEST(flash_driver_perf, test_program_perf)
 	zassert_true(delta < CONFIG_EXPECTED_PROGRAM_TIME, "Program performance test failed");
 }
 
+#ifdef CONFIG_DMA_ARC_HS
+ZTEST(flash_driver_perf, test_stream_to_sram_perf)
+{
+	zassert_true(device_is_ready(arc_dma));
+	zassert_ok(flash_read(flash_dev, TEST_AREA_OFFSET, buf, TEST_AREA_SIZE));
+
+	uint64_t serial_us = stream_time_us(stream_serial);
+	uint64_t pipelined_us = stream_time_us(stream_pipelined);
+
+	TC_PRINT("Streaming %u bytes through %u byte chunks: serial %llu us, pipelined %llu us\n",
+		 TEST_AREA_SIZE, STREAM_CHUNK_SIZE, serial_us, pipelined_us);
+	zassert_true(pipelined_us <= serial_us, "Overlapping flash reads with DMA was slower");
+}
+#endif
 
 ZTEST_SUITE(flash_driver_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "aiclk_ppm.h"
+
+extern void InitAiclkPPMState(uint32_t boot_freq);
+
+static AiclkArbStats get_stats(AiclkArbMax arb_max)
+{
+	AiclkArbStats stats;
+
+	zassert_ok(GetAiclkArbStats(arb_max, &stats));
+
+	return stats;
+}
+
+ZTEST(aiclk_ppm, test_limit_stats)
+{
+	uint32_t start = k_uptime_get_32();
+	AiclkArbStats stats;
+
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxCount);
+
+	SetAiclkArbMax(kAiclkArbMaxTDP, 500);
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxTDP);
+
+	k_msleep(20);
+	CalculateTargAiclk();
+	stats = get_stats(kAiclkArbMaxTDP);
+	zassert_equal(stats.entry_count, 1);
+	zassert_between_inclusive(stats.time_limited_ms, 20, 30);
+	zassert_between_inclusive(stats.last_entry_ms, start, start + 10);
+
+	/* A lower arbiter takes over, only it is charged from now on */
+	SetAiclkArbMax(kAiclkArbMaxThm, 400);
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxThm);
+
+	k_msleep(10);
+	zassert_equal(get_stats(kAiclkArbMaxTDP).time_limited_ms, stats.time_limited_ms);
+	zassert_between_inclusive(get_stats(kAiclkArbMaxThm).time_limited_ms, 10, 20);
+
+	/* TDP limits again once the thermal throttler lets go */
+	SetAiclkArbMax(kAiclkArbMaxThm, GetAiclkFmax());
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxTDP);
+	stats = get_stats(kAiclkArbMaxTDP);
+	zassert_equal(stats.entry_count, 2);
+	zassert_equal(stats.last_entry_ms, k_uptime_get_32());
+	zassert_equal(get_stats(kAiclkArbMaxThm).entry_count, 1);
+
+	SetAiclkArbMax(kAiclkArbMaxTDP, GetAiclkFmax());
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxCount);
+	zassert_equal(get_stats(kAiclkArbMaxTDP).entry_count, 2);
+}
+
+ZTEST(aiclk_ppm, test_limit_stats_idle_and_forced)
+{
+	/* Idle AICLK sits at fmin, below the arbiter, so nothing is throttling it */
+	aiclk_set_busy(false);
+	SetAiclkArbMax(kAiclkArbMaxTDP, 500);
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxCount);
+	zassert_equal(get_stats(kAiclkArbMaxTDP).entry_count, 0);
+
+	/* Disabled arbiters never limit */
+	aiclk_set_busy(true);
+	EnableArbMax(kAiclkArbMaxTDP, false);
+	CalculateTargAiclk();
+	zassert_equal(GetAiclkLimiter(), kAiclkArbMaxCount);
+	zassert_equal(GetAiclkTarg(), GetAiclkFmax());
+}
+
+ZTEST(aiclk_ppm, test_limit_stats_invalid_arbiter)
+{
+	AiclkArbStats stats;
+
+	zassert_equal(GetAiclkArbStats(kAiclkArbMaxCount, &stats), -EINVAL);
+}
+
+static void aiclk_ppm_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	InitAiclkPPMState(800);
+	aiclk_set_busy(true);
+}
+
+ZTEST_SUITE(aiclk_ppm, NULL, NULL, aiclk_ppm_before, NULL, NULL);
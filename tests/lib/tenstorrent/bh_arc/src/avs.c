@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Drives the AVSBus command queue against a register model of the APB2AVSBUS controller. The
+ * model runs one command from its command FIFO each time the FIFO status register is read, and
+ * can be stalled to hold commands in the FIFO.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "avs.h"
+#include "reg_mock.h"
+
+#define AVS_CMD_REG          0x80100000
+#define AVS_READBACK_REG     0x80100004
+#define AVS_FIFOS_STATUS_REG 0x80100028
+#define AVS_CFG_0_REG        0x80100050
+
+#define AVS_CMD_DATA(cmd)  (((cmd) >> 3) & 0xFFFF)
+#define AVS_CMD_RAIL(cmd)  (((cmd) >> 19) & 0xF)
+#define AVS_CMD_CODE(cmd)  (((cmd) >> 23) & 0xF)
+#define AVS_CMD_READ(cmd)  (((cmd) >> 28) == 3)
+#define AVS_READBACK_NACK  (AVSResourceUnavailable << 30)
+#define AVS_RAIL_BROADCAST 0xf
+
+#define AVS_CODE_VOLTAGE 0x0
+#define AVS_CODE_CURRENT 0x2
+#define AVS_CODE_TEMP    0x3
+#define AVS_CODE_STATUS  0xe
+
+#define MODEL_CMD_FIFO_DEPTH      4
+#define MODEL_READBACK_FIFO_DEPTH 15
+#define MODEL_MAX_RETRIES         3
+#define MODEL_LOG_DEPTH           32
+
+static struct {
+	uint32_t cmd_fifo[MODEL_CMD_FIFO_DEPTH];
+	uint32_t cmd_count;
+	uint32_t readback_fifo[MODEL_READBACK_FIFO_DEPTH];
+	uint32_t readback_count;
+	uint16_t voltage[2];
+	uint16_t current;
+	uint16_t temp;
+	uint16_t status;
+	uint32_t nacks; /* Tries to NACK before acknowledging */
+	bool stalled;
+	uint32_t log[MODEL_LOG_DEPTH];
+	uint32_t log_count;
+} model;
+
+struct completion {
+	uint32_t count;
+	uint16_t responses[CONFIG_TT_BH_ARC_AVS_QUEUE_DEPTH];
+	AVSStatus status;
+};
+
+static void model_push_readback(uint32_t readback)
+{
+	zassert_true(model.readback_count < MODEL_READBACK_FIFO_DEPTH, "readback FIFO overflow");
+	model.readback_fifo[model.readback_count++] = readback;
+}
+
+static void model_run_cmd(void)
+{
+	uint32_t cmd = model.cmd_fifo[0];
+	uint16_t *reg = NULL;
+
+	memmove(&model.cmd_fifo[0], &model.cmd_fifo[1], --model.cmd_count * sizeof(uint32_t));
+
+	switch (AVS_CMD_CODE(cmd)) {
+	case AVS_CODE_VOLTAGE:
+		reg = &model.voltage[AVS_CMD_RAIL(cmd)];
+		break;
+	case AVS_CODE_CURRENT:
+		reg = &model.current;
+		break;
+	case AVS_CODE_TEMP:
+		reg = &model.temp;
+		break;
+	case AVS_CODE_STATUS:
+		reg = &model.status;
+		break;
+	default:
+		zassert_unreachable("unexpected command %08x", cmd);
+	}
+
+	for (uint32_t try = 0; try <= MODEL_MAX_RETRIES; try++) {
+		if (model.nacks > 0) {
+			model.nacks--;
+			model_push_readback(AVS_READBACK_NACK);
+			continue;
+		}
+
+		if (!AVS_CMD_READ(cmd)) {
+			*reg = AVS_CMD_DATA(cmd);
+		}
+		model_push_readback(*reg << 8);
+		break;
+	}
+}
+
+static uint32_t model_read(uint32_t addr)
+{
+	uint32_t readback;
+
+	switch (addr) {
+	case AVS_FIFOS_STATUS_REG:
+		if (!model.stalled && model.cmd_count > 0) {
+			model_run_cmd();
+		}
+		return ((MODEL_CMD_FIFO_DEPTH - model.cmd_count) << 8) |
+		       (model.readback_count << 16);
+	case AVS_READBACK_REG:
+		zassert_true(model.readback_count > 0, "read from an empty readback FIFO");
+		readback = model.readback_fifo[0];
+		memmove(&model.readback_fifo[0], &model.readback_fifo[1],
+			--model.readback_count * sizeof(uint32_t));
+		return readback;
+	case AVS_CFG_0_REG:
+		return MODEL_MAX_RETRIES;
+	default:
+		return 0;
+	}
+}
+
+static void model_write(uint32_t addr, uint32_t val)
+{
+	if (addr == AVS_CMD_REG) {
+		zassert_true(model.cmd_count < MODEL_CMD_FIFO_DEPTH, "command FIFO overflow");
+		model.cmd_fifo[model.cmd_count++] = val;
+		if (model.log_count < MODEL_LOG_DEPTH) {
+			model.log[model.log_count++] = val;
+		}
+	}
+}
+
+static void record_completion(AVSStatus status, uint16_t response, void *user_data)
+{
+	struct completion *done = user_data;
+
+	if (done->count < ARRAY_SIZE(done->responses)) {
+		done->responses[done->count] = response;
+	}
+	done->count++;
+	done->status = status;
+}
+
+static K_SEM_DEFINE(current_done, 0, 1);
+static AVSStatus current_status;
+static uint16_t current_response;
+
+static void current_callback(AVSStatus status, uint16_t response, void *user_data)
+{
+	current_status = status;
+	current_response = response;
+	k_sem_give(&current_done);
+}
+
+ZTEST(avs, test_write_voltage_async)
+{
+	struct completion done = {0};
+
+	zassert_ok(AVSWriteVoltageAsync(800, AVS_VCORE_RAIL, record_completion, &done));
+
+	/* The write is on the bus, but the caller is free to carry on */
+	zassert_equal(done.count, 0);
+	zassert_equal(AVSWaitSlew(AVS_VCORE_RAIL, K_NO_WAIT), -EAGAIN);
+	zassert_ok(AVSWaitSlew(AVS_VCOREM_RAIL, K_NO_WAIT), "other rail is not slewing");
+
+	zassert_ok(AVSWaitSlew(AVS_VCORE_RAIL, K_SECONDS(1)));
+	zassert_equal(done.count, 1);
+	zassert_equal(done.status, AVSOk);
+	zassert_equal(model.voltage[AVS_VCORE_RAIL], 800);
+
+	zassert_equal(AVSWriteVoltageAsync(800, AVS_RAIL_BROADCAST, NULL, NULL), -EINVAL);
+}
+
+ZTEST(avs, test_sync_commands)
+{
+	uint16_t voltage;
+	float current;
+
+	model.current = 1234;
+
+	zassert_equal(AVSWriteVoltage(750, AVS_VCOREM_RAIL), AVSOk);
+	zassert_ok(AVSWaitSlew(AVS_VCOREM_RAIL, K_NO_WAIT), "sync write returned before slewing");
+	zassert_equal(AVSReadVoltage(AVS_VCOREM_RAIL, &voltage), AVSOk);
+	zassert_equal(voltage, 750);
+	zassert_equal(AVSReadCurrent(AVS_VCORE_RAIL, &current), AVSOk);
+	zassert_within(current, 12.34f, 0.001f);
+}
+
+ZTEST(avs, test_retries)
+{
+	uint16_t voltage;
+
+	model.voltage[AVS_VCORE_RAIL] = 720;
+
+	/* The controller retries by itself, and each NACKed try leaves a readback behind */
+	model.nacks = MODEL_MAX_RETRIES;
+	zassert_equal(AVSReadVoltage(AVS_VCORE_RAIL, &voltage), AVSOk);
+	zassert_equal(voltage, 720);
+
+	model.nacks = MODEL_MAX_RETRIES + 1;
+	zassert_equal(AVSReadVoltage(AVS_VCORE_RAIL, &voltage), AVSResourceUnavailable);
+	zassert_equal(voltage, 0xffff);
+
+	/* The readbacks of the failed command must all have been consumed */
+	zassert_equal(AVSReadVoltage(AVS_VCORE_RAIL, &voltage), AVSOk);
+	zassert_equal(voltage, 720);
+	zassert_equal(model.readback_count, 0);
+}
+
+ZTEST(avs, test_read_current_async)
+{
+	model.current = 5000;
+
+	zassert_ok(AVSReadCurrentAsync(AVS_VCORE_RAIL, current_callback, NULL));
+
+	/* Queuing the read does not wait for its readback */
+	zassert_equal(model.log_count, 1);
+	zassert_equal(AVS_CMD_CODE(model.log[0]), AVS_CODE_CURRENT);
+
+	zassert_ok(k_sem_take(&current_done, K_SECONDS(1)));
+	zassert_equal(current_status, AVSOk);
+	zassert_within(current_response * AVS_CURRENT_A_PER_LSB, 50.0f, 0.001f);
+
+	/* A failed read is reported with the error readback */
+	model.nacks = MODEL_MAX_RETRIES + 1;
+	zassert_ok(AVSReadCurrentAsync(AVS_VCORE_RAIL, current_callback, NULL));
+	zassert_ok(k_sem_take(&current_done, K_SECONDS(1)));
+	zassert_equal(current_status, AVSResourceUnavailable);
+	zassert_equal(current_response, 0xffff);
+
+	zassert_equal(AVSReadCurrentAsync(AVS_RAIL_BROADCAST, NULL, NULL), -EINVAL);
+}
+
+ZTEST(avs, test_queue_full)
+{
+	struct completion done = {0};
+	uint32_t queued = 0;
+
+	/* Hold commands in the controller so the queue backs up behind its command FIFO */
+	model.stalled = true;
+	while (AVSWriteVoltageAsync(700 + queued, AVS_VCORE_RAIL, record_completion, &done) == 0) {
+		queued++;
+	}
+	zassert_equal(queued, CONFIG_TT_BH_ARC_AVS_QUEUE_DEPTH);
+	zassert_equal(model.cmd_count, MODEL_CMD_FIFO_DEPTH);
+
+	model.stalled = false;
+	zassert_ok(AVSWaitSlew(AVS_VCORE_RAIL, K_SECONDS(1)));
+
+	zassert_equal(done.count, queued);
+	/* The model echoes the voltage written, so the responses show the completion order */
+	for (uint32_t i = 0; i < queued; i++) {
+		zassert_equal(done.responses[i], 700 + i, "completion %u out of order", i);
+	}
+	zassert_equal(model.voltage[AVS_VCORE_RAIL], 700 + queued - 1);
+}
+
+ZTEST(avs, test_sync_timeout)
+{
+	uint16_t voltage;
+
+	model.voltage[AVS_VCORE_RAIL] = 730;
+
+	/* A controller that never returns a readback does not hang the caller */
+	model.stalled = true;
+	zassert_equal(AVSReadVoltage(AVS_VCORE_RAIL, &voltage), AVSTimeout);
+	zassert_equal(voltage, 0xffff);
+
+	/* The abandoned command still completes in order, without touching the caller */
+	model.stalled = false;
+	zassert_equal(AVSReadVoltage(AVS_VCORE_RAIL, &voltage), AVSOk);
+	zassert_equal(voltage, 730);
+	zassert_equal(model.readback_count, 0);
+}
+
+static void avs_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&model, 0, sizeof(model));
+	k_sem_reset(&current_done);
+	ReadReg_fake.custom_fake = model_read;
+	WriteReg_fake.custom_fake = model_write;
+}
+
+ZTEST_SUITE(avs, NULL, NULL, avs_before, NULL, NULL);
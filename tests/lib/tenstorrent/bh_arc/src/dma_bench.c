@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Runs the DMA benchmark over the PCIe HDMA, which the register fakes finish at the first poll
+ * after each doorbell. The ARC HS and NOC DMA engines are not built for native_sim.
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <tenstorrent/smc_msg.h>
+#include <tenstorrent/msgqueue.h>
+
+#include "dma_bench.h"
+#include "noc2axi.h"
+#include "pcie.h"
+#include "reg_mock.h"
+
+#define HDMA_DOORBELL_RDCH_0 0x00380104
+#define HDMA_CHANNEL_STRIDE  0x200
+
+static uint32_t doorbells;
+
+static void write_reg_count_doorbells(uint32_t addr, uint32_t value)
+{
+	for (int ch = 0; ch < CONFIG_TT_BH_ARC_PCIE_DMA_CHANNELS; ch++) {
+		if (addr == (uint32_t)GetTlbWindowAddr(0, PCIE_DBI_REG_TLB,
+						       HDMA_DOORBELL_RDCH_0 +
+							       ch * HDMA_CHANNEL_STRIDE)) {
+			doorbells++;
+		}
+	}
+}
+
+ZTEST(dma_bench, test_pcie_run)
+{
+	DmaBenchParams params = {
+		.engine = DmaBenchPcieHostToChip,
+		.transfer_size = 65536,
+		.iterations = 32,
+	};
+	DmaBenchResult result;
+
+	WriteReg_fake.custom_fake = write_reg_count_doorbells;
+
+	zassert_ok(DmaBenchRun(&params, &result));
+	zassert_equal(doorbells, params.iterations);
+
+	zassert_true(result.mb_per_s > 0);
+	zassert_true(result.wall_us > 0);
+	zassert_true(result.cpu_us <= result.wall_us);
+	zassert_true(result.p50_ns <= result.p90_ns);
+	zassert_true(result.p90_ns <= result.p99_ns);
+	zassert_true(result.p99_ns <= result.max_ns);
+	/* Transfers run one at a time, so none takes longer than the whole run */
+	zassert_true(result.max_ns <= result.wall_us * 1000ULL);
+
+	TC_PRINT("pcie_h2c: %u MB/s, p50 %u ns p99 %u ns, run %u us cpu %u us\n",
+		 result.mb_per_s, result.p50_ns, result.p99_ns, result.wall_us, result.cpu_us);
+}
+
+ZTEST(dma_bench, test_invalid)
+{
+	DmaBenchParams params = {
+		.engine = DmaBenchPcieChipToHost,
+		.transfer_size = 4096,
+		.iterations = 0,
+	};
+	DmaBenchResult result;
+
+	zassert_equal(DmaBenchRun(&params, &result), -EINVAL);
+
+	params.iterations = CONFIG_TT_BH_ARC_DMA_BENCH_MAX_ITERATIONS + 1;
+	zassert_equal(DmaBenchRun(&params, &result), -EINVAL);
+
+	params.iterations = 1;
+	params.engine = DmaBenchArc;
+	zassert_equal(DmaBenchRun(&params, &result), -ENODEV);
+
+	params.engine = DmaBenchNumEngines;
+	zassert_equal(DmaBenchRun(&params, &result), -ENODEV);
+}
+
+ZTEST(dma_bench, test_message)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	req.dma_bench.command_code = TT_SMC_MSG_DMA_BENCH;
+	req.dma_bench.engine = DmaBenchPcieChipToHost;
+	req.dma_bench.iterations = 8;
+	req.dma_bench.transfer_size = 4096;
+
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	/* The run finishes on the deferred work queue */
+	k_sleep(K_MSEC(100));
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], 0);
+	zassert_true(rsp.data[2] > 0, "no run time");
+	zassert_true(rsp.data[3] <= rsp.data[2], "CPU time exceeds run time");
+	zassert_true(rsp.data[4] <= rsp.data[7], "median latency exceeds maximum");
+
+	/* Bad parameters are refused without deferring */
+	req.dma_bench.iterations = 0;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], EINVAL);
+}
+
+static void dma_bench_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	doorbells = 0;
+}
+
+ZTEST_SUITE(dma_bench, NULL, NULL, dma_bench_before, NULL, NULL);
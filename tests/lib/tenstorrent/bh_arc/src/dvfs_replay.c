@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replays recorded power, current and temperature traces through the DVFS throttlers and
+ * arbiters, one DVFS tick at a time, at a fixed or an adaptive DVFS period. The AICLK and voltage
+ * targets are never applied, so nothing touches the PLLs or regulators. Whenever either target
+ * changes, a CSV line "<trace>,<time_ms>,<aiclk_mhz>,<voltage_mv>" is printed. Each trace ends
+ * with a summary of the settling time and the host cycles spent per tick.
+ *
+ * Traces live in traces/ and are embedded at build time. Each non-comment line after the
+ * header is "time_ms,vcore_power,vcore_current,asic_temperature,board_power,gddr_temperature",
+ * and holds until the next timestamp. The last line only marks the end of the trace.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/misc/bh_fwtable.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "aiclk_ppm.h"
+#include "dvfs.h"
+#include "throttler.h"
+#include "vf_curve.h"
+#include "voltage.h"
+
+#define REPLAY_MAX_SAMPLES 64
+#define REPLAY_MAX_TICKS   8192
+
+/* AICLK is settled once it stays within 1% of its final value */
+#define REPLAY_SETTLE_PERMILLE 10
+
+static const char tdp_step_csv[] = {
+#include "tdp_step.csv.inc"
+	0,
+};
+
+static const char doppler_board_power_csv[] = {
+#include "doppler_board_power.csv.inc"
+	0,
+};
+
+struct replay_sample {
+	uint32_t time_ms;
+	ThrottlerInputs inputs;
+};
+
+struct replay_result {
+	uint32_t ticks;
+	uint32_t min_aiclk;
+	uint32_t final_aiclk;
+	uint32_t settle_ms;   /* After the last change of the inputs */
+	uint32_t response_us; /* From the first change of the inputs to the first AICLK drop */
+	uint64_t avg_cycles;
+	uint64_t max_cycles;
+	uint64_t cycles_per_ms; /* Averaged over the whole trace */
+};
+
+struct replay_tick {
+	uint32_t time_us;
+	uint16_t aiclk;
+};
+
+extern void InitAiclkPPMState(uint32_t boot_freq);
+
+static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
+
+static FwTable saved_fw_table;
+static struct replay_sample samples[REPLAY_MAX_SAMPLES];
+static struct replay_tick aiclk_timeline[REPLAY_MAX_TICKS];
+
+static inline uint64_t replay_cycles(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+	/* Simulated time does not advance while the loop runs, so use the host TSC */
+	return __builtin_ia32_rdtsc();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static bool parse_field(const char **cursor, float *value)
+{
+	char *end;
+
+	*value = strtof(*cursor, &end);
+	if (end == *cursor || (*end != ',' && *end != '\n' && *end != '\0')) {
+		return false;
+	}
+
+	*cursor = *end == ',' ? end + 1 : end;
+	return true;
+}
+
+static void parse_trace(const char *csv, size_t *count)
+{
+	const char *line = csv;
+
+	*count = 0;
+	while (line != NULL && *line != '\0') {
+		float fields[6];
+		const char *cursor = line;
+		bool valid = true;
+
+		for (size_t i = 0; i < ARRAY_SIZE(fields) && valid; i++) {
+			valid = parse_field(&cursor, &fields[i]);
+		}
+
+		/* Comments and the header line do not parse as numbers */
+		if (valid) {
+			zassert_true(*count < REPLAY_MAX_SAMPLES, "trace too long");
+			zassert_true(*count == 0 || fields[0] >= samples[*count - 1].time_ms,
+				     "timestamps out of order");
+
+			samples[(*count)++] = (struct replay_sample){
+				.time_ms = fields[0],
+				.inputs = {
+					.vcore_power = fields[1],
+					.vcore_current = fields[2],
+					.asic_temperature = fields[3],
+					.input_power = fields[4],
+					.gddr_temperature = fields[5],
+				},
+			};
+		}
+
+		line = strchr(line, '\n');
+		if (line != NULL) {
+			line++;
+		}
+	}
+
+	zassert_true(*count >= 2, "a trace needs at least a start and an end");
+}
+
+/* Bring the DVFS state up the way InitDVFS does, from limits that would come from the FW table
+ * in SPI on hardware. A period of zero lets it adapt to the load.
+ */
+static void replay_init(bool doppler, uint16_t board_power_limit, uint32_t period_us)
+{
+	/* There is no SPI filesystem to load the FW table from on native_sim */
+	FwTable *fw_table = (FwTable *)tt_bh_fwtable_get_fw_table(fwtable_dev);
+	uint8_t power_limit[2];
+
+	fw_table->chip_limits = (FwTable_ChipLimits){
+		.asic_fmax = 1400,
+		.asic_fmin = 200,
+		.tdp_limit = 100,
+		.tdc_limit = 160,
+		.tdc_fast_limit = 200,
+		.thm_limit = 90,
+		.gddr_thm_limit = 85,
+		.board_power_limit = 600,
+	};
+	fw_table->feature_enable.doppler_en = doppler;
+
+	voltage_arbiter = (VoltageArbiter){
+		.vdd_min = 700,
+		.vdd_max = 900,
+		.curr_voltage = 750,
+		.targ_voltage = 750,
+		.req_voltage = {700, 700},
+	};
+
+	InitAiclkPPMState(800);
+	InitVFCurve();
+	InitArbMaxVoltage();
+	InitThrottlers();
+	InitDVFSPeriod();
+	zassert_ok(SetDVFSPeriod(period_us));
+	aiclk_set_busy(true);
+
+	sys_put_le16(board_power_limit, power_limit);
+	Dm2CmSetBoardPowerLimit(power_limit, sizeof(power_limit));
+}
+
+static void replay(const char *name, const char *csv, struct replay_result *result)
+{
+	size_t count;
+
+	parse_trace(csv, &count);
+
+	uint32_t end_us = samples[count - 1].time_ms * USEC_PER_MSEC;
+	uint32_t first_change_us = samples[1].time_ms * USEC_PER_MSEC;
+	uint32_t last_change_us = 0;
+	uint32_t prev_aiclk = 0;
+	uint32_t prev_voltage = 0;
+	uint64_t total_cycles = 0;
+	uint32_t time_us = 0;
+	size_t row = 0;
+
+	*result = (struct replay_result){.min_aiclk = UINT32_MAX, .response_us = UINT32_MAX};
+
+	while (time_us <= end_us) {
+		zassert_true(result->ticks < REPLAY_MAX_TICKS, "trace too long");
+
+		while (row + 2 < count && samples[row + 1].time_ms * USEC_PER_MSEC <= time_us) {
+			row++;
+			last_change_us = samples[row].time_ms * USEC_PER_MSEC;
+		}
+
+		uint64_t start = replay_cycles();
+
+		uint32_t period_us = DVFSStep(&samples[row].inputs);
+
+		uint64_t cycles = replay_cycles() - start;
+		uint32_t aiclk = GetAiclkTarg();
+		uint32_t voltage = voltage_arbiter.targ_voltage;
+
+		if (result->response_us == UINT32_MAX && time_us >= first_change_us &&
+		    aiclk < prev_aiclk) {
+			result->response_us = time_us - first_change_us;
+		}
+
+		if (aiclk != prev_aiclk || voltage != prev_voltage) {
+			TC_PRINT("%s,%u.%03u,%u,%u\n", name, time_us / USEC_PER_MSEC,
+				 time_us % USEC_PER_MSEC, aiclk, voltage);
+			prev_aiclk = aiclk;
+			prev_voltage = voltage;
+		}
+
+		aiclk_timeline[result->ticks++] = (struct replay_tick){time_us, aiclk};
+		result->min_aiclk = MIN(result->min_aiclk, aiclk);
+		result->max_cycles = MAX(result->max_cycles, cycles);
+		total_cycles += cycles;
+		time_us += period_us;
+	}
+
+	result->final_aiclk = prev_aiclk;
+	result->avg_cycles = total_cycles / result->ticks;
+	result->cycles_per_ms = total_cycles * USEC_PER_MSEC / MAX(end_us, 1);
+
+	int32_t tolerance = result->final_aiclk * REPLAY_SETTLE_PERMILLE / 1000;
+	uint32_t settled_tick = result->ticks;
+
+	while (settled_tick > 0 && aiclk_timeline[settled_tick - 1].time_us >= last_change_us &&
+	       abs((int32_t)aiclk_timeline[settled_tick - 1].aiclk -
+		   (int32_t)result->final_aiclk) <= tolerance) {
+		settled_tick--;
+	}
+
+	uint32_t settled_us =
+		settled_tick < result->ticks ? aiclk_timeline[settled_tick].time_us : time_us;
+
+	result->settle_ms = (settled_us - last_change_us) / USEC_PER_MSEC;
+
+	TC_PRINT("%s: %u ticks, settled in %u ms at %u MHz, %u cycles/tick avg, %u max\n", name,
+		 result->ticks, result->settle_ms, result->final_aiclk,
+		 (uint32_t)result->avg_cycles, (uint32_t)result->max_cycles);
+}
+
+ZTEST(dvfs_replay, test_tdp_step)
+{
+	struct replay_result result;
+
+	replay_init(false, 300, 1000);
+	replay("tdp_step", tdp_step_csv, &result);
+
+	/* 150 W against a 100 W TDP limit drives AICLK to fmin, and it recovers afterwards */
+	zassert_equal(result.min_aiclk, GetAiclkFmin());
+	zassert_equal(result.final_aiclk, GetAiclkFmax());
+	zassert_true(result.settle_ms < 200, "took %u ms to settle", result.settle_ms);
+}
+
+ZTEST(dvfs_replay, test_doppler_board_power)
+{
+	struct replay_result result;
+
+	replay_init(true, 150, 1000);
+	replay("doppler_board_power", doppler_board_power_csv, &result);
+
+	/* The 320 W burst trips the critical throttler, which pins AICLK to fmin */
+	zassert_equal(result.min_aiclk, GetAiclkFmin());
+	zassert_true(result.final_aiclk > GetAiclkFmin());
+}
+
+ZTEST(dvfs_replay, test_period_sweep)
+{
+	static const uint32_t periods_us[] = {250, 1000, 4000, 0};
+	struct replay_result result[ARRAY_SIZE(periods_us)];
+	struct replay_result *nominal = &result[1];
+	struct replay_result *adaptive = &result[3];
+	/* The TDP step crosses the limit 2 ms after the first change of the inputs */
+	const uint32_t crossing_us = 2000;
+
+	for (size_t i = 0; i < ARRAY_SIZE(periods_us); i++) {
+		char name[32];
+
+		snprintk(name, sizeof(name), "tdp_step@%uus", periods_us[i]);
+		replay_init(false, 300, periods_us[i]);
+		replay(name, tdp_step_csv, &result[i]);
+
+		TC_PRINT("%s: throttled %u us after the load step, %u ticks, %u cycles/ms\n", name,
+			 result[i].response_us, result[i].ticks, (uint32_t)result[i].cycles_per_ms);
+
+		zassert_equal(result[i].min_aiclk, GetAiclkFmin());
+		zassert_equal(result[i].final_aiclk, GetAiclkFmax());
+		if (periods_us[i] != 0) {
+			zassert_true(result[i].response_us <= crossing_us + periods_us[i],
+				     "%s: throttled after %u us", name, result[i].response_us);
+		}
+	}
+
+	/* Idling at a long period delays the first throttling tick by at most one long period, and
+	 * the quiet stretches of the trace cost fewer ticks than the nominal period does
+	 */
+	zassert_true(adaptive->response_us <= crossing_us + CONFIG_TT_BH_ARC_DVFS_PERIOD_MAX_US,
+		     "throttled after %u us", adaptive->response_us);
+	zassert_true(adaptive->ticks < nominal->ticks, "%u ticks vs %u at the nominal period",
+		     adaptive->ticks, nominal->ticks);
+}
+
+static void *dvfs_replay_setup(void)
+{
+	saved_fw_table = *tt_bh_fwtable_get_fw_table(fwtable_dev);
+
+	return NULL;
+}
+
+static void dvfs_replay_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	*(FwTable *)tt_bh_fwtable_get_fw_table(fwtable_dev) = saved_fw_table;
+}
+
+ZTEST_SUITE(dvfs_replay, NULL, dvfs_replay_setup, NULL, NULL, dvfs_replay_teardown);
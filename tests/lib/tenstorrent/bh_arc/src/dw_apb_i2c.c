@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Runs PMBus-sized transfers on I2C master 1 against a register model of the DesignWare
+ * controller, once polled and once from interrupts, and reports the register accesses each
+ * takes. Every register access costs an APB round trip on the ARC, so the count is the CPU cost
+ * of a transaction.
+ *
+ * When polled, the model moves one byte over the bus every MODEL_STATUS_READS_PER_BYTE status
+ * reads, about one byte time at 400 kHz on an 800 MHz ARC. From interrupts, a timer moves one
+ * byte per expiry and raises the interrupt while any unmasked source is pending.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "dw_apb_i2c.h"
+#include "reg_mock.h"
+
+#define I2C_ID   1
+#define I2C_BASE 0x80090000
+
+#define IC_DATA_CMD       (I2C_BASE + 0x10)
+#define IC_INTR_STAT      (I2C_BASE + 0x2C)
+#define IC_INTR_MASK      (I2C_BASE + 0x30)
+#define IC_RAW_INTR_STAT  (I2C_BASE + 0x34)
+#define IC_RX_TL          (I2C_BASE + 0x38)
+#define IC_CLR_INTR       (I2C_BASE + 0x40)
+#define IC_CLR_TX_ABRT    (I2C_BASE + 0x54)
+#define IC_CLR_STOP_DET   (I2C_BASE + 0x60)
+#define IC_STATUS         (I2C_BASE + 0x70)
+#define IC_TXFLR          (I2C_BASE + 0x74)
+#define IC_RXFLR          (I2C_BASE + 0x78)
+#define IC_TX_ABRT_SOURCE (I2C_BASE + 0x80)
+#define IC_COMP_PARAM_1   (I2C_BASE + 0xF4)
+
+#define RESET_UNIT_REFCLK_CNT_LO_REG_ADDR 0x800300E0
+
+#define IC_DATA_CMD_READ BIT(8)
+#define IC_DATA_CMD_STOP BIT(9)
+
+#define IC_STATUS_TFNF         BIT(1)
+#define IC_STATUS_TFE          BIT(2)
+#define IC_STATUS_RFNE         BIT(3)
+#define IC_STATUS_MST_ACTIVITY BIT(5)
+
+#define IC_INTR_RX_FULL  BIT(2)
+#define IC_INTR_TX_EMPTY BIT(4)
+#define IC_INTR_TX_ABRT  BIT(6)
+#define IC_INTR_STOP_DET BIT(9)
+
+#define IC_ABRT_7B_ADDR_NOACK BIT(0)
+#define IC_ABRT_BUSY          BIT(23)
+
+#define MODEL_FIFO_DEPTH            8
+#define MODEL_STATUS_READS_PER_BYTE 100
+#define MODEL_BYTE_TIME_US          25
+
+/* PMBus READ_IOUT */
+#define PMBUS_READ_IOUT 0x8C
+
+extern bool i2c_irq_enabled[];
+extern void I2CServiceTransfer(uint32_t id);
+
+static struct {
+	uint32_t tx_fifo[MODEL_FIFO_DEPTH];
+	uint32_t tx_count;
+	uint8_t rx_fifo[MODEL_FIFO_DEPTH];
+	uint32_t rx_count;
+	uint32_t raw_intr; /* Latched STOP_DET and TX_ABRT */
+	uint32_t intr_mask;
+	uint32_t rx_tl;
+	uint32_t abrt_source;
+	uint32_t status_reads;
+	uint32_t refclk;
+	bool nack;
+
+	/* Target side: reads return command, command + 1, ... The bytes written by the last
+	 * transfer are kept in written.
+	 */
+	bool in_transfer;
+	uint8_t command;
+	uint32_t bytes_in_transfer;
+	uint8_t written[MODEL_FIFO_DEPTH * 4];
+	uint32_t written_len;
+
+	uint32_t interrupts;
+} model;
+
+static void model_fifo_pop(void)
+{
+	model.tx_count--;
+	memmove(&model.tx_fifo[0], &model.tx_fifo[1], model.tx_count * sizeof(model.tx_fifo[0]));
+}
+
+/* Move the command at the head of the TX FIFO over the bus */
+static void model_bus_step(void)
+{
+	if (model.tx_count == 0) {
+		return;
+	}
+
+	if (model.nack) {
+		model.tx_count = 0;
+		model.in_transfer = false;
+		model.abrt_source = IC_ABRT_7B_ADDR_NOACK;
+		model.raw_intr |= IC_INTR_TX_ABRT | IC_INTR_STOP_DET;
+		return;
+	}
+
+	uint32_t cmd = model.tx_fifo[0];
+
+	model_fifo_pop();
+
+	if (cmd & IC_DATA_CMD_READ) {
+		zassert_true(model.rx_count < MODEL_FIFO_DEPTH, "RX FIFO overflow");
+		model.rx_fifo[model.rx_count++] = model.command + model.bytes_in_transfer;
+		model.bytes_in_transfer++;
+	} else {
+		if (!model.in_transfer) {
+			model.command = cmd;
+			model.written_len = 0;
+		}
+		model.written[model.written_len++] = cmd;
+	}
+
+	model.in_transfer = !(cmd & IC_DATA_CMD_STOP);
+	if (cmd & IC_DATA_CMD_STOP) {
+		model.raw_intr |= IC_INTR_STOP_DET;
+		model.bytes_in_transfer = 0;
+	}
+}
+
+static uint32_t model_raw_intr(void)
+{
+	uint32_t raw_intr = model.raw_intr;
+
+	if (model.tx_count == 0) {
+		raw_intr |= IC_INTR_TX_EMPTY;
+	}
+	if (model.rx_count > model.rx_tl) {
+		raw_intr |= IC_INTR_RX_FULL;
+	}
+
+	return raw_intr;
+}
+
+static uint32_t model_read(uint32_t addr)
+{
+	uint32_t val;
+
+	switch (addr) {
+	case IC_STATUS:
+		if (!i2c_irq_enabled[I2C_ID] &&
+		    ++model.status_reads % MODEL_STATUS_READS_PER_BYTE == 0) {
+			model_bus_step();
+		}
+		return (model.tx_count < MODEL_FIFO_DEPTH ? IC_STATUS_TFNF : 0) |
+		       (model.tx_count == 0 ? IC_STATUS_TFE : 0) |
+		       (model.rx_count > 0 ? IC_STATUS_RFNE : 0) |
+		       (model.tx_count > 0 ? IC_STATUS_MST_ACTIVITY : 0);
+	case IC_DATA_CMD:
+		zassert_true(model.rx_count > 0, "RX FIFO underflow");
+		val = model.rx_fifo[0];
+		model.rx_count--;
+		memmove(&model.rx_fifo[0], &model.rx_fifo[1], model.rx_count);
+		return val;
+	case IC_INTR_STAT:
+		return model_raw_intr() & model.intr_mask;
+	case IC_RAW_INTR_STAT:
+		return model_raw_intr();
+	case IC_TX_ABRT_SOURCE:
+		return model.abrt_source;
+	case IC_CLR_TX_ABRT:
+		model.abrt_source = 0;
+		model.raw_intr &= ~IC_INTR_TX_ABRT;
+		return 0;
+	case IC_CLR_STOP_DET:
+		model.raw_intr &= ~IC_INTR_STOP_DET;
+		return 0;
+	case IC_CLR_INTR:
+		model.abrt_source = 0;
+		model.raw_intr = 0;
+		return 0;
+	case IC_TXFLR:
+		return model.tx_count;
+	case IC_RXFLR:
+		return model.rx_count;
+	case IC_COMP_PARAM_1:
+		return ((MODEL_FIFO_DEPTH - 1) << 16) | ((MODEL_FIFO_DEPTH - 1) << 8);
+	case RESET_UNIT_REFCLK_CNT_LO_REG_ADDR:
+		return ++model.refclk;
+	default:
+		return 0;
+	}
+}
+
+static void model_write(uint32_t addr, uint32_t val)
+{
+	switch (addr) {
+	case IC_DATA_CMD:
+		zassert_true(model.tx_count < MODEL_FIFO_DEPTH, "TX FIFO overflow");
+		model.tx_fifo[model.tx_count++] = val;
+		break;
+	case IC_INTR_MASK:
+		model.intr_mask = val;
+		break;
+	case IC_RX_TL:
+		model.rx_tl = val;
+		break;
+	default:
+		break;
+	}
+}
+
+static void model_bus_tick(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	model_bus_step();
+
+	/* Level-triggered: keep interrupting while an unmasked source is pending */
+	for (int i = 0; i < 4 && (model_raw_intr() & model.intr_mask) != 0; i++) {
+		model.interrupts++;
+		I2CServiceTransfer(I2C_ID);
+	}
+}
+
+static K_TIMER_DEFINE(model_bus_timer, model_bus_tick, NULL);
+
+static void use_interrupts(bool enable)
+{
+	i2c_irq_enabled[I2C_ID] = enable;
+	if (enable) {
+		k_timer_start(&model_bus_timer, K_USEC(MODEL_BYTE_TIME_US),
+			      K_USEC(MODEL_BYTE_TIME_US));
+	} else {
+		k_timer_stop(&model_bus_timer);
+	}
+}
+
+static uint32_t reg_accesses(void)
+{
+	return ReadReg_fake.call_count + WriteReg_fake.call_count;
+}
+
+/* Returns the register accesses a PMBus READ_IOUT takes */
+static uint32_t read_iout(void)
+{
+	uint32_t start = reg_accesses();
+	uint8_t iout[2] = {0};
+
+	zassert_ok(I2CReadBytes(I2C_ID, PMBUS_READ_IOUT, 1, iout, sizeof(iout), 0));
+	zassert_equal(iout[0], PMBUS_READ_IOUT);
+	zassert_equal(iout[1], PMBUS_READ_IOUT + 1);
+
+	return reg_accesses() - start;
+}
+
+ZTEST(dw_apb_i2c, test_pmbus_read_cpu_cost)
+{
+	uint32_t polled = read_iout();
+
+	use_interrupts(true);
+	model.interrupts = 0;
+
+	uint32_t irq = read_iout();
+
+	TC_PRINT("READ_IOUT: %u register accesses polled, %u from %u interrupts\n", polled, irq,
+		 model.interrupts);
+
+	zassert_true(irq * 10 < polled, "%u accesses from interrupts, %u polled", irq, polled);
+	zassert_true(model.interrupts <= 6, "%u interrupts", model.interrupts);
+}
+
+ZTEST(dw_apb_i2c, test_pmbus_write)
+{
+	const uint8_t vout[] = {0x34, 0x12};
+
+	use_interrupts(true);
+
+	zassert_ok(I2CWriteBytes(I2C_ID, 0x21, 1, vout, sizeof(vout)));
+	zassert_equal(model.written_len, 3);
+	zassert_equal(model.written[0], 0x21);
+	zassert_mem_equal(&model.written[1], vout, sizeof(vout));
+	zassert_equal(model.tx_count, 0);
+}
+
+/* Longer than the FIFOs, so the transfer has to be refilled and drained as it goes */
+ZTEST(dw_apb_i2c, test_long_read)
+{
+	uint8_t command = 0x10;
+	uint8_t data[3 * MODEL_FIFO_DEPTH];
+
+	use_interrupts(true);
+
+	zassert_ok(I2CTransaction(I2C_ID, &command, 1, data, sizeof(data)));
+	for (size_t i = 0; i < sizeof(data); i++) {
+		zassert_equal(data[i], command + i, "byte %zu", i);
+	}
+}
+
+struct async_result {
+	struct k_sem done;
+	uint32_t ic_error;
+};
+
+static void async_done(uint32_t id, uint32_t ic_error, void *user_data)
+{
+	struct async_result *result = user_data;
+
+	zassert_equal(id, I2C_ID);
+	result->ic_error = ic_error;
+	k_sem_give(&result->done);
+}
+
+ZTEST(dw_apb_i2c, test_async_transaction)
+{
+	struct async_result result;
+	uint8_t command = PMBUS_READ_IOUT;
+	uint8_t iout[2];
+
+	k_sem_init(&result.done, 0, 1);
+	use_interrupts(true);
+
+	zassert_ok(I2CTransactionAsync(I2C_ID, &command, 1, iout, sizeof(iout), async_done,
+				       &result));
+	zassert_equal(I2CTransactionAsync(I2C_ID, &command, 1, iout, sizeof(iout), async_done,
+					  &result),
+		      -EBUSY);
+
+	/* A blocking transaction reports the controller being busy as an abort */
+	uint8_t other[2];
+
+	zassert_equal(I2CReadBytes(I2C_ID, PMBUS_READ_IOUT, 1, other, sizeof(other), 0),
+		      IC_ABRT_BUSY);
+
+	zassert_ok(k_sem_take(&result.done, K_MSEC(10)));
+	zassert_ok(result.ic_error);
+	zassert_equal(iout[0], PMBUS_READ_IOUT);
+	zassert_equal(iout[1], PMBUS_READ_IOUT + 1);
+}
+
+ZTEST(dw_apb_i2c, test_nack)
+{
+	uint8_t iout[2];
+
+	use_interrupts(true);
+	model.nack = true;
+
+	zassert_equal(I2CReadBytes(I2C_ID, PMBUS_READ_IOUT, 1, iout, sizeof(iout), 0),
+		      IC_ABRT_7B_ADDR_NOACK);
+
+	/* The controller is usable again afterwards */
+	model.nack = false;
+	read_iout();
+}
+
+static void read_batch(void)
+{
+	const uint8_t commands[] = {0x8C, 0x96, 0x8B};
+	uint8_t data[2 * ARRAY_SIZE(commands)];
+
+	zassert_ok(I2CReadBytesBatch(I2C_ID, commands, ARRAY_SIZE(commands), data, 2));
+	for (size_t i = 0; i < ARRAY_SIZE(commands); i++) {
+		zassert_equal(data[2 * i], commands[i]);
+		zassert_equal(data[2 * i + 1], commands[i] + 1);
+	}
+}
+
+ZTEST(dw_apb_i2c, test_read_batch)
+{
+	read_batch();
+
+	use_interrupts(true);
+	read_batch();
+}
+
+ZTEST(dw_apb_i2c, test_init_cached)
+{
+	uint32_t start = reg_accesses();
+
+	/* Already set up for this target by the test setup */
+	I2CInit(I2CMst, 0x64, I2CFastMode, I2C_ID);
+	zassert_equal(reg_accesses(), start);
+
+	I2CInit(I2CMst, 0x65, I2CFastMode, I2C_ID);
+	zassert_true(reg_accesses() > start);
+
+	start = reg_accesses();
+	I2CInit(I2CMst, 0x65, I2CFastMode, I2C_ID);
+	zassert_equal(reg_accesses(), start);
+
+	/* A reset loses the configuration */
+	I2CReset();
+	start = reg_accesses();
+	I2CInit(I2CMst, 0x65, I2CFastMode, I2C_ID);
+	zassert_true(reg_accesses() > start);
+}
+
+static void dw_apb_i2c_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&model, 0, sizeof(model));
+	ReadReg_fake.custom_fake = model_read;
+	WriteReg_fake.custom_fake = model_write;
+
+	I2CInit(I2CMst, 0x64, I2CFastMode, I2C_ID);
+}
+
+static void dw_apb_i2c_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	use_interrupts(false);
+}
+
+ZTEST_SUITE(dw_apb_i2c, NULL, NULL, dw_apb_i2c_before, dw_apb_i2c_after, NULL);
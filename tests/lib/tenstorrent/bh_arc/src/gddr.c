@@ -4,23 +4,30 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stddef.h>
+
 #include <zephyr/ztest.h>
 #include <zephyr/fff.h>
 
 #include <zephyr/drivers/i2c.h>
 
 #include "gddr.h"
+#include "noc.h"
 #include "noc2axi.h"
 #include "reg_mock.h"
-static const uint32_t mrisc_tlb = 13U;
-static const uint32_t mrisc_msg_reg = ARC_NOC0_BASE_ADDR + (mrisc_tlb << NOC_TLB_LOG_SIZE) +
-				      (MRISC_MSG_REGISTER & NOC_TLB_WINDOW_ADDR_MASK);
+
+/* The MRISC message register, through whichever NOC0 TLB entry the allocator picked */
+static bool is_mrisc_msg_reg(uint32_t addr)
+{
+	return addr >= ARC_NOC0_BASE_ADDR && addr < ARC_NOC1_BASE_ADDR &&
+	       (addr & NOC_TLB_WINDOW_ADDR_MASK) == (MRISC_MSG_REGISTER & NOC_TLB_WINDOW_ADDR_MASK);
+}
 
 static uint32_t num_mrisc_msgs;
 static uint32_t mrisc_msgs[NUM_GDDR];
 uint32_t read_reg_fake_mrisc_busy(uint32_t addr)
 {
-	if (addr == mrisc_msg_reg) {
+	if (is_mrisc_msg_reg(addr)) {
 		return MRISC_MSG_TYPE_PHY_POWERDOWN;
 	}
 
@@ -29,7 +36,7 @@ uint32_t read_reg_fake_mrisc_busy(uint32_t addr)
 
 uint32_t read_reg_fake_mrisc_timed_out(uint32_t addr)
 {
-	if (addr == mrisc_msg_reg) {
+	if (is_mrisc_msg_reg(addr)) {
 		static uint32_t mrisc_msg_read_call_count;
 
 		if (mrisc_msg_read_call_count < NUM_GDDR) {
@@ -45,7 +52,7 @@ uint32_t read_reg_fake_mrisc_timed_out(uint32_t addr)
 
 void write_reg_fake_count_mrisc_msgs(uint32_t addr, uint32_t value)
 {
-	if (addr == mrisc_msg_reg) {
+	if (is_mrisc_msg_reg(addr)) {
 		if (num_mrisc_msgs < NUM_GDDR) {
 			mrisc_msgs[num_mrisc_msgs] = value;
 		}
@@ -97,4 +104,56 @@ ZTEST(gddr, test_mrisc_power_off)
 	num_mrisc_msgs = 0U;
 }
 
+#define MRISC_L1_ADDR (1ULL << 37)
+
+/* GDDR instances with a valid telemetry table */
+static const uint8_t gddr_telemetry_inst[] = {0, 2};
+
+uint32_t read_reg_fake_gddr_telemetry(uint32_t addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(gddr_telemetry_inst); i++) {
+		uint8_t x, y;
+
+		/* The MRISC L1 of the instance is mapped for as long as the batch read runs */
+		GetGddrNocCoords(gddr_telemetry_inst[i], 0, 0, &x, &y);
+		int tlb = NOC2AXITlbLookup(0, x, y, MRISC_L1_ADDR);
+
+		if (tlb < 0) {
+			continue;
+		}
+
+		uint32_t table =
+			ARC_NOC0_BASE_ADDR + (tlb << NOC_TLB_LOG_SIZE) + GDDR_TELEMETRY_TABLE_ADDR;
+
+		if (addr == table) {
+			return GDDR_TELEMETRY_TABLE_T_VERSION;
+		}
+		if (addr == table + offsetof(gddr_telemetry_table_t, dram_speed)) {
+			return 16000;
+		}
+	}
+
+	return 0;
+}
+
+ZTEST(gddr, test_read_gddr_telemetry_tables)
+{
+	gddr_telemetry_table_t tables[NUM_GDDR] = {0};
+
+	ReadReg_fake.custom_fake = read_reg_fake_gddr_telemetry;
+
+	/* Without ARC DMA every instance is read through its own TLB window */
+	zassert_equal(read_gddr_telemetry_tables(0x0F, tables), BIT(0) | BIT(2));
+	zassert_equal(tables[0].dram_speed, 16000);
+	zassert_equal(tables[2].dram_speed, 16000);
+	zassert_equal(tables[1].telemetry_table_version, 0);
+
+	/* Instances outside the mask are left alone */
+	tables[4].dram_speed = 1;
+	zassert_equal(read_gddr_telemetry_tables(0, tables), 0);
+	zassert_equal(tables[4].dram_speed, 1);
+
+	ReadReg_fake.custom_fake = NULL;
+}
+
 ZTEST_SUITE(gddr, NULL, NULL, NULL, NULL, NULL);
@@ -14,6 +14,7 @@
 #include "clock_wave.h"
 #include "cm2dm_msg.h"
 #include "noc_init.h"
+#include "timer.h"
 
 #include "reg_mock.h"
 
@@ -245,6 +246,223 @@ ZTEST(msgqueue, test_msg_type_debug_noc_translation)
 	zassert_equal(rsp.data[0], 0); /*OK*/
 }
 
+/* Handler that takes 100 us of refclk time, landing in the [64, 128) us histogram bucket */
+#define SLOW_HANDLER_US     100
+#define SLOW_HANDLER_BUCKET 7
+
+static uint8_t msgqueue_handler_slow(const union request *req, struct response *rsp)
+{
+	ARG_UNUSED(req);
+	ARG_UNUSED(rsp);
+	timer_counter += SLOW_HANDLER_US * REFCLK_F_MHZ;
+	return 0;
+}
+
+ZTEST(msgqueue, test_msg_type_get_msg_stats)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	BUILD_ASSERT(SLOW_HANDLER_BUCKET < MIN(8, CONFIG_TT_BH_ARC_MSG_STATS_NUM_BUCKETS));
+	msgqueue_register_handler(0x73, msgqueue_handler_slow);
+
+	/* Read and clear, so that only the calls below are counted */
+	req.data[0] = TT_SMC_MSG_GET_MSG_STATS | (BIT(0) << 8U);
+	req.data[1] = 0x73;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], 0);
+	zassert_equal(rsp.data[3], CONFIG_TT_BH_ARC_MSG_STATS_NUM_BUCKETS);
+
+	req.data[0] = 0x73;
+	msgqueue_request_push(0, &req);
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+	msgqueue_response_pop(0, &rsp);
+
+	/* Read and clear */
+	req.data[0] = TT_SMC_MSG_GET_MSG_STATS | (BIT(0) << 8U);
+	req.data[1] = 0x73;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], 0);
+	zassert_equal(rsp.data[1], 2);
+	zassert_true(rsp.data[2] >= SLOW_HANDLER_US);
+
+	uint16_t buckets[8];
+
+	memcpy(buckets, &rsp.data[4], sizeof(buckets));
+	for (uint32_t i = 0; i < MIN(8, CONFIG_TT_BH_ARC_MSG_STATS_NUM_BUCKETS); i++) {
+		zassert_equal(buckets[i], i == SLOW_HANDLER_BUCKET ? 2 : 0, "bucket %u", i);
+	}
+
+	req.data[0] = TT_SMC_MSG_GET_MSG_STATS;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[1], 0);
+
+	/* Out of range message code */
+	req.data[1] = CONFIG_TT_BH_ARC_NUM_MSG_CODES;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], EINVAL);
+}
+
+#define DEFERRED_MSG_CODE 0x75
+#define COUNTED_MSG_CODE  0x76
+
+static struct msgqueue_deferred_response deferred_rsp;
+static uint32_t counted_msgs;
+
+static uint8_t msgqueue_handler_deferred(const union request *req, struct response *rsp)
+{
+	zassert_equal(msgqueue_defer_response(&deferred_rsp), 0);
+	return 0;
+}
+
+static uint8_t msgqueue_handler_counted(const union request *req, struct response *rsp)
+{
+	counted_msgs++;
+	rsp->data[1] = req->data[1];
+	return 0;
+}
+
+ZTEST(msgqueue, test_msgqueue_deferred_response)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	msgqueue_register_handler(DEFERRED_MSG_CODE, msgqueue_handler_deferred);
+	msgqueue_register_handler(COUNTED_MSG_CODE, msgqueue_handler_counted);
+	counted_msgs = 0;
+
+	/* Deferring outside of a handler is rejected */
+	zassert_equal(msgqueue_defer_response(&deferred_rsp), -EINVAL);
+
+	req.data[0] = DEFERRED_MSG_CODE;
+	msgqueue_request_push(0, &req);
+	req.data[0] = COUNTED_MSG_CODE;
+	req.data[1] = 0;
+	msgqueue_request_push(0, &req);
+	req.data[1] = 1;
+	msgqueue_request_push(1, &req);
+	process_message_queues();
+
+	/* Queue 0 waits behind the deferred message, queue 1 is still serviced. */
+	zassert_equal(counted_msgs, 1);
+	msgqueue_response_pop(1, &rsp);
+	zassert_equal(rsp.data[0], 0);
+	zassert_equal(rsp.data[1], 1);
+
+	rsp = (struct response){0};
+	rsp.data[1] = 0xC0FFEE;
+	zassert_equal(msgqueue_complete_deferred_response(&deferred_rsp, 0, &rsp), 0);
+	zassert_equal(msgqueue_complete_deferred_response(&deferred_rsp, 0, &rsp), -EINVAL);
+
+	process_message_queues();
+	zassert_equal(counted_msgs, 2);
+
+	/* Responses come back in request order */
+	msgqueue_response_pop(0, &rsp);
+	zassert_equal(rsp.data[0], 0);
+	zassert_equal(rsp.data[1], 0xC0FFEE);
+	msgqueue_response_pop(0, &rsp);
+	zassert_equal(rsp.data[0], 0);
+	zassert_equal(rsp.data[1], 0);
+}
+
+#define CONTENTION_MSG_CODE 0x74
+#define CONTENTION_MSGS     (NUM_MSG_QUEUES * MSG_QUEUE_SIZE)
+
+static uint32_t contention_log[CONTENTION_MSGS];
+static uint32_t contention_cycles[CONTENTION_MSGS];
+static uint32_t contention_count;
+
+static uint8_t msgqueue_handler_contention(const union request *req, struct response *rsp)
+{
+	if (contention_count < CONTENTION_MSGS) {
+		contention_cycles[contention_count] = k_cycle_get_32();
+		contention_log[contention_count++] = req->data[1];
+	}
+	rsp->data[1] = req->data[1];
+	return 0;
+}
+
+ZTEST(msgqueue, test_msgqueue_round_robin_contention)
+{
+	union request req = {0};
+	struct response rsp = {0};
+	uint32_t first_service[NUM_MSG_QUEUES];
+	uint64_t total_wait[NUM_MSG_QUEUES] = {0};
+	uint32_t served[NUM_MSG_QUEUES] = {0};
+	uint32_t start;
+	uint32_t elapsed;
+
+	msgqueue_register_handler(CONTENTION_MSG_CODE, msgqueue_handler_contention);
+	contention_count = 0;
+
+	/* Fill every queue to its full depth so that all clients contend at once. */
+	for (uint32_t q = 0; q < NUM_MSG_QUEUES; q++) {
+		for (uint32_t i = 0; i < MSG_QUEUE_SIZE; i++) {
+			req.data[0] = CONTENTION_MSG_CODE;
+			req.data[1] = q;
+			msgqueue_request_push(q, &req);
+		}
+	}
+
+	start = k_cycle_get_32();
+	process_message_queues();
+	elapsed = k_cycle_get_32() - start;
+
+	zassert_equal(contention_count, CONTENTION_MSGS);
+
+	for (uint32_t q = 0; q < NUM_MSG_QUEUES; q++) {
+		first_service[q] = UINT32_MAX;
+	}
+	for (uint32_t i = 0; i < contention_count; i++) {
+		uint32_t q = contention_log[i];
+
+		zassert_true(q < NUM_MSG_QUEUES);
+		if (first_service[q] == UINT32_MAX) {
+			first_service[q] = i;
+		}
+		total_wait[q] += contention_cycles[i] - start;
+		served[q]++;
+	}
+
+	/* No queue may wait for more than one full round-robin pass before being serviced. */
+	for (uint32_t q = 0; q < NUM_MSG_QUEUES; q++) {
+		zassert_equal(served[q], MSG_QUEUE_SIZE);
+		zassert_true(first_service[q] < NUM_MSG_QUEUES * CONFIG_TT_BH_ARC_MSG_QUEUE_WEIGHT,
+			     "queue %u starved until message %u", q, first_service[q]);
+		TC_PRINT("queue %u: first serviced at slot %u, mean latency %u cycles\n", q,
+			 first_service[q], (uint32_t)(total_wait[q] / served[q]));
+	}
+
+	if (elapsed > 0) {
+		TC_PRINT("%u requests in %u cycles (%u requests/s)\n", contention_count, elapsed,
+			 (uint32_t)((uint64_t)contention_count * sys_clock_hw_cycles_per_sec() /
+				    elapsed));
+	}
+
+	for (uint32_t q = 0; q < NUM_MSG_QUEUES; q++) {
+		for (uint32_t i = 0; i < MSG_QUEUE_SIZE; i++) {
+			msgqueue_response_pop(q, &rsp);
+			zexpect_equal(rsp.data[0], 0);
+			zexpect_equal(rsp.data[1], q);
+		}
+	}
+}
+
 static void test_setup(void *ctx)
 {
 	(void)ctx;
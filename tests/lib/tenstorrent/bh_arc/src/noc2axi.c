@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Exercises the NOC2AXI TLB allocator. Programming an entry is four register writes, which the
+ * WriteReg fake counts, so a hit shows up as an acquire that writes nothing.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#include "noc2axi.h"
+#include "reg_mock.h"
+
+/* Entries of each ring that the allocator hands out */
+#define RING0_POOL_SIZE 9
+#define RING1_POOL_SIZE 15
+
+#define TLB_WRITES_PER_MISS 4
+
+#define WINDOW(n) ((uint64_t)(n) << NOC_TLB_LOG_SIZE)
+
+void NOC2AXITlbReset(void);
+
+/* Map a window and let it go again, leaving it cached */
+static uint8_t touch(uint8_t ring, uint8_t x, uint8_t y, uint64_t addr)
+{
+	uint8_t tlb = NOC2AXITlbAcquire(ring, x, y, addr);
+
+	NOC2AXITlbRelease(ring, tlb);
+	return tlb;
+}
+
+ZTEST(noc2axi, test_miss_then_hit)
+{
+	NOC2AXITlbStats stats;
+	uint8_t tlb = touch(0, 2, 3, WINDOW(1));
+
+	zassert_equal(WriteReg_fake.call_count, TLB_WRITES_PER_MISS);
+	/* TLB2 holds the unicast destination with strict ordering */
+	zassert_equal(WriteReg_fake.arg1_history[2], 2 | (3 << 6) | (kNoc2AxiOrderingStrict << 25));
+
+	/* Any address in the same 16 MiB window of the same tile reuses the entry */
+	zassert_equal(touch(0, 2, 3, WINDOW(1) + 0x1234), tlb);
+	zassert_equal(WriteReg_fake.call_count, TLB_WRITES_PER_MISS, "hit reprogrammed the TLB");
+
+	/* Another tile or window is a different mapping */
+	zassert_not_equal(touch(0, 3, 3, WINDOW(1)), tlb);
+	zassert_not_equal(touch(0, 2, 3, WINDOW(2)), tlb);
+	zassert_equal(WriteReg_fake.call_count, 3 * TLB_WRITES_PER_MISS);
+
+	NOC2AXITlbGetStats(0, &stats);
+	zassert_equal(stats.hits, 1);
+	zassert_equal(stats.misses, 3);
+	zassert_equal(stats.evictions, 0);
+
+	NOC2AXITlbGetStats(1, &stats);
+	zassert_equal(stats.hits + stats.misses, 0, "ring 1 was not used");
+}
+
+ZTEST(noc2axi, test_shared_entry)
+{
+	uint8_t a = NOC2AXITlbAcquire(0, 1, 1, WINDOW(4));
+	uint8_t b = NOC2AXITlbAcquire(0, 1, 1, WINDOW(4));
+
+	zassert_equal(a, b);
+	zassert_equal(NOC2AXITlbLookup(0, 1, 1, WINDOW(4)), a);
+
+	/* The mapping stays after the last user lets go, until it is evicted */
+	NOC2AXITlbRelease(0, a);
+	NOC2AXITlbRelease(0, b);
+	zassert_equal(NOC2AXITlbLookup(0, 1, 1, WINDOW(4)), a);
+	zassert_equal(NOC2AXITlbLookup(0, 1, 1, WINDOW(5)), -ENOENT);
+	zassert_equal(NOC2AXITlbLookup(1, 1, 1, WINDOW(4)), -ENOENT);
+}
+
+ZTEST(noc2axi, test_lru_eviction)
+{
+	NOC2AXITlbStats stats;
+	uint8_t tlb[RING0_POOL_SIZE];
+
+	for (uint8_t i = 0; i < RING0_POOL_SIZE; i++) {
+		tlb[i] = touch(0, 1, i, WINDOW(1));
+	}
+
+	/* Every entry is in use, and none of them is a fixed one */
+	for (uint8_t i = 0; i < RING0_POOL_SIZE; i++) {
+		zassert_true(tlb[i] >= 6 && tlb[i] != 14, "handed out fixed TLB %u", tlb[i]);
+		for (uint8_t j = 0; j < i; j++) {
+			zassert_not_equal(tlb[i], tlb[j]);
+		}
+	}
+
+	/* Make tile 0 the most recently used, so tile 1 is the oldest */
+	touch(0, 1, 0, WINDOW(1));
+	zassert_equal(touch(0, 2, 0, WINDOW(1)), tlb[1]);
+	zassert_equal(NOC2AXITlbLookup(0, 1, 1, WINDOW(1)), -ENOENT);
+	zassert_equal(NOC2AXITlbLookup(0, 1, 0, WINDOW(1)), tlb[0]);
+
+	/* Next in line is tile 2 */
+	zassert_equal(touch(0, 2, 1, WINDOW(1)), tlb[2]);
+
+	NOC2AXITlbGetStats(0, &stats);
+	zassert_equal(stats.misses, RING0_POOL_SIZE + 2);
+	zassert_equal(stats.evictions, 2);
+	zassert_equal(stats.hits, 1);
+}
+
+ZTEST(noc2axi, test_held_entry_not_evicted)
+{
+	uint8_t held = NOC2AXITlbAcquire(0, 1, 0, WINDOW(1));
+
+	/* The held entry is the oldest, but the others are evicted around it */
+	for (uint8_t i = 1; i < 2 * RING0_POOL_SIZE; i++) {
+		zassert_not_equal(touch(0, 1, i, WINDOW(1)), held);
+	}
+	zassert_equal(NOC2AXITlbLookup(0, 1, 0, WINDOW(1)), held);
+
+	NOC2AXITlbRelease(0, held);
+	zassert_equal(touch(0, 2, 0, WINDOW(1)), held, "released entry was not the oldest");
+}
+
+static K_THREAD_STACK_DEFINE(waiter_stack, 1024);
+static struct k_thread waiter_thread;
+static volatile int waiter_tlb;
+
+static void waiter(void *p1, void *p2, void *p3)
+{
+	waiter_tlb = NOC2AXITlbAcquire(1, 5, 5, WINDOW(1));
+}
+
+ZTEST(noc2axi, test_wait_for_release)
+{
+	uint8_t tlb[RING1_POOL_SIZE];
+
+	for (uint8_t i = 0; i < RING1_POOL_SIZE; i++) {
+		tlb[i] = NOC2AXITlbAcquire(1, 1, i, WINDOW(1));
+	}
+
+	waiter_tlb = -1;
+	k_thread_create(&waiter_thread, waiter_stack, K_THREAD_STACK_SIZEOF(waiter_stack), waiter,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Every entry is held, so the acquire has to wait */
+	k_sleep(K_MSEC(10));
+	zassert_equal(waiter_tlb, -1);
+
+	NOC2AXITlbRelease(1, tlb[3]);
+	zassert_ok(k_thread_join(&waiter_thread, K_SECONDS(1)));
+	zassert_equal(waiter_tlb, tlb[3]);
+
+	NOC2AXITlbRelease(1, waiter_tlb);
+	for (uint8_t i = 0; i < RING1_POOL_SIZE; i++) {
+		if (i != 3) {
+			NOC2AXITlbRelease(1, tlb[i]);
+		}
+	}
+}
+
+static uint8_t set_tlb[3];
+static volatile bool set_acquired;
+
+static void set_waiter(void *p1, void *p2, void *p3)
+{
+	static const uint8_t x[] = {6, 6, 6};
+	static const uint8_t y[] = {0, 1, 2};
+
+	NOC2AXITlbAcquireSet(1, ARRAY_SIZE(set_tlb), x, y, WINDOW(1), set_tlb);
+	set_acquired = true;
+}
+
+ZTEST(noc2axi, test_set_taken_at_once)
+{
+	uint8_t tlb[RING1_POOL_SIZE];
+	uint8_t held = RING1_POOL_SIZE - 2;
+
+	/* Released entries with nobody waiting must not let a later wait return early */
+	for (uint8_t i = 0; i < RING1_POOL_SIZE; i++) {
+		touch(1, 2, i, WINDOW(1));
+	}
+
+	for (uint8_t i = 0; i < held; i++) {
+		tlb[i] = NOC2AXITlbAcquire(1, 1, i, WINDOW(1));
+	}
+
+	set_acquired = false;
+	k_thread_create(&waiter_thread, waiter_stack, K_THREAD_STACK_SIZEOF(waiter_stack),
+			set_waiter, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Only two entries are free, so the set of three waits without taking any of them */
+	k_sleep(K_MSEC(10));
+	zassert_false(set_acquired);
+	tlb[held] = NOC2AXITlbAcquire(1, 3, 0, WINDOW(1));
+	tlb[held + 1] = NOC2AXITlbAcquire(1, 3, 1, WINDOW(1));
+
+	NOC2AXITlbRelease(1, tlb[0]);
+	NOC2AXITlbRelease(1, tlb[held]);
+	k_sleep(K_MSEC(10));
+	zassert_false(set_acquired);
+
+	NOC2AXITlbRelease(1, tlb[held + 1]);
+	zassert_ok(k_thread_join(&waiter_thread, K_SECONDS(1)));
+	zassert_true(set_acquired);
+	zassert_true(set_tlb[0] != set_tlb[1] && set_tlb[1] != set_tlb[2] &&
+		     set_tlb[0] != set_tlb[2]);
+
+	for (uint8_t i = 0; i < ARRAY_SIZE(set_tlb); i++) {
+		NOC2AXITlbRelease(1, set_tlb[i]);
+	}
+	for (uint8_t i = 1; i < held; i++) {
+		NOC2AXITlbRelease(1, tlb[i]);
+	}
+}
+
+static void noc2axi_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	NOC2AXITlbReset();
+}
+
+ZTEST_SUITE(noc2axi, NULL, NULL, noc2axi_before, NULL, NULL);
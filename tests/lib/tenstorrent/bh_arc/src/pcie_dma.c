@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Exercises the PCIe DMA request queues. The register fakes emulate the HDMA channel status: a
+ * doorbell makes the channel run until the test finishes it.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <tenstorrent/smc_msg.h>
+#include <tenstorrent/msgqueue.h>
+
+#include "noc2axi.h"
+#include "pcie.h"
+#include "pcie_dma.h"
+#include "reg_mock.h"
+
+#define NUM_CHANNELS CONFIG_TT_BH_ARC_PCIE_DMA_CHANNELS
+#define QUEUE_DEPTH  CONFIG_TT_BH_ARC_PCIE_DMA_QUEUE_DEPTH
+
+/* Write channel 0 registers, the others are laid out the same further up */
+#define HDMA_DOORBELL 0x00380004
+#define HDMA_LLP_LOW  0x00380010
+#define HDMA_XFERSIZE 0x0038001C
+#define HDMA_SAR_LOW  0x00380020
+#define HDMA_CONTROL1 0x00380034
+#define HDMA_STATUS   0x00380080
+
+#define HDMA_WRITE  0
+#define HDMA_READ   1
+#define DMA_RUNNING 1
+#define DMA_STOPPED 3
+
+static bool running[2][NUM_CHANNELS];
+static uint32_t starts[2][NUM_CHANNELS];
+static uint32_t sar_low[2][NUM_CHANNELS];
+static uint32_t control1[2][NUM_CHANNELS];
+static uint32_t llp_low[2][NUM_CHANNELS];
+static uint32_t xfersize_writes;
+
+static uint32_t dbi_addr(uint32_t reg, int dir, int ch)
+{
+	return (uint32_t)GetTlbWindowAddr(0, PCIE_DBI_REG_TLB, reg + dir * 0x100 + ch * 0x200);
+}
+
+static uint32_t read_reg_hdma(uint32_t addr)
+{
+	for (int dir = 0; dir < 2; dir++) {
+		for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+			if (addr == dbi_addr(HDMA_STATUS, dir, ch)) {
+				return running[dir][ch] ? DMA_RUNNING : DMA_STOPPED;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void write_reg_hdma(uint32_t addr, uint32_t value)
+{
+	for (int dir = 0; dir < 2; dir++) {
+		for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+			if (addr == dbi_addr(HDMA_DOORBELL, dir, ch)) {
+				running[dir][ch] = true;
+				starts[dir][ch]++;
+			} else if (addr == dbi_addr(HDMA_SAR_LOW, dir, ch)) {
+				sar_low[dir][ch] = value;
+			} else if (addr == dbi_addr(HDMA_CONTROL1, dir, ch)) {
+				control1[dir][ch] = value;
+			} else if (addr == dbi_addr(HDMA_LLP_LOW, dir, ch)) {
+				llp_low[dir][ch] = value;
+			} else if (addr == dbi_addr(HDMA_XFERSIZE, dir, ch)) {
+				xfersize_writes++;
+			}
+		}
+	}
+}
+
+/* Returns the status byte of the response */
+static uint32_t send_transfer(uint8_t command_code, uint32_t chip_addr, uint32_t host_addr,
+			      bool linked_list)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	req.pcie_dma_transfer.command_code = command_code;
+	req.pcie_dma_transfer.completion_data = 0x5a;
+	req.pcie_dma_transfer.linked_list = linked_list;
+	req.pcie_dma_transfer.transfer_size_bytes = 4096;
+	req.pcie_dma_transfer.chip_addr_lo = chip_addr;
+	req.pcie_dma_transfer.host_addr_lo = host_addr;
+	req.pcie_dma_transfer.msi_completion_addr_lo = 0xfee00000;
+
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	return rsp.data[0] & 0xff;
+}
+
+/* Finish the transfer on a channel and give the poll timer time to notice */
+static void finish(int dir, int ch)
+{
+	running[dir][ch] = false;
+	k_sleep(K_MSEC(1));
+}
+
+ZTEST(pcie_dma, test_full_duplex)
+{
+	zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER, 0x1000, 0x2000,
+				    false),
+		      0);
+	zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_CHIP_TO_HOST_TRANSFER, 0x3000, 0x4000,
+				    false),
+		      0);
+
+	/* A host to chip transfer reads from the host, a chip to host one from the chip */
+	zassert_equal(starts[HDMA_READ][0], 1);
+	zassert_equal(sar_low[HDMA_READ][0], 0x2000);
+	zassert_equal(starts[HDMA_WRITE][0], 1);
+	zassert_equal(sar_low[HDMA_WRITE][0], 0x3000);
+	zassert_equal(control1[HDMA_WRITE][0], 0, "single segment ran in linked-list mode");
+}
+
+ZTEST(pcie_dma, test_channels_then_queue)
+{
+	for (int i = 0; i < NUM_CHANNELS; i++) {
+		zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_CHIP_TO_HOST_TRANSFER, 0x1000 * i,
+					    0, false),
+			      0);
+		zassert_equal(starts[HDMA_WRITE][i], 1, "transfer %d did not get channel %d", i,
+			      i);
+	}
+
+	/* Every channel is busy, so the next transfer waits for one of them to finish */
+	zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_CHIP_TO_HOST_TRANSFER, 0xa000, 0, false),
+		      0);
+	k_sleep(K_MSEC(1));
+	for (int i = 0; i < NUM_CHANNELS; i++) {
+		zassert_equal(starts[HDMA_WRITE][i], 1);
+	}
+
+	finish(HDMA_WRITE, NUM_CHANNELS - 1);
+	zassert_equal(starts[HDMA_WRITE][NUM_CHANNELS - 1], 2);
+	zassert_equal(sar_low[HDMA_WRITE][NUM_CHANNELS - 1], 0xa000);
+
+	/* The other direction has channels of its own */
+	zassert_equal(starts[HDMA_READ][0], 0);
+}
+
+ZTEST(pcie_dma, test_queue_full)
+{
+	for (int i = 0; i < NUM_CHANNELS + QUEUE_DEPTH; i++) {
+		zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER, 0, i, false),
+			      0);
+	}
+
+	zassert_not_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER, 0, 0, false), 0);
+
+	/* Queued transfers start in order as channel 0 keeps finishing */
+	for (int i = 0; i < QUEUE_DEPTH; i++) {
+		finish(HDMA_READ, 0);
+		zassert_equal(sar_low[HDMA_READ][0], NUM_CHANNELS + i);
+	}
+
+	zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER, 0, 0, false), 0);
+}
+
+ZTEST(pcie_dma, test_linked_list)
+{
+	zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_HOST_TO_CHIP_TRANSFER, 0x8000, 0, true), 0);
+
+	zassert_equal(starts[HDMA_READ][0], 1);
+	zassert_equal(control1[HDMA_READ][0], BIT(0), "linked-list mode not enabled");
+	zassert_equal(llp_low[HDMA_READ][0], 0x8000);
+	zassert_equal(xfersize_writes, 0, "linked-list transfer programmed a single segment");
+}
+
+ZTEST(pcie_dma, test_busy_channel_not_taken)
+{
+	/* Channel 0 was started by something other than the queue */
+	running[HDMA_WRITE][0] = true;
+
+	zassert_equal(send_transfer(TT_SMC_MSG_PCIE_DMA_CHIP_TO_HOST_TRANSFER, 0, 0, false), 0);
+	zassert_equal(starts[HDMA_WRITE][0], 0);
+	zassert_equal(starts[HDMA_WRITE][1], 1);
+}
+
+static void finish_write_ch0(struct k_timer *timer)
+{
+	running[HDMA_WRITE][0] = false;
+}
+
+static K_TIMER_DEFINE(finish_timer, finish_write_ch0, NULL);
+
+ZTEST(pcie_dma, test_wait_timeout_forgotten)
+{
+	zassert_equal(PcieDmaTransferWait(true, 0x1000, 0x2000, 4096, K_MSEC(2)), -ETIMEDOUT);
+	zassert_equal(starts[HDMA_WRITE][0], 1);
+
+	/* The abandoned transfer finishes while the next waiter's transfer is still running */
+	k_timer_start(&finish_timer, K_MSEC(1), K_NO_WAIT);
+	zassert_equal(PcieDmaTransferWait(true, 0x3000, 0x4000, 4096, K_MSEC(5)), -ETIMEDOUT,
+		      "woken by the completion of an earlier transfer");
+	zassert_equal(starts[HDMA_WRITE][1], 1);
+}
+
+static void pcie_dma_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	ReadReg_fake.custom_fake = read_reg_hdma;
+	WriteReg_fake.custom_fake = write_reg_hdma;
+	memset(running, 0, sizeof(running));
+	memset(starts, 0, sizeof(starts));
+	memset(sar_low, 0, sizeof(sar_low));
+	memset(control1, 0, sizeof(control1));
+	memset(llp_low, 0, sizeof(llp_low));
+	xfersize_writes = 0;
+}
+
+/* Finish everything, including whatever the queues start meanwhile */
+static void pcie_dma_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (int i = 0; i <= QUEUE_DEPTH; i++) {
+		memset(running, 0, sizeof(running));
+		k_sleep(K_MSEC(1));
+	}
+}
+
+ZTEST_SUITE(pcie_dma, NULL, NULL, pcie_dma_before, pcie_dma_after, NULL);
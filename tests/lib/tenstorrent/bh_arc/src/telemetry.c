@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+#include <zephyr/ztest.h>
+
+#define TELEM_TICKS      (CONFIG_TT_BH_ARC_TELEM_UPDATE_MS / CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS)
+#define TELEM_SLOW_TICKS                                                                           \
+	(CONFIG_TT_BH_ARC_TELEM_SLOW_UPDATE_MS / CONFIG_TT_BH_ARC_TELEM_FAST_UPDATE_MS)
+
+extern uint32_t telemetry_refresh_due(uint32_t tick);
+
+ZTEST(telemetry, test_telemetry_refresh_due)
+{
+	/* Everything is refreshed on the first tick */
+	zassert_equal(telemetry_refresh_due(0), BIT(0) | BIT(1) | BIT(2));
+
+	/* Fast tags every tick, the rest on multiples of their period */
+	if (TELEM_TICKS > 1) {
+		zassert_equal(telemetry_refresh_due(1), BIT(0));
+		zassert_equal(telemetry_refresh_due(TELEM_TICKS - 1), BIT(0));
+	}
+	if (TELEM_SLOW_TICKS > TELEM_TICKS) {
+		zassert_equal(telemetry_refresh_due(TELEM_TICKS), BIT(0) | BIT(1));
+	}
+	zassert_equal(telemetry_refresh_due(TELEM_SLOW_TICKS), BIT(0) | BIT(1) | BIT(2));
+}
+
+ZTEST(telemetry, test_telemetry_refresh_rates)
+{
+	uint32_t count[3] = {0};
+
+	/* Over one slow period each group is refreshed once per its own period */
+	for (uint32_t tick = 0; tick < TELEM_SLOW_TICKS; tick++) {
+		uint32_t due = telemetry_refresh_due(tick);
+
+		for (int i = 0; i < ARRAY_SIZE(count); i++) {
+			count[i] += (due & BIT(i)) ? 1 : 0;
+		}
+	}
+
+	zassert_equal(count[0], TELEM_SLOW_TICKS);
+	zassert_equal(count[1], TELEM_SLOW_TICKS / TELEM_TICKS);
+	zassert_equal(count[2], 1);
+}
+
+ZTEST_SUITE(telemetry, NULL, NULL, NULL, NULL, NULL);
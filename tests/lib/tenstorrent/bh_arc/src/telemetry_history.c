@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <zephyr/ztest.h>
+
+#include "telemetry_history.h"
+
+#define DEPTH CONFIG_TT_BH_ARC_TELEM_HISTORY_DEPTH
+
+static void add_tdp(int32_t tdp)
+{
+	int32_t sample[TELEM_HISTORY_CHANNEL_COUNT] = {0};
+
+	sample[TELEM_HISTORY_TDP] = tdp;
+	telemetry_history_add(sample);
+}
+
+ZTEST(telemetry_history, test_telemetry_history_empty)
+{
+	struct telemetry_history_summary summary;
+
+	zassert_equal(telemetry_history_summarize(TELEM_HISTORY_TDP, 0, &summary), -ENODATA);
+	zassert_equal(
+		telemetry_history_summarize(TELEM_HISTORY_CHANNEL_COUNT, 0, &summary), -EINVAL);
+}
+
+ZTEST(telemetry_history, test_telemetry_history_window)
+{
+	struct telemetry_history_summary summary;
+
+	add_tdp(10);
+	add_tdp(-4);
+	add_tdp(30);
+	add_tdp(20);
+
+	/* Whole history */
+	zassert_ok(telemetry_history_summarize(TELEM_HISTORY_TDP, 0, &summary));
+	zassert_equal(summary.count, 4);
+	zassert_equal(summary.min, -4);
+	zassert_equal(summary.max, 30);
+	zassert_equal(summary.avg, 14);
+
+	/* Only the most recent samples */
+	zassert_ok(telemetry_history_summarize(TELEM_HISTORY_TDP, 2, &summary));
+	zassert_equal(summary.count, 2);
+	zassert_equal(summary.min, 20);
+	zassert_equal(summary.max, 30);
+	zassert_equal(summary.avg, 25);
+
+	/* Windows longer than the history are clamped */
+	zassert_ok(telemetry_history_summarize(TELEM_HISTORY_TDP, 1000, &summary));
+	zassert_equal(summary.count, 4);
+
+	/* Other channels are recorded independently */
+	zassert_ok(telemetry_history_summarize(TELEM_HISTORY_TDC, 0, &summary));
+	zassert_equal(summary.max, 0);
+}
+
+ZTEST(telemetry_history, test_telemetry_history_wrap)
+{
+	struct telemetry_history_summary summary;
+
+	/* Fill the ring twice over, only the last DEPTH samples remain */
+	for (int32_t i = 0; i < 2 * DEPTH; i++) {
+		add_tdp(i);
+	}
+
+	zassert_ok(telemetry_history_summarize(TELEM_HISTORY_TDP, 0, &summary));
+	zassert_equal(summary.count, DEPTH);
+	zassert_equal(summary.min, DEPTH);
+	zassert_equal(summary.max, 2 * DEPTH - 1);
+
+	zassert_ok(telemetry_history_summarize(TELEM_HISTORY_TDP, 1, &summary));
+	zassert_equal(summary.min, 2 * DEPTH - 1);
+}
+
+static void telemetry_history_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	telemetry_history_reset();
+}
+
+ZTEST_SUITE(telemetry_history, NULL, NULL, telemetry_history_before, NULL, NULL);
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/util.h>
+
+#include "fixed_point.h"
+#include "throttler.h"
+
+#define TRACE_LENGTH 2000
+#define ARB_FMIN     200
+#define ARB_FMAX     1400
+#define SCALE_FACTOR 500
+
+/* Board power style trace: idle, a heavy workload well above the limit, a drop below it and a
+ * moderate workload, with +/-10 W of deterministic noise on every sample.
+ */
+static float trace_sample(uint32_t i, uint32_t *seed)
+{
+	*seed = *seed * 1103515245U + 12345U;
+
+	int32_t noise = (int32_t)((*seed >> 16) % 21) - 10;
+	int32_t base = i < 500 ? 100 : i < 1200 ? 250 : i < 1600 ? 80 : 170;
+
+	return base + noise;
+}
+
+/* Run the float and fixed-point controllers side by side over the trace, each feeding an AICLK
+ * arbiter the way UpdateThrottlerArb does, and check that neither the controller output nor the
+ * arbiter frequency drift apart.
+ */
+static void compare_throttler(const ThrottlerParams *params, float limit)
+{
+	ThrottlerParamsFixed params_fixed;
+	ThrottlerState state = {.limit = limit};
+	ThrottlerStateFixed state_fixed = {.limit = q16_from_float(limit)};
+	float arb = ARB_FMAX;
+	q16_t arb_fixed = q16_from_int(ARB_FMAX);
+	uint32_t seed = 1;
+
+	ThrottlerParamsToFixed(params, &params_fixed);
+
+	for (uint32_t i = 0; i < TRACE_LENGTH; i++) {
+		float value = trace_sample(i, &seed);
+
+		ThrottlerStep(params, &state, value, 1.0F);
+		ThrottlerStepFixed(&params_fixed, &state_fixed, q16_from_float(value), Q16_ONE);
+
+		arb = CLAMP(arb + state.output * SCALE_FACTOR, ARB_FMIN, ARB_FMAX);
+		arb_fixed = CLAMP(arb_fixed + (int64_t)state_fixed.output * SCALE_FACTOR,
+				  q16_from_int(ARB_FMIN), q16_from_int(ARB_FMAX));
+
+		zassert_within(q16_to_float(state_fixed.output), state.output, 1e-4F,
+			       "sample %u: output %f vs %f", i,
+			       (double)q16_to_float(state_fixed.output), (double)state.output);
+		zassert_within(q16_to_float(arb_fixed), arb, 1.0F, "sample %u: arbiter %f vs %f",
+			       i, (double)q16_to_float(arb_fixed), (double)arb);
+	}
+}
+
+ZTEST(throttler, test_fixed_point_p_controller)
+{
+	const ThrottlerParams params = {.alpha_filter = 1.0F, .p_gain = 0.2F, .d_gain = 0.0F};
+
+	compare_throttler(&params, 150.0F);
+}
+
+ZTEST(throttler, test_fixed_point_filtered_p_controller)
+{
+	const ThrottlerParams params = {.alpha_filter = 0.1F, .p_gain = 0.2F, .d_gain = 0.0F};
+
+	compare_throttler(&params, 150.0F);
+}
+
+ZTEST(throttler, test_fixed_point_pd_controller)
+{
+	const ThrottlerParams board_power = {.alpha_filter = 1.0F, .p_gain = 0.1F, .d_gain = 0.1F};
+	const ThrottlerParams doppler_slow = {
+		.alpha_filter = 1.0F, .p_gain = 0.0025F, .d_gain = 0.3F};
+
+	compare_throttler(&board_power, 150.0F);
+	compare_throttler(&doppler_slow, 150.0F);
+}
+
+ZTEST(throttler, test_fixed_point_saturated_input)
+{
+	const ThrottlerParams params = {.alpha_filter = 1.0F, .p_gain = 0.2F, .d_gain = 0.0F};
+	ThrottlerParamsFixed params_fixed;
+	ThrottlerStateFixed state_fixed = {.limit = q16_from_int(50)};
+
+	ThrottlerParamsToFixed(&params, &params_fixed);
+
+	/* A failed sensor read must push the throttler hard down, not wrap around */
+	ThrottlerStepFixed(&params_fixed, &state_fixed, q16_from_float(1e30F), Q16_ONE);
+	zassert_true(state_fixed.output < 0);
+
+	ThrottlerStepFixed(&params_fixed, &state_fixed, q16_from_float(-1e30F), Q16_ONE);
+	zassert_true(state_fixed.output > 0);
+
+	/* Nor at a long period */
+	ThrottlerStepFixed(&params_fixed, &state_fixed, q16_from_float(1e30F), q16_from_int(100));
+	zassert_true(state_fixed.output < 0);
+}
+
+ZTEST(throttler, test_period_scaling)
+{
+	const ThrottlerParams params = {.alpha_filter = 1.0F, .p_gain = 0.2F, .d_gain = 0.0F};
+	ThrottlerParamsFixed params_fixed;
+	ThrottlerStateFixed fast = {.limit = q16_from_int(150)};
+	ThrottlerStateFixed slow = {.limit = q16_from_int(150)};
+	q16_t arb_fast = q16_from_int(ARB_FMAX);
+	q16_t arb_slow = q16_from_int(ARB_FMAX);
+
+	ThrottlerParamsToFixed(&params, &params_fixed);
+
+	/* 20 ms at 200 W against a 150 W limit throttles as far whether the throttler is stepped
+	 * every 1 ms or every 4 ms
+	 */
+	for (uint32_t ms = 0; ms < 20; ms++) {
+		ThrottlerStepFixed(&params_fixed, &fast, q16_from_int(200), Q16_ONE);
+		arb_fast += (int64_t)fast.output * SCALE_FACTOR;
+
+		if (ms % 4 == 3) {
+			ThrottlerStepFixed(&params_fixed, &slow, q16_from_int(200),
+					   q16_from_int(4));
+			arb_slow += (int64_t)slow.output * SCALE_FACTOR;
+		}
+	}
+
+	zassert_within(q16_to_int(arb_fast), 733, 2);
+	zassert_within(q16_to_int(arb_slow), q16_to_int(arb_fast), 2, "%d MHz at 4 ms vs %d MHz",
+		       q16_to_int(arb_slow), q16_to_int(arb_fast));
+}
+
+ZTEST_SUITE(throttler, NULL, NULL, NULL, NULL, NULL);
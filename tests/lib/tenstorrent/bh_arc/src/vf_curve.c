@@ -9,6 +9,24 @@
 #include <tenstorrent/msgqueue.h>
 #include <stdlib.h>
 
+#include "aiclk_ppm.h"
+#include "fixed_point.h"
+#include "vf_curve.h"
+
+/* Highest frequency in [low, high] whose analytic voltage is at most voltage_mv, or -1 */
+static int32_t max_freq_for_voltage(uint32_t voltage_mv, uint32_t low, uint32_t high)
+{
+	int32_t max_freq = -1;
+
+	for (uint32_t freq_mhz = low; freq_mhz <= high; freq_mhz++) {
+		if (VFCurveFixed(freq_mhz) <= q16_from_int(voltage_mv)) {
+			max_freq = freq_mhz;
+		}
+	}
+
+	return max_freq;
+}
+
 ZTEST(vf_curve, test_get_freq_curve_from_voltage_handler)
 {
 	union request req = {0};
@@ -79,4 +97,71 @@ ZTEST(vf_curve, test_voltage_frequency_roundtrip)
 	zassert_true(abs(freq_diff) < 50, "Roundtrip frequency error too large: %d", freq_diff);
 }
 
-ZTEST_SUITE(vf_curve, NULL, NULL, NULL, NULL, NULL);
+ZTEST(vf_curve, test_fixed_point_curve_matches_float)
+{
+	/* Sweep well past both ends of the AICLK range */
+	for (uint32_t freq_mhz = 0; freq_mhz <= 2000; freq_mhz++) {
+		float expected_mv = VFCurve(freq_mhz);
+		q16_t voltage_mv = VFCurveFixed(freq_mhz);
+
+		zassert_within(q16_to_float(voltage_mv), expected_mv, 0.01F, "%u MHz: %f vs %f mV",
+			       freq_mhz, (double)q16_to_float(voltage_mv), (double)expected_mv);
+	}
+}
+
+ZTEST(vf_curve, test_freq_lookup_table)
+{
+	for (uint32_t freq_mhz = 0; freq_mhz <= 1400; freq_mhz++) {
+		q16_t expected_mv = VFCurveFixed(freq_mhz);
+		q16_t voltage_mv = VFCurveLookup(freq_mhz);
+
+		/* Interpolation may only add margin, and only a little */
+		zassert_true(voltage_mv >= expected_mv, "%u MHz: %d below curve", freq_mhz,
+			     expected_mv - voltage_mv);
+		zassert_true(voltage_mv - expected_mv <= Q16_CONST(0.05), "%u MHz: %d above curve",
+			     freq_mhz, voltage_mv - expected_mv);
+	}
+}
+
+ZTEST(vf_curve, test_voltage_lookup_table)
+{
+	for (uint32_t voltage_mv = 400; voltage_mv <= 1300; voltage_mv++) {
+		int32_t expected_mhz = max_freq_for_voltage(voltage_mv, 0, 1400);
+		int32_t freq_mhz = VFCurveMaxFreq(voltage_mv);
+
+		zassert_true(freq_mhz <= expected_mhz, "%u mV: %d MHz above %d MHz", voltage_mv,
+			     freq_mhz, expected_mhz);
+		zassert_true(expected_mhz - freq_mhz <= 8, "%u mV: %d MHz too far below %d MHz",
+			     voltage_mv, freq_mhz, expected_mhz);
+	}
+}
+
+ZTEST(vf_curve, test_get_max_aiclk_for_voltage)
+{
+	uint32_t fmin = GetAiclkFmin();
+	uint32_t fmax = GetAiclkFmax();
+
+	for (uint32_t voltage_mv = 600; voltage_mv <= 1200; voltage_mv++) {
+		int32_t expected_mhz = max_freq_for_voltage(voltage_mv, fmin, fmax);
+		uint32_t freq_mhz = GetMaxAiclkForVoltage(voltage_mv);
+
+		if (expected_mhz < 0) {
+			zassert_equal(freq_mhz, fmin - 1, "%u mV", voltage_mv);
+			continue;
+		}
+
+		zassert_true(freq_mhz <= expected_mhz, "%u mV: %u MHz above %d MHz", voltage_mv,
+			     freq_mhz, expected_mhz);
+		zassert_true(expected_mhz - (int32_t)freq_mhz <= 8, "%u mV: %u MHz vs %d MHz",
+			     voltage_mv, freq_mhz, expected_mhz);
+	}
+}
+
+static void *vf_curve_setup(void)
+{
+	InitVFCurve();
+
+	return NULL;
+}
+
+ZTEST_SUITE(vf_curve, NULL, vf_curve_setup, NULL, NULL, NULL);